@@ -26,6 +26,8 @@
 
 #include <TelepathyQt/Account>
 
+#include <QHash>
+
 namespace Tp
 {
 
@@ -118,6 +120,47 @@ PendingReady *AccountFactory::proxy(const QString &busName, const QString &objec
     return nowHaveProxy(proxy);
 }
 
+/**
+ * Constructs Account proxies for each of \a objectPaths and begins making them ready.
+ *
+ * This is equivalent to calling proxy() for each of \a objectPaths, but all of the proxies are
+ * looked up from the factory cache in one pass and tracked by a single operation. This can be used
+ * to warm up the factory cache with a known set of accounts, preparing them concurrently.
+ *
+ * The proxies can be accessed immediately after this function returns using
+ * PendingProxies::proxies().
+ *
+ * \param busName The bus/service name of the D-Bus account objects the proxies are constructed for.
+ * (Usually #TP_QT_ACCOUNT_MANAGER_BUS_NAME).
+ * \param objectPaths The object paths of the accounts.
+ * \param connFactory The connection factory to use for the Accounts.
+ * \param chanFactory The channel factory to use for the Accounts.
+ * \param contactFactory The channel factory to use for the Accounts.
+ * \return A PendingProxies operation with the proxies in PendingProxies::proxies(), in the same
+ *         order as \a objectPaths.
+ */
+PendingProxies *AccountFactory::proxies(const QString &busName, const QStringList &objectPaths,
+            const ConnectionFactoryConstPtr &connFactory,
+            const ChannelFactoryConstPtr &chanFactory,
+            const ContactFactoryConstPtr &contactFactory) const
+{
+    QList<DBusProxyPtr> proxies = cachedProxies(busName, objectPaths);
+    // A path listed more than once gets the proxy constructed for its first occurrence
+    QHash<QString, DBusProxyPtr> constructed;
+    for (int i = 0; i < proxies.size(); ++i) {
+        if (proxies[i].isNull()) {
+            DBusProxyPtr &proxy = constructed[objectPaths[i]];
+            if (proxy.isNull()) {
+                proxy = construct(busName, objectPaths[i], connFactory, chanFactory,
+                        contactFactory);
+            }
+            proxies[i] = proxy;
+        }
+    }
+
+    return nowHaveProxies(proxies);
+}
+
 /**
  * Can be used by subclasses to override the Account subclass constructed by the factory.
  *
@@ -40,6 +40,7 @@ class QDBusConnection;
 namespace Tp
 {
 
+class PendingProxies;
 class PendingReady;
 
 class TP_QT_EXPORT AccountFactory : public FixedFeatureFactory
@@ -57,6 +58,10 @@ public:
             const ConnectionFactoryConstPtr &connFactory,
             const ChannelFactoryConstPtr &chanFactory,
             const ContactFactoryConstPtr &contactFactory) const;
+    PendingProxies *proxies(const QString &busName, const QStringList &objectPaths,
+            const ConnectionFactoryConstPtr &connFactory,
+            const ChannelFactoryConstPtr &chanFactory,
+            const ContactFactoryConstPtr &contactFactory) const;
 
 protected:
     AccountFactory(const QDBusConnection &bus, const Features &features);
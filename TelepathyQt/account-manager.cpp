@@ -1075,6 +1075,12 @@ void AccountManager::gotMainProperties(QDBusPendingCallWatcher *watcher)
             mPriv->addAccountForPath(path);
         }
 
+        // Request the core properties of all the initial accounts in one pass, rather than having
+        // each of them wait for the channel dispatcher before asking
+        foreach (const AccountPtr &account, mPriv->incompleteAccounts) {
+            account->prefetchMainProperties();
+        }
+
         mPriv->checkIntrospectionCompleted();
     } else {
         if (mPriv->reintrospectionRetries++ < maxReintrospectionRetries) {
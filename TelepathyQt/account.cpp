@@ -529,9 +529,12 @@ struct TP_QT_NO_EXPORT Account::Private
     static void introspectProtocolInfo(Private *self);
     static void introspectCapabilities(Private *self);
 
+    struct PropertiesDelta;
     void updateProperties(const QVariantMap &props);
+    void notifyChanged(const char *propertyName, QStringList &changed);
     void retrieveAvatar();
     bool processConnQueue();
+    void finishCoreIntrospection();
 
     bool checkCapabilitiesChanged(bool profileChanged);
 
@@ -570,6 +573,12 @@ struct TP_QT_NO_EXPORT Account::Private
     QQueue<QString> connObjPathQueue;
     ConnectionPtr connection;
     bool mayFinishCore, coreFinished;
+    bool mainPropertiesRequested;
+    // The prefetched GetAll(Account) call while it is pending. Its reply is applied as soon as it
+    // arrives, as AccountPropertyChanged deltas received afterwards are newer.
+    QDBusPendingCallWatcher *prefetchedMainProperties;
+    // Whether the prefetched reply has been applied, or the dispatcher is waiting for it
+    bool mainPropertiesPrefetched, mainPropertiesWanted;
     QString normalizedName;
     Avatar avatar;
     ConnectionManagerPtr cm;
@@ -589,6 +598,66 @@ struct TP_QT_NO_EXPORT Account::Private
     QSharedPointer<DispatcherContext> dispatcherContext;
 };
 
+// An AccountPropertyChanged delta or GetAll reply, decoded in a single pass over the map
+struct Account::Private::PropertiesDelta
+{
+    enum Field {
+        None = 0,
+        Interfaces = 1 << 0,
+        Service = 1 << 1,
+        DisplayName = 1 << 2,
+        Icon = 1 << 3,
+        Nickname = 1 << 4,
+        NormalizedName = 1 << 5,
+        Valid = 1 << 6,
+        Enabled = 1 << 7,
+        ConnectAutomatically = 1 << 8,
+        HasBeenOnline = 1 << 9,
+        Parameters = 1 << 10,
+        AutomaticPresence = 1 << 11,
+        CurrentPresence = 1 << 12,
+        RequestedPresence = 1 << 13,
+        ChangingPresence = 1 << 14,
+        ConnectionPath = 1 << 15,
+        ConnectionStatusField = 1 << 16,
+        ConnectionStatusReasonField = 1 << 17,
+        ConnectionError = 1 << 18,
+        ConnectionErrorDetails = 1 << 19
+    };
+
+    PropertiesDelta(const QVariantMap &props);
+
+    bool has(Field field) const
+    {
+        return (fields & field) != 0;
+    }
+
+    uint fields;
+    QStringList interfaces;
+    QString serviceName;
+    QString displayName;
+    QString iconName;
+    QString nickname;
+    QString normalizedName;
+    bool valid;
+    bool enabled;
+    bool connectsAutomatically;
+    bool hasBeenOnline;
+    bool changingPresence;
+    QVariantMap parameters;
+    SimplePresence automaticPresence;
+    SimplePresence currentPresence;
+    SimplePresence requestedPresence;
+    QString connectionObjectPath;
+    ConnectionStatus connectionStatus;
+    ConnectionStatusReason connectionStatusReason;
+    QString connectionError;
+    QVariantMap connectionErrorDetails;
+
+private:
+    static QHash<QString, Field> fieldNames();
+};
+
 struct Account::Private::DispatcherContext
 {
     DispatcherContext(const QDBusConnection &bus)
@@ -628,6 +697,10 @@ Account::Private::Private(Account *parent, const ConnectionFactoryConstPtr &conn
       changingPresence(false),
       mayFinishCore(false),
       coreFinished(false),
+      mainPropertiesRequested(false),
+      prefetchedMainProperties(nullptr),
+      mainPropertiesPrefetched(false),
+      mainPropertiesWanted(false),
       connectionStatus(ConnectionStatusDisconnected),
       connectionStatusReason(ConnectionStatusReasonNoneSpecified),
       usingConnectionCaps(false),
@@ -4181,6 +4254,34 @@ Client::ChannelDispatcherInterface *Account::dispatcherInterface() const
     return mPriv->dispatcherContext->iface;
 }
 
+/**
+ * Start fetching the properties needed by FeatureCore right away.
+ *
+ * Normally the properties are only requested once the channel dispatcher has been introspected.
+ * AccountManager calls this for all the accounts it finds on startup, so that their replies are
+ * all in flight at once and FeatureCore only has to wait for them. The reply is applied as soon as
+ * it arrives, so that changes signalled after it are applied on top of it, but FeatureCore is only
+ * finished once the channel dispatcher has been introspected. If the prefetch fails, the
+ * properties are requested again as usual.
+ *
+ * This does nothing if the properties have already been requested.
+ */
+void Account::prefetchMainProperties()
+{
+    if (mPriv->mainPropertiesRequested || isReady(FeatureCore)) {
+        return;
+    }
+
+    debug() << "Prefetching Properties::GetAll(Account) on" << objectPath();
+    mPriv->mainPropertiesRequested = true;
+    mPriv->prefetchedMainProperties = new QDBusPendingCallWatcher(
+            mPriv->properties->GetAll(
+                TP_QT_IFACE_ACCOUNT), this);
+    connect(mPriv->prefetchedMainProperties,
+            SIGNAL(finished(QDBusPendingCallWatcher*)),
+            SLOT(gotMainProperties(QDBusPendingCallWatcher*)));
+}
+
 /**** Private ****/
 void Account::Private::init()
 {
@@ -4258,27 +4359,152 @@ void Account::Private::introspectCapabilities(Account::Private *self)
             SLOT(onConnectionReady(Tp::PendingOperation*)));
 }
 
+Account::Private::PropertiesDelta::PropertiesDelta(const QVariantMap &props)
+    : fields(0),
+      valid(false),
+      enabled(false),
+      connectsAutomatically(false),
+      hasBeenOnline(false),
+      changingPresence(false),
+      connectionStatus(ConnectionStatusDisconnected),
+      connectionStatusReason(ConnectionStatusReasonNoneSpecified)
+{
+    static const QHash<QString, Field> fieldsByName = fieldNames();
+
+    for (QVariantMap::const_iterator i = props.constBegin(); i != props.constEnd(); ++i) {
+        Field field = fieldsByName.value(i.key(), None);
+        fields |= field;
+
+        switch (field) {
+        case Interfaces:
+            interfaces = qdbus_cast<QStringList>(i.value());
+            break;
+        case Service:
+            serviceName = qdbus_cast<QString>(i.value());
+            break;
+        case DisplayName:
+            displayName = qdbus_cast<QString>(i.value());
+            break;
+        case Icon:
+            iconName = qdbus_cast<QString>(i.value());
+            break;
+        case Nickname:
+            nickname = qdbus_cast<QString>(i.value());
+            break;
+        case NormalizedName:
+            normalizedName = qdbus_cast<QString>(i.value());
+            break;
+        case Valid:
+            valid = qdbus_cast<bool>(i.value());
+            break;
+        case Enabled:
+            enabled = qdbus_cast<bool>(i.value());
+            break;
+        case ConnectAutomatically:
+            connectsAutomatically = qdbus_cast<bool>(i.value());
+            break;
+        case HasBeenOnline:
+            hasBeenOnline = qdbus_cast<bool>(i.value());
+            break;
+        case Parameters:
+            parameters = qdbus_cast<QVariantMap>(i.value());
+            break;
+        case AutomaticPresence:
+            automaticPresence = qdbus_cast<SimplePresence>(i.value());
+            break;
+        case CurrentPresence:
+            currentPresence = qdbus_cast<SimplePresence>(i.value());
+            break;
+        case RequestedPresence:
+            requestedPresence = qdbus_cast<SimplePresence>(i.value());
+            break;
+        case ChangingPresence:
+            changingPresence = qdbus_cast<bool>(i.value());
+            break;
+        case ConnectionPath:
+            connectionObjectPath = qdbus_cast<QDBusObjectPath>(i.value()).path();
+            if (connectionObjectPath.isEmpty()) {
+                debug() << " The map contains \"Connection\" but it's empty as a QDBusObjectPath!";
+                debug() << " Trying QString (known bug in some MC/dbus-glib versions)";
+                connectionObjectPath = qdbus_cast<QString>(i.value());
+            }
+            if (connectionObjectPath == QLatin1String("/")) {
+                connectionObjectPath = QString();
+            }
+            break;
+        case ConnectionStatusField:
+            connectionStatus = ConnectionStatus(qdbus_cast<uint>(i.value()));
+            break;
+        case ConnectionStatusReasonField:
+            connectionStatusReason = ConnectionStatusReason(qdbus_cast<uint>(i.value()));
+            break;
+        case ConnectionError:
+            connectionError = qdbus_cast<QString>(i.value());
+            break;
+        case ConnectionErrorDetails:
+            connectionErrorDetails = qdbus_cast<QVariantMap>(i.value());
+            break;
+        case None:
+            break;
+        }
+    }
+}
+
+QHash<QString, Account::Private::PropertiesDelta::Field> Account::Private::PropertiesDelta::fieldNames()
+{
+    QHash<QString, Field> names;
+    names.insert(QLatin1String("Interfaces"), Interfaces);
+    names.insert(QLatin1String("Service"), Service);
+    names.insert(QLatin1String("DisplayName"), DisplayName);
+    names.insert(QLatin1String("Icon"), Icon);
+    names.insert(QLatin1String("Nickname"), Nickname);
+    names.insert(QLatin1String("NormalizedName"), NormalizedName);
+    names.insert(QLatin1String("Valid"), Valid);
+    names.insert(QLatin1String("Enabled"), Enabled);
+    names.insert(QLatin1String("ConnectAutomatically"), ConnectAutomatically);
+    names.insert(QLatin1String("HasBeenOnline"), HasBeenOnline);
+    names.insert(QLatin1String("Parameters"), Parameters);
+    names.insert(QLatin1String("AutomaticPresence"), AutomaticPresence);
+    names.insert(QLatin1String("CurrentPresence"), CurrentPresence);
+    names.insert(QLatin1String("RequestedPresence"), RequestedPresence);
+    names.insert(QLatin1String("ChangingPresence"), ChangingPresence);
+    names.insert(QLatin1String("Connection"), ConnectionPath);
+    names.insert(QLatin1String("ConnectionStatus"), ConnectionStatusField);
+    names.insert(QLatin1String("ConnectionStatusReason"), ConnectionStatusReasonField);
+    names.insert(QLatin1String("ConnectionError"), ConnectionError);
+    names.insert(QLatin1String("ConnectionErrorDetails"), ConnectionErrorDetails);
+    return names;
+}
+
+void Account::Private::notifyChanged(const char *propertyName, QStringList &changed)
+{
+    parent->notify(propertyName);
+    changed.append(QLatin1String(propertyName));
+}
+
 void Account::Private::updateProperties(const QVariantMap &props)
 {
     debug() << "Account::updateProperties: changed:";
 
-    if (props.contains(QLatin1String("Interfaces"))) {
-        parent->setInterfaces(qdbus_cast<QStringList>(props[QLatin1String("Interfaces")]));
+    PropertiesDelta delta(props);
+    QStringList changed;
+
+    if (delta.has(PropertiesDelta::Interfaces)) {
+        parent->setInterfaces(delta.interfaces);
         debug() << " Interfaces:" << parent->interfaces();
     }
 
     QString oldIconName = parent->iconName();
     bool serviceNameChanged = false;
     bool profileChanged = false;
-    if (props.contains(QLatin1String("Service")) &&
-        serviceName != qdbus_cast<QString>(props[QLatin1String("Service")])) {
+    if (delta.has(PropertiesDelta::Service) && serviceName != delta.serviceName) {
         serviceNameChanged = true;
-        serviceName = qdbus_cast<QString>(props[QLatin1String("Service")]);
+        serviceName = delta.serviceName;
         debug() << " Service Name:" << parent->serviceName();
         /* use parent->serviceName() here as if the service name is empty we are going to use the
          * protocol name */
         emit parent->serviceNameChanged(parent->serviceName());
-        parent->notify("serviceName");
+        notifyChanged("serviceName", changed);
 
         /* if we had a profile and the service changed, it means the profile also changed */
         if (parent->isReady(Account::FeatureProfile)) {
@@ -4286,79 +4512,69 @@ void Account::Private::updateProperties(const QVariantMap &props)
             profileChanged = true;
             profile.reset();
             emit parent->profileChanged(parent->profile());
-            parent->notify("profile");
+            notifyChanged("profile", changed);
         }
     }
 
-    if (props.contains(QLatin1String("DisplayName")) &&
-        displayName != qdbus_cast<QString>(props[QLatin1String("DisplayName")])) {
-        displayName = qdbus_cast<QString>(props[QLatin1String("DisplayName")]);
+    if (delta.has(PropertiesDelta::DisplayName) && displayName != delta.displayName) {
+        displayName = delta.displayName;
         debug() << " Display Name:" << displayName;
         emit parent->displayNameChanged(displayName);
-        parent->notify("displayName");
+        notifyChanged("displayName", changed);
     }
 
-    if ((props.contains(QLatin1String("Icon")) &&
-         oldIconName != qdbus_cast<QString>(props[QLatin1String("Icon")])) ||
-        serviceNameChanged) {
-
-        if (props.contains(QLatin1String("Icon"))) {
-            iconName = qdbus_cast<QString>(props[QLatin1String("Icon")]);
+    /* the icon name falls back to one derived from the service, so it can only have changed if
+     * either of them did */
+    if ((delta.has(PropertiesDelta::Icon) && iconName != delta.iconName) || serviceNameChanged) {
+        if (delta.has(PropertiesDelta::Icon)) {
+            iconName = delta.iconName;
         }
 
         QString newIconName = parent->iconName();
         if (oldIconName != newIconName) {
             debug() << " Icon:" << newIconName;
             emit parent->iconNameChanged(newIconName);
-            parent->notify("iconName");
+            notifyChanged("iconName", changed);
         }
     }
 
-    if (props.contains(QLatin1String("Nickname")) &&
-        nickname != qdbus_cast<QString>(props[QLatin1String("Nickname")])) {
-        nickname = qdbus_cast<QString>(props[QLatin1String("Nickname")]);
+    if (delta.has(PropertiesDelta::Nickname) && nickname != delta.nickname) {
+        nickname = delta.nickname;
         debug() << " Nickname:" << nickname;
         emit parent->nicknameChanged(nickname);
-        parent->notify("nickname");
+        notifyChanged("nickname", changed);
     }
 
-    if (props.contains(QLatin1String("NormalizedName")) &&
-        normalizedName != qdbus_cast<QString>(props[QLatin1String("NormalizedName")])) {
-        normalizedName = qdbus_cast<QString>(props[QLatin1String("NormalizedName")]);
+    if (delta.has(PropertiesDelta::NormalizedName) && normalizedName != delta.normalizedName) {
+        normalizedName = delta.normalizedName;
         debug() << " Normalized Name:" << normalizedName;
         emit parent->normalizedNameChanged(normalizedName);
-        parent->notify("normalizedName");
+        notifyChanged("normalizedName", changed);
     }
 
-    if (props.contains(QLatin1String("Valid")) &&
-        valid != qdbus_cast<bool>(props[QLatin1String("Valid")])) {
-        valid = qdbus_cast<bool>(props[QLatin1String("Valid")]);
+    if (delta.has(PropertiesDelta::Valid) && valid != delta.valid) {
+        valid = delta.valid;
         debug() << " Valid:" << (valid ? "true" : "false");
         emit parent->validityChanged(valid);
-        parent->notify("valid");
+        notifyChanged("valid", changed);
     }
 
-    if (props.contains(QLatin1String("Enabled")) &&
-        enabled != qdbus_cast<bool>(props[QLatin1String("Enabled")])) {
-        enabled = qdbus_cast<bool>(props[QLatin1String("Enabled")]);
+    if (delta.has(PropertiesDelta::Enabled) && enabled != delta.enabled) {
+        enabled = delta.enabled;
         debug() << " Enabled:" << (enabled ? "true" : "false");
         emit parent->stateChanged(enabled);
-        parent->notify("enabled");
+        notifyChanged("enabled", changed);
     }
 
-    if (props.contains(QLatin1String("ConnectAutomatically")) &&
-        connectsAutomatically !=
-                qdbus_cast<bool>(props[QLatin1String("ConnectAutomatically")])) {
-        connectsAutomatically =
-                qdbus_cast<bool>(props[QLatin1String("ConnectAutomatically")]);
+    if (delta.has(PropertiesDelta::ConnectAutomatically) &&
+        connectsAutomatically != delta.connectsAutomatically) {
+        connectsAutomatically = delta.connectsAutomatically;
         debug() << " Connects Automatically:" << (connectsAutomatically ? "true" : "false");
         emit parent->connectsAutomaticallyPropertyChanged(connectsAutomatically);
-        parent->notify("connectsAutomatically");
+        notifyChanged("connectsAutomatically", changed);
     }
 
-    if (props.contains(QLatin1String("HasBeenOnline")) &&
-        !hasBeenOnline &&
-        qdbus_cast<bool>(props[QLatin1String("HasBeenOnline")])) {
+    if (delta.has(PropertiesDelta::HasBeenOnline) && !hasBeenOnline && delta.hasBeenOnline) {
         hasBeenOnline = true;
         debug() << " HasBeenOnline changed to true";
         // don't emit firstOnline unless we're already ready, that would be
@@ -4367,75 +4583,59 @@ void Account::Private::updateProperties(const QVariantMap &props)
         if (parent->isReady(Account::FeatureCore)) {
             emit parent->firstOnline();
         }
-        parent->notify("hasBeenOnline");
+        notifyChanged("hasBeenOnline", changed);
     }
 
-    if (props.contains(QLatin1String("Parameters")) &&
-        parameters != qdbus_cast<QVariantMap>(props[QLatin1String("Parameters")])) {
-        parameters = qdbus_cast<QVariantMap>(props[QLatin1String("Parameters")]);
+    if (delta.has(PropertiesDelta::Parameters) && parameters != delta.parameters) {
+        parameters = delta.parameters;
         emit parent->parametersChanged(parameters);
-        parent->notify("parameters");
+        notifyChanged("parameters", changed);
     }
 
-    if (props.contains(QLatin1String("AutomaticPresence")) &&
-        automaticPresence.barePresence() != qdbus_cast<SimplePresence>(
-                props[QLatin1String("AutomaticPresence")])) {
-        automaticPresence = Presence(qdbus_cast<SimplePresence>(
-                props[QLatin1String("AutomaticPresence")]));
+    if (delta.has(PropertiesDelta::AutomaticPresence) &&
+        automaticPresence.barePresence() != delta.automaticPresence) {
+        automaticPresence = Presence(delta.automaticPresence);
         debug() << " Automatic Presence:" << automaticPresence.type() <<
             "-" << automaticPresence.status();
         emit parent->automaticPresenceChanged(automaticPresence);
-        parent->notify("automaticPresence");
+        notifyChanged("automaticPresence", changed);
     }
 
-    if (props.contains(QLatin1String("CurrentPresence")) &&
-        currentPresence.barePresence() != qdbus_cast<SimplePresence>(
-                props[QLatin1String("CurrentPresence")])) {
-        currentPresence = Presence(qdbus_cast<SimplePresence>(
-                props[QLatin1String("CurrentPresence")]));
+    if (delta.has(PropertiesDelta::CurrentPresence) &&
+        currentPresence.barePresence() != delta.currentPresence) {
+        bool wasOnline = parent->isOnline();
+        currentPresence = Presence(delta.currentPresence);
         debug() << " Current Presence:" << currentPresence.type() <<
             "-" << currentPresence.status();
         emit parent->currentPresenceChanged(currentPresence);
-        parent->notify("currentPresence");
-        emit parent->onlinenessChanged(parent->isOnline());
-        parent->notify("online");
+        notifyChanged("currentPresence", changed);
+        if (parent->isOnline() != wasOnline) {
+            emit parent->onlinenessChanged(parent->isOnline());
+            notifyChanged("online", changed);
+        }
     }
 
-    if (props.contains(QLatin1String("RequestedPresence")) &&
-        requestedPresence.barePresence() != qdbus_cast<SimplePresence>(
-                props[QLatin1String("RequestedPresence")])) {
-        requestedPresence = Presence(qdbus_cast<SimplePresence>(
-                props[QLatin1String("RequestedPresence")]));
+    if (delta.has(PropertiesDelta::RequestedPresence) &&
+        requestedPresence.barePresence() != delta.requestedPresence) {
+        requestedPresence = Presence(delta.requestedPresence);
         debug() << " Requested Presence:" << requestedPresence.type() <<
             "-" << requestedPresence.status();
         emit parent->requestedPresenceChanged(requestedPresence);
-        parent->notify("requestedPresence");
+        notifyChanged("requestedPresence", changed);
     }
 
-    if (props.contains(QLatin1String("ChangingPresence")) &&
-        changingPresence != qdbus_cast<bool>(
-                props[QLatin1String("ChangingPresence")])) {
-        changingPresence = qdbus_cast<bool>(
-                props[QLatin1String("ChangingPresence")]);
+    if (delta.has(PropertiesDelta::ChangingPresence) &&
+        changingPresence != delta.changingPresence) {
+        changingPresence = delta.changingPresence;
         debug() << " Changing Presence:" << changingPresence;
         emit parent->changingPresence(changingPresence);
-        parent->notify("changingPresence");
+        notifyChanged("changingPresence", changed);
     }
 
-    if (props.contains(QLatin1String("Connection"))) {
-        QString path = qdbus_cast<QDBusObjectPath>(props[QLatin1String("Connection")]).path();
-        if (path.isEmpty()) {
-            debug() << " The map contains \"Connection\" but it's empty as a QDBusObjectPath!";
-            debug() << " Trying QString (known bug in some MC/dbus-glib versions)";
-            path = qdbus_cast<QString>(props[QLatin1String("Connection")]);
-        }
-
-        debug() << " Connection Object Path:" << path;
-        if (path == QLatin1String("/")) {
-            path = QString();
-        }
+    if (delta.has(PropertiesDelta::ConnectionPath)) {
+        debug() << " Connection Object Path:" << delta.connectionObjectPath;
 
-        connObjPathQueue.enqueue(path);
+        connObjPathQueue.enqueue(delta.connectionObjectPath);
 
         if (connObjPathQueue.size() == 1) {
             processConnQueue();
@@ -4446,49 +4646,41 @@ void Account::Private::updateProperties(const QVariantMap &props)
     }
 
     bool connectionStatusChanged = false;
-    if (props.contains(QLatin1String("ConnectionStatus")) ||
-        props.contains(QLatin1String("ConnectionStatusReason")) ||
-        props.contains(QLatin1String("ConnectionError")) ||
-        props.contains(QLatin1String("ConnectionErrorDetails"))) {
+    if (delta.has(PropertiesDelta::ConnectionStatusField) ||
+        delta.has(PropertiesDelta::ConnectionStatusReasonField) ||
+        delta.has(PropertiesDelta::ConnectionError) ||
+        delta.has(PropertiesDelta::ConnectionErrorDetails)) {
         ConnectionStatus oldConnectionStatus = connectionStatus;
 
-        if (props.contains(QLatin1String("ConnectionStatus")) &&
-            connectionStatus != ConnectionStatus(
-                    qdbus_cast<uint>(props[QLatin1String("ConnectionStatus")]))) {
-            connectionStatus = ConnectionStatus(
-                    qdbus_cast<uint>(props[QLatin1String("ConnectionStatus")]));
+        if (delta.has(PropertiesDelta::ConnectionStatusField) &&
+            connectionStatus != delta.connectionStatus) {
+            connectionStatus = delta.connectionStatus;
             debug() << " Connection Status:" << connectionStatus;
             connectionStatusChanged = true;
         }
 
-        if (props.contains(QLatin1String("ConnectionStatusReason")) &&
-            connectionStatusReason != ConnectionStatusReason(
-                    qdbus_cast<uint>(props[QLatin1String("ConnectionStatusReason")]))) {
-            connectionStatusReason = ConnectionStatusReason(
-                    qdbus_cast<uint>(props[QLatin1String("ConnectionStatusReason")]));
+        if (delta.has(PropertiesDelta::ConnectionStatusReasonField) &&
+            connectionStatusReason != delta.connectionStatusReason) {
+            connectionStatusReason = delta.connectionStatusReason;
             debug() << " Connection StatusReason:" << connectionStatusReason;
             connectionStatusChanged = true;
         }
 
         if (connectionStatusChanged) {
-            parent->notify("connectionStatus");
-            parent->notify("connectionStatusReason");
+            notifyChanged("connectionStatus", changed);
+            notifyChanged("connectionStatusReason", changed);
         }
 
-        if (props.contains(QLatin1String("ConnectionError")) &&
-            connectionError != qdbus_cast<QString>(
-                props[QLatin1String("ConnectionError")])) {
-            connectionError = qdbus_cast<QString>(
-                    props[QLatin1String("ConnectionError")]);
+        if (delta.has(PropertiesDelta::ConnectionError) &&
+            connectionError != delta.connectionError) {
+            connectionError = delta.connectionError;
             debug() << " Connection Error:" << connectionError;
             connectionStatusChanged = true;
         }
 
-        if (props.contains(QLatin1String("ConnectionErrorDetails")) &&
-            connectionErrorDetails.allDetails() != qdbus_cast<QVariantMap>(
-                props[QLatin1String("ConnectionErrorDetails")])) {
-            connectionErrorDetails = Connection::ErrorDetails(qdbus_cast<QVariantMap>(
-                    props[QLatin1String("ConnectionErrorDetails")]));
+        if (delta.has(PropertiesDelta::ConnectionErrorDetails) &&
+            connectionErrorDetails.allDetails() != delta.connectionErrorDetails) {
+            connectionErrorDetails = Connection::ErrorDetails(delta.connectionErrorDetails);
             debug() << " Connection Error Details:" << connectionErrorDetails.allDetails();
             connectionStatusChanged = true;
         }
@@ -4513,8 +4705,8 @@ void Account::Private::updateProperties(const QVariantMap &props)
                 checkCapabilitiesChanged(profileChanged);
 
                 emit parent->connectionStatusChanged(connectionStatus);
-                parent->notify("connectionError");
-                parent->notify("connectionErrorDetails");
+                notifyChanged("connectionError", changed);
+                notifyChanged("connectionErrorDetails", changed);
             } else {
                 connectionStatusChanged = false;
             }
@@ -4524,6 +4716,23 @@ void Account::Private::updateProperties(const QVariantMap &props)
     if (!connectionStatusChanged && profileChanged) {
         checkCapabilitiesChanged(profileChanged);
     }
+
+    if (!changed.isEmpty()) {
+        emit parent->propertiesChanged(changed);
+    }
+}
+
+void Account::Private::finishCoreIntrospection()
+{
+    mayFinishCore = true;
+
+    if (connObjPathQueue.isEmpty()) {
+        debug() << "Account basic functionality is ready";
+        coreFinished = true;
+        readinessHelper->setIntrospectCompleted(FeatureCore, true);
+    } else {
+        debug() << "Deferring finishing Account::FeatureCore until the connection is built";
+    }
 }
 
 void Account::Private::retrieveAvatar()
@@ -4601,6 +4810,21 @@ void Account::onDispatcherIntrospected(Tp::PendingOperation *op)
         }
     }
 
+    if (mPriv->mainPropertiesPrefetched) {
+        debug() << "Using prefetched Properties::GetAll(Account) for" << objectPath();
+        mPriv->mainPropertiesPrefetched = false;
+        mPriv->finishCoreIntrospection();
+        return;
+    }
+
+    if (mPriv->prefetchedMainProperties) {
+        debug() << "Waiting for prefetched Properties::GetAll(Account) on" << objectPath();
+        mPriv->mainPropertiesWanted = true;
+        return;
+    }
+
+    mPriv->mainPropertiesRequested = true;
+
     debug() << "Calling Properties::GetAll(Account) on " << objectPath();
     QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(
             mPriv->properties->GetAll(
@@ -4613,21 +4837,41 @@ void Account::onDispatcherIntrospected(Tp::PendingOperation *op)
 void Account::gotMainProperties(QDBusPendingCallWatcher *watcher)
 {
     QDBusPendingReply<QVariantMap> reply = *watcher;
+    bool prefetched = (watcher == mPriv->prefetchedMainProperties);
+    if (prefetched) {
+        mPriv->prefetchedMainProperties = nullptr;
+    }
+
+    if (reply.isError() && prefetched) {
+        warning().nospace() <<
+            "Prefetched GetAll(Account) failed: " <<
+            reply.error().name() << ": " << reply.error().message() <<
+            ", retrying on " << objectPath();
+        watcher->deleteLater();
+        mPriv->mainPropertiesRequested = false;
+        if (mPriv->mainPropertiesWanted) {
+            mPriv->mainPropertiesWanted = false;
+            onDispatcherIntrospected(nullptr);
+        }
+        return;
+    }
 
     if (!reply.isError()) {
         debug() << "Got reply to Properties.GetAll(Account) for" << objectPath();
         mPriv->updateProperties(reply.value());
 
         mPriv->readinessHelper->setInterfaces(interfaces());
-        mPriv->mayFinishCore = true;
 
-        if (mPriv->connObjPathQueue.isEmpty()) {
-            debug() << "Account basic functionality is ready";
-            mPriv->coreFinished = true;
-            mPriv->readinessHelper->setIntrospectCompleted(FeatureCore, true);
-        } else {
-            debug() << "Deferring finishing Account::FeatureCore until the connection is built";
+        if (prefetched && !mPriv->mainPropertiesWanted) {
+            debug() << "Deferring finishing Account::FeatureCore until the channel dispatcher "
+                "is introspected";
+            mPriv->mainPropertiesPrefetched = true;
+            watcher->deleteLater();
+            return;
         }
+
+        mPriv->mainPropertiesWanted = false;
+        mPriv->finishCoreIntrospection();
     } else {
         mPriv->readinessHelper->setIntrospectCompleted(FeatureCore, false, reply.error());
 
@@ -4965,4 +5209,20 @@ void Account::onConnectionBuilt(PendingOperation *op)
  * \sa connection()
  */
 
+/**
+ * \fn void Account::propertiesChanged(const QStringList &propertyNames)
+ *
+ * Emitted once for each batch of property changes received from the account manager, after
+ * the signals for the individual properties that changed.
+ *
+ * Only properties whose values actually changed are included, so this can be used to refresh
+ * a user interface once per update instead of once per property.
+ *
+ * Changes to connection() are not included, as the new connection is only built afterwards;
+ * connectionChanged() is emitted for them instead.
+ *
+ * \param propertyNames The names of the Qt properties that changed, as in
+ *                      Object::propertyChanged().
+ */
+
 } // Tp
@@ -571,9 +571,11 @@ Q_SIGNALS:
     void avatarChanged(const Tp::Avatar &avatar);
     void connectionStatusChanged(Tp::ConnectionStatus status);
     void connectionChanged(const Tp::ConnectionPtr &connection);
+    void propertiesChanged(const QStringList &propertyNames);
 
 protected:
     friend class PendingChannelRequest; // to access dispatcherInterface()
+    friend class AccountManager; // to access prefetchMainProperties()
 
     Account(const QDBusConnection &bus,
             const QString &busName, const QString &objectPath,
@@ -597,6 +599,8 @@ private Q_SLOTS:
     TP_QT_NO_EXPORT void onConnectionBuilt(Tp::PendingOperation *);
 
 private:
+    TP_QT_NO_EXPORT void prefetchMainProperties();
+
     struct Private;
     friend struct Private;
 
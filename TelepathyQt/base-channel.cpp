@@ -40,11 +40,20 @@
 #include <TelepathyQt/AbstractProtocolInterface>
 
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QFileDevice>
+#include <QLocalSocket>
 #include <QString>
 #include <QTcpServer>
 #include <QTcpSocket>
+#include <QTimer>
 #include <QVariantMap>
 
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <sys/sendfile.h>
+#endif
+
 namespace Tp
 {
 
@@ -275,21 +284,21 @@ void BaseChannel::close()
 QVariantMap BaseChannel::immutableProperties() const
 {
     QVariantMap map;
-    map.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType"),
+    map.insert(TP_QT_PROP_CHANNEL_CHANNEL_TYPE,
                QVariant::fromValue(mPriv->adaptee->channelType()));
-    map.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandle"),
+    map.insert(TP_QT_PROP_CHANNEL_TARGET_HANDLE,
                QVariant::fromValue(mPriv->adaptee->targetHandle()));
-    map.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".Interfaces"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACES,
                QVariant::fromValue(mPriv->adaptee->interfaces()));
-    map.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".TargetID"),
+    map.insert(TP_QT_PROP_CHANNEL_TARGET_ID,
                QVariant::fromValue(mPriv->adaptee->targetID()));
-    map.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandleType"),
+    map.insert(TP_QT_PROP_CHANNEL_TARGET_HANDLE_TYPE,
                QVariant::fromValue(mPriv->adaptee->targetHandleType()));
-    map.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".Requested"),
+    map.insert(TP_QT_PROP_CHANNEL_REQUESTED,
                QVariant::fromValue(mPriv->adaptee->requested()));
-    map.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".InitiatorHandle"),
+    map.insert(TP_QT_PROP_CHANNEL_INITIATOR_HANDLE,
                QVariant::fromValue(mPriv->adaptee->initiatorHandle()));
-    map.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".InitiatorID"),
+    map.insert(TP_QT_PROP_CHANNEL_INITIATOR_ID,
                QVariant::fromValue(mPriv->adaptee->initiatorID()));
     return map;
 }
@@ -683,13 +692,13 @@ QVariantMap BaseChannelMessagesInterface::immutableProperties() const
 {
     QVariantMap map;
 
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_MESSAGES + QLatin1String(".SupportedContentTypes"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_MESSAGES_SUPPORTED_CONTENT_TYPES,
                QVariant::fromValue(mPriv->adaptee->supportedContentTypes()));
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_MESSAGES + QLatin1String(".MessageTypes"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_MESSAGES_MESSAGE_TYPES,
                QVariant::fromValue(mPriv->adaptee->messageTypes()));
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_MESSAGES + QLatin1String(".MessagePartSupportFlags"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_MESSAGES_MESSAGE_PART_SUPPORT_FLAGS,
                QVariant::fromValue(mPriv->adaptee->messagePartSupportFlags()));
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_MESSAGES + QLatin1String(".DeliveryReportingSupport"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_MESSAGES_DELIVERY_REPORTING_SUPPORT,
                QVariant::fromValue(mPriv->adaptee->deliveryReportingSupport()));
     return map;
 }
@@ -814,15 +823,20 @@ struct TP_QT_NO_EXPORT BaseChannelFileTransferType::Private {
           weOpenedDevice(false),
           serverSocket(nullptr),
           clientSocket(nullptr),
+          outputBlocked(false),
+          transferredBytesChangedInterval(0),
+          transferredBytesChangedThreshold(0),
+          signalledTransferredBytes(0),
+          transferredBytesChangedTimer(nullptr),
           adaptee(new BaseChannelFileTransferType::Adaptee(parent))
     {
-        contentType = request.value(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".ContentType")).toString();
-        filename = request.value(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".Filename")).toString();
-        size = request.value(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".Size")).toULongLong();
-        contentHashType = request.value(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".ContentHashType")).toUInt();
-        contentHash = request.value(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".ContentHash")).toString();
-        description = request.value(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".Description")).toString();
-        qint64 dbusDataValue = request.value(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".Date")).value<qint64>();
+        contentType = request.value(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_CONTENT_TYPE).toString();
+        filename = request.value(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_FILENAME).toString();
+        size = request.value(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_SIZE).toULongLong();
+        contentHashType = request.value(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_CONTENT_HASH_TYPE).toUInt();
+        contentHash = request.value(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_CONTENT_HASH).toString();
+        description = request.value(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_DESCRIPTION).toString();
+        qint64 dbusDataValue = request.value(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_DATE).value<qint64>();
         if (dbusDataValue != 0) {
 #if QT_VERSION < QT_VERSION_CHECK(5, 8, 0)
             date.setTime_t(dbusDataValue);
@@ -831,11 +845,11 @@ struct TP_QT_NO_EXPORT BaseChannelFileTransferType::Private {
 #endif
         }
 
-        if (request.contains(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".URI"))) {
-            uri = request.value(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".URI")).toString();
+        if (request.contains(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_URI)) {
+            uri = request.value(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_URI).toString();
         }
 
-        if (request.value(TP_QT_IFACE_CHANNEL + QLatin1String(".Requested")).toBool()) {
+        if (request.value(TP_QT_PROP_CHANNEL_REQUESTED).toBool()) {
             direction = BaseChannelFileTransferType::Outgoing;
         } else {
             direction = BaseChannelFileTransferType::Incoming;
@@ -860,12 +874,134 @@ struct TP_QT_NO_EXPORT BaseChannelFileTransferType::Private {
     QTcpServer *serverSocket; // Server socket is an implementation detail.
     QIODevice *clientSocket; // A socket to communicate with a Telepathy client
     BaseChannelFileTransferType::Direction direction;
+
+    // Transfer buffer, grown up to c_maxBlockSize while reads keep filling it
+    QByteArray buffer;
+    // Set when reading stopped because the output has too much data pending
+    bool outputBlocked;
+
+    void emitTransferredBytesChanged();
+    bool shouldEmitTransferredBytesChanged() const;
+
+    int transferredBytesChangedInterval;
+    qulonglong transferredBytesChangedThreshold;
+    qulonglong signalledTransferredBytes;
+    QElapsedTimer transferredBytesChangedElapsed;
+    QTimer *transferredBytesChangedTimer;
+
     BaseChannelFileTransferType::Adaptee *adaptee;
 
     friend class BaseChannelFileTransferType::Adaptee;
 
 };
 
+static const int c_minBlockSize = 16 * 1024;
+static const int c_maxBlockSize = 1024 * 1024;
+// Reading from the input stops while the output has more than this pending
+static const qint64 c_maxPendingBytes = 2 * c_maxBlockSize;
+// Bound a single sendfile() round so the event loop stays responsive
+static const qint64 c_maxSendFileSize = 8 * c_maxBlockSize;
+
+void BaseChannelFileTransferType::Private::emitTransferredBytesChanged()
+{
+    if (transferredBytesChangedTimer) {
+        transferredBytesChangedTimer->stop();
+    }
+
+    signalledTransferredBytes = transferredBytes;
+    transferredBytesChangedElapsed.start();
+    QMetaObject::invokeMethod(adaptee, "transferredBytesChanged", Q_ARG(qulonglong, transferredBytes)); //Can simply use emit in Qt5
+}
+
+bool BaseChannelFileTransferType::Private::shouldEmitTransferredBytesChanged() const
+{
+    if (transferredBytesChangedInterval <= 0 && transferredBytesChangedThreshold == 0) {
+        return true;
+    }
+
+    if (!transferredBytesChangedElapsed.isValid()) {
+        return true;
+    }
+
+    if (transferredBytesChangedInterval > 0 &&
+            transferredBytesChangedElapsed.elapsed() >= transferredBytesChangedInterval) {
+        return true;
+    }
+
+    qulonglong delta = transferredBytes > signalledTransferredBytes ?
+            transferredBytes - signalledTransferredBytes : signalledTransferredBytes - transferredBytes;
+    return transferredBytesChangedThreshold > 0 && delta >= transferredBytesChangedThreshold;
+}
+
+static qintptr socketDescriptor(QIODevice *device)
+{
+    // Writing to the descriptor of an encrypted socket would bypass the encryption
+    if (device->inherits("QSslSocket")) {
+        return -1;
+    }
+
+    QAbstractSocket *abstractSocket = qobject_cast<QAbstractSocket*>(device);
+    if (abstractSocket) {
+        if (abstractSocket->state() != QAbstractSocket::ConnectedState) {
+            return -1;
+        }
+        return abstractSocket->socketDescriptor();
+    }
+
+    QLocalSocket *localSocket = qobject_cast<QLocalSocket*>(device);
+    if (localSocket) {
+        if (localSocket->state() != QLocalSocket::ConnectedState) {
+            return -1;
+        }
+        return localSocket->socketDescriptor();
+    }
+
+    return -1;
+}
+
+// Copy up to maxSize bytes from a regular file to a socket inside the kernel. Returns the number
+// of bytes sent, 0 if the devices are not suitable or the socket can't take more data right now.
+static qint64 sendFile(QIODevice *input, QIODevice *output, qint64 maxSize)
+{
+#ifdef Q_OS_LINUX
+    QFileDevice *file = qobject_cast<QFileDevice*>(input);
+    if (!file || file->isSequential() || file->handle() < 0) {
+        return 0;
+    }
+
+    qintptr outputDescriptor = socketDescriptor(output);
+    if (outputDescriptor < 0) {
+        return 0;
+    }
+
+    // pos() accounts for data QIODevice has already buffered, and the seek below discards it
+    off_t offset = file->pos();
+    qint64 sent = 0;
+    while (sent < maxSize) {
+        ssize_t result = ::sendfile(outputDescriptor, file->handle(), &offset, maxSize - sent);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            // The socket is full, the file ended or failed; the buffered path handles it from here
+            break;
+        }
+        sent += result;
+    }
+
+    if (sent > 0) {
+        file->seek(file->pos() + sent);
+    }
+
+    return sent;
+#else
+    Q_UNUSED(input);
+    Q_UNUSED(output);
+    Q_UNUSED(maxSize);
+    return 0;
+#endif
+}
+
 BaseChannelFileTransferType::Adaptee::Adaptee(BaseChannelFileTransferType *interface)
     : QObject(interface),
       mInterface(interface)
@@ -1039,7 +1175,9 @@ void BaseChannelFileTransferType::Adaptee::provideFile(uint addressType, uint ac
  * -# The channel state is Open now.
  * -# If the device is already ready to read, or emit readyRead() signal, the interface reads data from the device and
  *    write it to the clientSocket.
- * -# Client socket emit bytesWritten() signal, the interface updates transferredBytes count.
+ * -# Client socket emit bytesWritten() signal, the interface updates transferredBytes count. On Linux, data from
+ *    a regular file is sent to the client socket with sendfile() when nothing is buffered in between, and
+ *    transferredBytes is updated right away.
  * -# If transferredBytes == size, then the channel state changes to Completed.
  *    Otherwise the interface waits for further data from the device socket.
  *
@@ -1070,6 +1208,12 @@ void BaseChannelFileTransferType::Adaptee::provideFile(uint addressType, uint ac
  * + Custom createSocket() implementation MUST be paired with custom socketAddress() method implementation.
  * + Use setClientSocket() method to pass the client socket.
  *
+ * The data is copied in blocks growing from 16 KiB up to 1 MiB. Reading from the input stops
+ * while the output has more than 2 MiB pending, and resumes when the output emits bytesWritten().
+ *
+ * Every change of transferredBytes is signalled on the bus by default. Use
+ * setTransferredBytesChangedInterval() and setTransferredBytesChangedThreshold() to limit the
+ * rate of TransferredBytesChanged signals during large transfers.
  */
 
 /**
@@ -1155,15 +1299,91 @@ void BaseChannelFileTransferType::setTransferredBytes(qulonglong count)
     }
 
     mPriv->transferredBytes = count;
-    QMetaObject::invokeMethod(mPriv->adaptee, "transferredBytesChanged", Q_ARG(qulonglong, count)); //Can simply use emit in Qt5
 
-    if (transferredBytes() == size()) {
+    bool completed = transferredBytes() == size();
+    if (completed || mPriv->shouldEmitTransferredBytesChanged()) {
+        mPriv->emitTransferredBytesChanged();
+    } else if (mPriv->transferredBytesChangedInterval > 0) {
+        if (!mPriv->transferredBytesChangedTimer) {
+            mPriv->transferredBytesChangedTimer = new QTimer(this);
+            mPriv->transferredBytesChangedTimer->setSingleShot(true);
+            connect(mPriv->transferredBytesChangedTimer, SIGNAL(timeout()),
+                    this, SLOT(onTransferredBytesChangedTimeout()));
+        }
+
+        if (!mPriv->transferredBytesChangedTimer->isActive()) {
+            qint64 remaining = mPriv->transferredBytesChangedInterval -
+                    mPriv->transferredBytesChangedElapsed.elapsed();
+            mPriv->transferredBytesChangedTimer->start(qMax<qint64>(remaining, 0));
+        }
+    }
+
+    if (completed) {
         mPriv->clientSocket->close();
-        mPriv->serverSocket->close();
+        if (mPriv->serverSocket) {
+            mPriv->serverSocket->close();
+        }
         setState(Tp::FileTransferStateCompleted, Tp::FileTransferStateChangeReasonNone);
     }
 }
 
+/**
+ * Return the minimum time between TransferredBytesChanged signals.
+ *
+ * \return The interval in milliseconds, 0 if the signal is not throttled by time.
+ * \sa setTransferredBytesChangedInterval()
+ */
+int BaseChannelFileTransferType::transferredBytesChangedInterval() const
+{
+    return mPriv->transferredBytesChangedInterval;
+}
+
+/**
+ * Set the minimum time between TransferredBytesChanged signals.
+ *
+ * By default, every change of transferredBytes is signalled, which floods the bus during a
+ * large transfer. With an interval set, changes within the interval are coalesced and the
+ * latest value is signalled when the interval expires. The final value of a completed
+ * transfer is always signalled immediately.
+ *
+ * Can be combined with setTransferredBytesChangedThreshold(); a change is then signalled as
+ * soon as either limit is reached.
+ *
+ * \param msecs The interval in milliseconds, or 0 to not throttle by time.
+ */
+void BaseChannelFileTransferType::setTransferredBytesChangedInterval(int msecs)
+{
+    mPriv->transferredBytesChangedInterval = qMax(msecs, 0);
+    if (mPriv->transferredBytesChangedInterval == 0 && mPriv->transferredBytesChangedTimer &&
+            mPriv->transferredBytesChangedTimer->isActive()) {
+        mPriv->emitTransferredBytesChanged();
+    }
+}
+
+/**
+ * Return the minimum change of transferredBytes which is signalled right away.
+ *
+ * \return The threshold in bytes, 0 if the signal is not throttled by byte count.
+ * \sa setTransferredBytesChangedThreshold()
+ */
+qulonglong BaseChannelFileTransferType::transferredBytesChangedThreshold() const
+{
+    return mPriv->transferredBytesChangedThreshold;
+}
+
+/**
+ * Set the minimum change of transferredBytes which is signalled right away.
+ *
+ * Smaller changes are signalled once they add up to \a bytes, when the interval set by
+ * setTransferredBytesChangedInterval() expires, or when the transfer ends.
+ *
+ * \param bytes The threshold in bytes, or 0 to not throttle by byte count.
+ */
+void BaseChannelFileTransferType::setTransferredBytesChangedThreshold(qulonglong bytes)
+{
+    mPriv->transferredBytesChangedThreshold = bytes;
+}
+
 void BaseChannelFileTransferType::setClientSocket(QIODevice *socket)
 {
     mPriv->clientSocket = socket;
@@ -1218,13 +1438,36 @@ void BaseChannelFileTransferType::doTransfer()
         break;
     }
 
-    static const int c_blockSize = 16 * 1024;
-    char buffer[c_blockSize];
-    char *inputPointer = buffer;
+    // Leave the data in the input until the output drains, onOutputBytesWritten() resumes the transfer
+    if (output->bytesToWrite() >= c_maxPendingBytes) {
+        mPriv->outputBlocked = true;
+        return;
+    }
 
-    qint64 length = input->read(buffer, sizeof(buffer));
+    // Let the kernel copy file data to the client socket once nothing is buffered in between
+    if (mPriv->direction == BaseChannelFileTransferType::Incoming &&
+            mPriv->deviceOffset >= initialOffset() && output->bytesToWrite() == 0) {
+        qint64 sent = sendFile(input, output, c_maxSendFileSize);
+        if (sent > 0) {
+            mPriv->deviceOffset += sent;
+            // The data bypassed QIODevice, so there is no bytesWritten() signal for it
+            setTransferredBytes(transferredBytes() + sent);
+            if (state() != Tp::FileTransferStateOpen) {
+                return;
+            }
+        }
+    }
+
+    if (mPriv->buffer.size() < c_minBlockSize) {
+        mPriv->buffer.resize(c_minBlockSize);
+    }
+
+    char *inputPointer = mPriv->buffer.data();
+    qint64 length = input->read(inputPointer, mPriv->buffer.size());
+
+    if (length > 0) {
+        bool bufferFilled = length == mPriv->buffer.size();
 
-    if (length) {
         // deviceOffset is the number of already skipped bytes
         if (mPriv->deviceOffset + length > initialOffset()) {
             if (mPriv->deviceOffset < initialOffset()) {
@@ -1236,6 +1479,10 @@ void BaseChannelFileTransferType::doTransfer()
             output->write(inputPointer, length);
         }
         mPriv->deviceOffset += length;
+
+        if (bufferFilled && mPriv->buffer.size() < c_maxBlockSize) {
+            mPriv->buffer.resize(qMin(mPriv->buffer.size() * 2, c_maxBlockSize));
+        }
     }
 
     if (input->bytesAvailable() > 0) {
@@ -1246,6 +1493,24 @@ void BaseChannelFileTransferType::doTransfer()
 void BaseChannelFileTransferType::onBytesWritten(qint64 count)
 {
     setTransferredBytes(transferredBytes() + count);
+    onOutputBytesWritten();
+}
+
+void BaseChannelFileTransferType::onOutputBytesWritten()
+{
+    if (!mPriv->outputBlocked) {
+        return;
+    }
+
+    mPriv->outputBlocked = false;
+    QMetaObject::invokeMethod(this, "doTransfer", Qt::QueuedConnection);
+}
+
+void BaseChannelFileTransferType::onTransferredBytesChangedTimeout()
+{
+    if (mPriv->signalledTransferredBytes != mPriv->transferredBytes) {
+        mPriv->emitTransferredBytesChanged();
+    }
 }
 
 /**
@@ -1267,29 +1532,29 @@ BaseChannelFileTransferType::~BaseChannelFileTransferType()
 QVariantMap BaseChannelFileTransferType::immutableProperties() const
 {
     QVariantMap map;
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".ContentType"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_CONTENT_TYPE,
                QVariant::fromValue(contentType()));
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".Filename"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_FILENAME,
                QVariant::fromValue(filename()));
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".Size"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_SIZE,
                QVariant::fromValue(size()));
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".ContentHashType"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_CONTENT_HASH_TYPE,
                QVariant::fromValue(contentHashType()));
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".ContentHash"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_CONTENT_HASH,
                QVariant::fromValue(contentHash()));
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".Description"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_DESCRIPTION,
                QVariant::fromValue(description()));
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".Date"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_DATE,
 #if QT_VERSION < QT_VERSION_CHECK(5, 8, 0)
                QVariant::fromValue(date().toTime_t()));
 #else
                QVariant::fromValue(date().toSecsSinceEpoch()));
 #endif
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".AvailableSocketTypes"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_AVAILABLE_SOCKET_TYPES,
                QVariant::fromValue(availableSocketTypes()));
 
     if (mPriv->direction == Outgoing) {
-        map.insert(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER + QLatin1String(".URI"), QVariant::fromValue(uri()));
+        map.insert(TP_QT_PROP_CHANNEL_TYPE_FILE_TRANSFER_URI, QVariant::fromValue(uri()));
     }
 
     return map;
@@ -1311,6 +1576,11 @@ void BaseChannelFileTransferType::setState(uint state, uint reason)
         return;
     }
 
+    // Progress held back by the throttle is signalled before the transfer leaves the Open state
+    if (mPriv->signalledTransferredBytes != mPriv->transferredBytes) {
+        mPriv->emitTransferredBytesChanged();
+    }
+
     mPriv->state = state;
     QMetaObject::invokeMethod(mPriv->adaptee, "fileTransferStateChanged", Q_ARG(uint, state), Q_ARG(uint, reason)); //Can simply use emit in Qt5
     emit stateChanged(state, reason);
@@ -1469,6 +1739,8 @@ bool BaseChannelFileTransferType::remoteAcceptFile(QIODevice *output, qulonglong
     mPriv->weOpenedDevice = !deviceIsAlreadynOpened;
     mPriv->initialOffset = offset;
 
+    connect(mPriv->device, SIGNAL(bytesWritten(qint64)), this, SLOT(onOutputBytesWritten()));
+
     QMetaObject::invokeMethod(mPriv->adaptee, "initialOffsetDefined", Q_ARG(qulonglong, offset)); //Can simply use emit in Qt5
     setState(Tp::FileTransferStateAccepted, Tp::FileTransferStateChangeReasonNone);
 
@@ -1593,17 +1865,34 @@ struct TP_QT_NO_EXPORT BaseChannelRoomListType::Private {
             const QString &server)
         : server(server),
           listingRooms(false),
+          gotRoomsChunkSize(256),
+          gotRoomsInterval(0),
+          gotRoomsTimer(nullptr),
           adaptee(new BaseChannelRoomListType::Adaptee(parent))
     {
     }
 
+    void emitGotRooms(const Tp::RoomInfoList &rooms);
+
     QString server;
     bool listingRooms;
     ListRoomsCallback listRoomsCB;
     StopListingCallback stopListingCB;
+
+    // Rooms passed to appendRooms() which don't fill a chunk yet
+    Tp::RoomInfoList pendingRooms;
+    int gotRoomsChunkSize;
+    int gotRoomsInterval;
+    QTimer *gotRoomsTimer;
+
     BaseChannelRoomListType::Adaptee *adaptee;
 };
 
+void BaseChannelRoomListType::Private::emitGotRooms(const Tp::RoomInfoList &rooms)
+{
+    QMetaObject::invokeMethod(adaptee, "gotRooms", Q_ARG(Tp::RoomInfoList, rooms)); //Can simply use emit in Qt5
+}
+
 BaseChannelRoomListType::Adaptee::Adaptee(BaseChannelRoomListType *interface)
     : QObject(interface),
       mInterface(interface)
@@ -1657,6 +1946,11 @@ void BaseChannelRoomListType::Adaptee::stopListing(
  * \headerfile TelepathyQt/base-channel.h <TelepathyQt/BaseChannel>
  *
  * \brief Base class for implementations of Channel.Type.RoomList
+ *
+ * Rooms can be reported with gotRooms(), which emits all of them in a single GotRooms signal,
+ * or streamed with appendRooms() while the server delivers them. Streamed rooms are emitted in
+ * chunks of at most gotRoomsChunkSize() rooms, so neither the connection manager nor the clients
+ * need to hold the complete list of a large server. Call finishRooms() once the listing is done.
  */
 
 /**
@@ -1687,7 +1981,7 @@ BaseChannelRoomListType::~BaseChannelRoomListType()
 QVariantMap BaseChannelRoomListType::immutableProperties() const
 {
     QVariantMap map;
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_ROOM_LIST + QLatin1String(".Server"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_ROOM_LIST_SERVER,
                QVariant::fromValue(mPriv->adaptee->server()));
     return map;
 }
@@ -1748,7 +2042,145 @@ void BaseChannelRoomListType::stopListing(DBusError *error)
 
 void BaseChannelRoomListType::gotRooms(const Tp::RoomInfoList &rooms)
 {
-    QMetaObject::invokeMethod(mPriv->adaptee, "gotRooms", Q_ARG(Tp::RoomInfoList, rooms)); //Can simply use emit in Qt5
+    mPriv->emitGotRooms(rooms);
+}
+
+/**
+ * Add \a rooms to the rooms found by the current listing.
+ *
+ * The rooms are buffered and emitted in GotRooms signals of gotRoomsChunkSize() rooms as soon as
+ * a chunk is full. Rooms which don't fill a chunk are emitted after gotRoomsInterval(), or by
+ * finishRooms().
+ *
+ * \param rooms The rooms to add.
+ * \sa finishRooms()
+ */
+void BaseChannelRoomListType::appendRooms(const Tp::RoomInfoList &rooms)
+{
+    if (rooms.isEmpty()) {
+        return;
+    }
+
+    int chunkSize = mPriv->gotRoomsChunkSize;
+    int offset = 0;
+
+    // Complete the pending chunk, then pass full chunks through without buffering them
+    if (!mPriv->pendingRooms.isEmpty()) {
+        offset = qMin(chunkSize - mPriv->pendingRooms.size(), rooms.size());
+        mPriv->pendingRooms.append(rooms.mid(0, offset));
+        if (mPriv->pendingRooms.size() < chunkSize) {
+            return;
+        }
+
+        Tp::RoomInfoList chunk;
+        chunk.swap(mPriv->pendingRooms);
+        mPriv->emitGotRooms(chunk);
+    }
+
+    while (rooms.size() - offset >= chunkSize) {
+        mPriv->emitGotRooms(offset == 0 && rooms.size() == chunkSize ? rooms : rooms.mid(offset, chunkSize));
+        offset += chunkSize;
+    }
+
+    if (offset == rooms.size()) {
+        if (mPriv->gotRoomsTimer) {
+            mPriv->gotRoomsTimer->stop();
+        }
+        return;
+    }
+
+    mPriv->pendingRooms = rooms.mid(offset);
+
+    if (!mPriv->gotRoomsTimer) {
+        mPriv->gotRoomsTimer = new QTimer(this);
+        mPriv->gotRoomsTimer->setSingleShot(true);
+        connect(mPriv->gotRoomsTimer, SIGNAL(timeout()), this, SLOT(flushRooms()));
+    }
+
+    if (!mPriv->gotRoomsTimer->isActive()) {
+        mPriv->gotRoomsTimer->start(mPriv->gotRoomsInterval);
+    }
+}
+
+/**
+ * Finish the current listing.
+ *
+ * Emits the rooms still buffered by appendRooms() and sets the ListingRooms property to \c false.
+ *
+ * \sa appendRooms(), setListingRooms()
+ */
+void BaseChannelRoomListType::finishRooms()
+{
+    flushRooms();
+    setListingRooms(false);
+}
+
+/**
+ * Return the maximum number of rooms emitted in one GotRooms signal by appendRooms().
+ *
+ * \return The chunk size.
+ * \sa setGotRoomsChunkSize()
+ */
+int BaseChannelRoomListType::gotRoomsChunkSize() const
+{
+    return mPriv->gotRoomsChunkSize;
+}
+
+/**
+ * Set the maximum number of rooms emitted in one GotRooms signal by appendRooms().
+ *
+ * The default chunk size is 256.
+ *
+ * \param size The chunk size, at least 1.
+ */
+void BaseChannelRoomListType::setGotRoomsChunkSize(int size)
+{
+    mPriv->gotRoomsChunkSize = qMax(size, 1);
+    if (mPriv->pendingRooms.size() >= mPriv->gotRoomsChunkSize) {
+        Tp::RoomInfoList rooms;
+        rooms.swap(mPriv->pendingRooms);
+        appendRooms(rooms);
+    }
+}
+
+/**
+ * Return the time rooms which don't fill a chunk are held back by appendRooms().
+ *
+ * \return The interval in milliseconds.
+ * \sa setGotRoomsInterval()
+ */
+int BaseChannelRoomListType::gotRoomsInterval() const
+{
+    return mPriv->gotRoomsInterval;
+}
+
+/**
+ * Set the time rooms which don't fill a chunk are held back by appendRooms().
+ *
+ * A longer interval produces fewer, fuller GotRooms signals when the server delivers rooms in
+ * small batches. The default interval is 0, which emits the remaining rooms once control returns
+ * to the event loop.
+ *
+ * \param msecs The interval in milliseconds.
+ */
+void BaseChannelRoomListType::setGotRoomsInterval(int msecs)
+{
+    mPriv->gotRoomsInterval = qMax(msecs, 0);
+}
+
+void BaseChannelRoomListType::flushRooms()
+{
+    if (mPriv->gotRoomsTimer) {
+        mPriv->gotRoomsTimer->stop();
+    }
+
+    if (mPriv->pendingRooms.isEmpty()) {
+        return;
+    }
+
+    Tp::RoomInfoList rooms;
+    rooms.swap(mPriv->pendingRooms);
+    mPriv->emitGotRooms(rooms);
 }
 
 //Chan.T.ServerAuthentication
@@ -1813,7 +2245,7 @@ BaseChannelServerAuthenticationType::~BaseChannelServerAuthenticationType()
 QVariantMap BaseChannelServerAuthenticationType::immutableProperties() const
 {
     QVariantMap map;
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_SERVER_AUTHENTICATION + QLatin1String(".AuthenticationMethod"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_SERVER_AUTHENTICATION_AUTHENTICATION_METHOD,
                QVariant::fromValue(mPriv->adaptee->authenticationMethod()));
     return map;
 }
@@ -1961,7 +2393,7 @@ BaseChannelCaptchaAuthenticationInterface::~BaseChannelCaptchaAuthenticationInte
 QVariantMap BaseChannelCaptchaAuthenticationInterface::immutableProperties() const
 {
     QVariantMap map;
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_CAPTCHA_AUTHENTICATION + QLatin1String(".CanRetryCaptcha"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_CAPTCHA_AUTHENTICATION_CAN_RETRY_CAPTCHA,
                QVariant::fromValue(mPriv->adaptee->canRetryCaptcha()));
     return map;
 }
@@ -2218,19 +2650,19 @@ BaseChannelSASLAuthenticationInterface::~BaseChannelSASLAuthenticationInterface(
 QVariantMap BaseChannelSASLAuthenticationInterface::immutableProperties() const
 {
     QVariantMap map;
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_SASL_AUTHENTICATION + QLatin1String(".AvailableMechanisms"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_SASL_AUTHENTICATION_AVAILABLE_MECHANISMS,
                QVariant::fromValue(mPriv->adaptee->availableMechanisms()));
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_SASL_AUTHENTICATION + QLatin1String(".HasInitialData"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_SASL_AUTHENTICATION_HAS_INITIAL_DATA,
                QVariant::fromValue(mPriv->adaptee->hasInitialData()));
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_SASL_AUTHENTICATION + QLatin1String(".CanTryAgain"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_SASL_AUTHENTICATION_CAN_TRY_AGAIN,
                QVariant::fromValue(mPriv->adaptee->canTryAgain()));
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_SASL_AUTHENTICATION + QLatin1String(".AuthorizationIdentity"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_SASL_AUTHENTICATION_AUTHORIZATION_IDENTITY,
                QVariant::fromValue(mPriv->adaptee->authorizationIdentity()));
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_SASL_AUTHENTICATION + QLatin1String(".DefaultUsername"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_SASL_AUTHENTICATION_DEFAULT_USERNAME,
                QVariant::fromValue(mPriv->adaptee->defaultUsername()));
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_SASL_AUTHENTICATION + QLatin1String(".DefaultRealm"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_SASL_AUTHENTICATION_DEFAULT_REALM,
                QVariant::fromValue(mPriv->adaptee->defaultRealm()));
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_SASL_AUTHENTICATION + QLatin1String(".MaySaveResponse"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_SASL_AUTHENTICATION_MAY_SAVE_RESPONSE,
                QVariant::fromValue(mPriv->adaptee->maySaveResponse()));
     return map;
 }
@@ -3418,15 +3850,15 @@ BaseChannelRoomInterface::~BaseChannelRoomInterface()
 QVariantMap BaseChannelRoomInterface::immutableProperties() const
 {
     QVariantMap map;
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_ROOM + QLatin1String(".RoomName"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_ROOM_ROOM_NAME,
                QVariant::fromValue(mPriv->adaptee->roomName()));
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_ROOM + QLatin1String(".Server"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_ROOM_SERVER,
                QVariant::fromValue(mPriv->adaptee->server()));
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_ROOM + QLatin1String(".Creator"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_ROOM_CREATOR,
                QVariant::fromValue(mPriv->adaptee->creator()));
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_ROOM + QLatin1String(".CreatorHandle"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_ROOM_CREATOR_HANDLE,
                QVariant::fromValue(mPriv->adaptee->creatorHandle()));
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_ROOM + QLatin1String(".CreationTimestamp"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_ROOM_CREATION_TIMESTAMP,
                QVariant::fromValue(mPriv->adaptee->creationTimestamp()));
     return map;
 }
@@ -4024,19 +4456,19 @@ QVariantMap BaseChannelCallType::immutableProperties() const
 {
     QVariantMap map;
 
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_CALL + QLatin1String(".HardwareStreaming"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_CALL_HARDWARE_STREAMING,
                QVariant::fromValue(mPriv->adaptee->hardwareStreaming()));
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_CALL + QLatin1String(".InitialTransport"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_CALL_INITIAL_TRANSPORT,
                QVariant::fromValue(mPriv->adaptee->initialTransport()));
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_CALL + QLatin1String(".InitialAudio"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_CALL_INITIAL_AUDIO,
                QVariant::fromValue(mPriv->adaptee->initialAudio()));
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_CALL + QLatin1String(".InitialVideo"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_CALL_INITIAL_VIDEO,
                QVariant::fromValue(mPriv->adaptee->initialVideo()));
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_CALL + QLatin1String(".InitialAudioName"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_CALL_INITIAL_AUDIO_NAME,
                QVariant::fromValue(mPriv->adaptee->initialAudioName()));
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_CALL + QLatin1String(".InitialVideoName"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_CALL_INITIAL_VIDEO_NAME,
                QVariant::fromValue(mPriv->adaptee->initialVideoName()));
-    map.insert(TP_QT_IFACE_CHANNEL_TYPE_CALL + QLatin1String(".MutableContents"),
+    map.insert(TP_QT_PROP_CHANNEL_TYPE_CALL_MUTABLE_CONTENTS,
                QVariant::fromValue(mPriv->adaptee->mutableContents()));
     return map;
 }
@@ -4489,13 +4921,13 @@ BaseChannelConferenceInterface::~BaseChannelConferenceInterface()
 QVariantMap BaseChannelConferenceInterface::immutableProperties() const
 {
     QVariantMap map;
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_CONFERENCE + QLatin1String(".InitialChannels"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_CONFERENCE_INITIAL_CHANNELS,
                QVariant::fromValue(initialChannels()));
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_CONFERENCE + QLatin1String(".InitialInviteeHandles"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_CONFERENCE_INITIAL_INVITEE_HANDLES,
                QVariant::fromValue(initialInviteeHandles()));
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_CONFERENCE + QLatin1String(".InitialInviteeIDs"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_CONFERENCE_INITIAL_INVITEE_IDS,
                QVariant::fromValue(initialInviteeIDs()));
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_CONFERENCE + QLatin1String(".InvitationMessage"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_CONFERENCE_INVITATION_MESSAGE,
                QVariant::fromValue(invitationMessage()));
     return map;
 }
@@ -4600,7 +5032,7 @@ bool BaseChannelSMSInterface::smsChannel() const
 QVariantMap BaseChannelSMSInterface::immutableProperties() const
 {
     QVariantMap map;
-    map.insert(TP_QT_IFACE_CHANNEL_INTERFACE_SMS + QLatin1String(".Flash"),
+    map.insert(TP_QT_PROP_CHANNEL_INTERFACE_SMS_FLASH,
                QVariant::fromValue(mPriv->adaptee->flash()));
     return map;
 }
@@ -258,6 +258,11 @@ public:
     void setTransferredBytes(qulonglong count);
     qulonglong initialOffset() const;
 
+    int transferredBytesChangedInterval() const;
+    void setTransferredBytesChangedInterval(int msecs);
+    qulonglong transferredBytesChangedThreshold() const;
+    void setTransferredBytesChangedThreshold(qulonglong bytes);
+
     QString uri() const;
 
     QString fileCollection() const;
@@ -284,6 +289,8 @@ private Q_SLOTS:
     TP_QT_NO_EXPORT void onSocketConnection();
     TP_QT_NO_EXPORT void doTransfer();
     TP_QT_NO_EXPORT void onBytesWritten(qint64 count);
+    TP_QT_NO_EXPORT void onOutputBytesWritten();
+    TP_QT_NO_EXPORT void onTransferredBytesChangedTimeout();
 
 private:
     TP_QT_NO_EXPORT void setUri(const QString &uri);
@@ -334,9 +341,20 @@ public:
 
     void gotRooms(const Tp::RoomInfoList &rooms);
 
+    void appendRooms(const Tp::RoomInfoList &rooms);
+    void finishRooms();
+
+    int gotRoomsChunkSize() const;
+    void setGotRoomsChunkSize(int size);
+    int gotRoomsInterval() const;
+    void setGotRoomsInterval(int msecs);
+
 protected:
     BaseChannelRoomListType(const QString &server);
 
+private Q_SLOTS:
+    TP_QT_NO_EXPORT void flushRooms();
+
 private:
     void createAdaptor() override;
 
@@ -33,6 +33,7 @@
 #include <TelepathyQt/Utils>
 #include <TelepathyQt/AbstractProtocolInterface>
 #include <QString>
+#include <QTimer>
 #include <QVariantMap>
 
 namespace Tp
@@ -46,6 +47,7 @@ struct TP_QT_NO_EXPORT BaseConnection::Private {
           cmName(cmName),
           protocolName(protocolName),
           parameters(parameters),
+          channelsDetailsValid(true),
           selfHandle(0),
           status(Tp::ConnectionStatusDisconnected),
           adaptee(new BaseConnection::Adaptee(dbusConnection, connection))
@@ -58,6 +60,10 @@ struct TP_QT_NO_EXPORT BaseConnection::Private {
     QVariantMap parameters;
     QHash<QString, AbstractConnectionInterfacePtr> interfaces;
     QSet<BaseChannelPtr> channels;
+    // Details of the channels above, kept up to date as channels are added and closed. Not valid
+    // while a channel which isn't registered yet is open, as its details can still change.
+    Tp::ChannelDetailsList channelsDetails;
+    bool channelsDetailsValid;
     uint selfHandle;
     QString selfID;
     uint status;
@@ -65,6 +71,7 @@ struct TP_QT_NO_EXPORT BaseConnection::Private {
     ConnectCallback connectCB;
     InspectHandlesCallback inspectHandlesCB;
     RequestHandlesCallback requestHandlesCB;
+    QHash<uint, BaseHandleRepositoryPtr> handleRepositories;
     BaseConnection::Adaptee *adaptee;
 };
 
@@ -196,9 +203,9 @@ void BaseConnection::Adaptee::requestChannel(const QString &type, uint handleTyp
     DBusError error;
 
     QVariantMap request;
-    request[TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType")] = type;
-    request[TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandleType")] = handleType;
-    request[TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandle")] = handle;
+    request[TP_QT_PROP_CHANNEL_CHANNEL_TYPE] = type;
+    request[TP_QT_PROP_CHANNEL_TARGET_HANDLE_TYPE] = handleType;
+    request[TP_QT_PROP_CHANNEL_TARGET_HANDLE] = handle;
 
     bool yours;
     BaseChannelPtr channel = mConnection->ensureChannel(request, yours, suppressHandler, &error);
@@ -381,18 +388,18 @@ Tp::BaseChannelPtr BaseConnection::createChannel(const QVariantMap &request, boo
         error->set(TP_QT_ERROR_NOT_IMPLEMENTED, QLatin1String("Not implemented"));
         return BaseChannelPtr();
     }
-    if (!mPriv->inspectHandlesCB.isValid()) {
+    if (!mPriv->inspectHandlesCB.isValid() && mPriv->handleRepositories.isEmpty()) {
         error->set(TP_QT_ERROR_NOT_IMPLEMENTED, QLatin1String("Not implemented"));
         return BaseChannelPtr();
     }
 
-    if (request.contains(TP_QT_IFACE_CHANNEL + QLatin1String(".Requested"))) {
+    if (request.contains(TP_QT_PROP_CHANNEL_REQUESTED)) {
         error->set(TP_QT_ERROR_INVALID_ARGUMENT, QString(QLatin1String("The %1.Requested property must not be presented in the request details.")).arg(TP_QT_IFACE_CHANNEL));
         return BaseChannelPtr();
     }
 
     QVariantMap requestDetails = request;
-    requestDetails[TP_QT_IFACE_CHANNEL + QLatin1String(".Requested")] = suppressHandler;
+    requestDetails[TP_QT_PROP_CHANNEL_REQUESTED] = suppressHandler;
 
     BaseChannelPtr channel = mPriv->createChannelCB(requestDetails, error);
     if (error->isValid())
@@ -400,7 +407,7 @@ Tp::BaseChannelPtr BaseConnection::createChannel(const QVariantMap &request, boo
 
     QString targetID = channel->targetID();
     if ((channel->targetHandle() != 0) && targetID.isEmpty()) {
-        QStringList list = mPriv->inspectHandlesCB(channel->targetHandleType(),  UIntList() << channel->targetHandle(), error);
+        QStringList list = inspectHandles(channel->targetHandleType(),  UIntList() << channel->targetHandle(), error);
         if (error->isValid()) {
             debug() << "BaseConnection::createChannel: could not resolve handle " << channel->targetHandle();
             return BaseChannelPtr();
@@ -411,13 +418,13 @@ Tp::BaseChannelPtr BaseConnection::createChannel(const QVariantMap &request, boo
         channel->setTargetID(targetID);
     }
 
-    if (request.contains(TP_QT_IFACE_CHANNEL + QLatin1String(".InitiatorHandle"))) {
-        channel->setInitiatorHandle(request.value(TP_QT_IFACE_CHANNEL + QLatin1String(".InitiatorHandle")).toUInt());
+    if (request.contains(TP_QT_PROP_CHANNEL_INITIATOR_HANDLE)) {
+        channel->setInitiatorHandle(request.value(TP_QT_PROP_CHANNEL_INITIATOR_HANDLE).toUInt());
     }
 
     QString initiatorID = channel->initiatorID();
     if ((channel->initiatorHandle() != 0) && initiatorID.isEmpty()) {
-        QStringList list = mPriv->inspectHandlesCB(HandleTypeContact, UIntList() << channel->initiatorHandle(), error);
+        QStringList list = inspectHandles(HandleTypeContact, UIntList() << channel->initiatorHandle(), error);
         if (error->isValid()) {
             debug() << "BaseConnection::createChannel: could not resolve handle " << channel->initiatorHandle();
             return BaseChannelPtr();
@@ -450,6 +457,11 @@ void BaseConnection::setInspectHandlesCallback(const InspectHandlesCallback &cb)
 
 QStringList BaseConnection::inspectHandles(uint handleType, const Tp::UIntList &handles, DBusError *error)
 {
+    BaseHandleRepositoryPtr repository = mPriv->handleRepositories.value(handleType);
+    if (repository) {
+        return repository->identifiers(handles, error);
+    }
+
     if (!mPriv->inspectHandlesCB.isValid()) {
         error->set(TP_QT_ERROR_NOT_IMPLEMENTED, QLatin1String("Not implemented"));
         return QStringList();
@@ -464,6 +476,11 @@ void BaseConnection::setRequestHandlesCallback(const RequestHandlesCallback &cb)
 
 Tp::UIntList BaseConnection::requestHandles(uint handleType, const QStringList &identifiers, DBusError *error)
 {
+    BaseHandleRepositoryPtr repository = mPriv->handleRepositories.value(handleType);
+    if (repository) {
+        return repository->ensureHandles(identifiers, error);
+    }
+
     if (!mPriv->requestHandlesCB.isValid()) {
         error->set(TP_QT_ERROR_NOT_IMPLEMENTED, QLatin1String("Not implemented"));
         return Tp::UIntList();
@@ -471,6 +488,40 @@ Tp::UIntList BaseConnection::requestHandles(uint handleType, const QStringList &
     return mPriv->requestHandlesCB(handleType, identifiers, error);
 }
 
+/**
+ * Use \a repository to map identifiers to handles of its handle type.
+ *
+ * Once set, requestHandles() and inspectHandles() for that handle type are answered from
+ * \a repository instead of the callbacks set with setRequestHandlesCallback() and
+ * setInspectHandlesCallback(). A repository for HandleTypeContact is also used to resolve
+ * identifiers in BaseConnectionContactsInterface::getContactByID().
+ *
+ * Setting a new repository for the same handle type replaces the previous one.
+ *
+ * \param repository The handle repository.
+ * \sa handleRepository()
+ */
+void BaseConnection::setHandleRepository(const BaseHandleRepositoryPtr &repository)
+{
+    if (!repository) {
+        return;
+    }
+
+    mPriv->handleRepositories.insert(repository->handleType(), repository);
+}
+
+/**
+ * Return the handle repository set for \a handleType.
+ *
+ * \param handleType The handle type, as defined in #HandleType.
+ * \return A pointer to the repository, or a null pointer if none has been set.
+ * \sa setHandleRepository()
+ */
+BaseHandleRepositoryPtr BaseConnection::handleRepository(uint handleType) const
+{
+    return mPriv->handleRepositories.value(handleType);
+}
+
 Tp::ChannelInfoList BaseConnection::channelsInfo()
 {
     debug() << "BaseConnection::channelsInfo:";
@@ -487,12 +538,29 @@ Tp::ChannelInfoList BaseConnection::channelsInfo()
     return list;
 }
 
+/**
+ * Return the details of all channels of this connection.
+ *
+ * The details are captured when each channel is added with addChannel() and dropped when
+ * the channel closes, so this doesn't query the channels. Channels that were added before being
+ * registered are queried until all of them have been registered.
+ *
+ * \return The object paths and immutable properties of the channels.
+ */
 Tp::ChannelDetailsList BaseConnection::channelsDetails()
 {
-    Tp::ChannelDetailsList list;
-    foreach(const BaseChannelPtr & c, mPriv->channels)
-    list << c->details();
-    return list;
+    if (!mPriv->channelsDetailsValid) {
+        Tp::ChannelDetailsList list;
+        bool allRegistered = true;
+        foreach (const BaseChannelPtr &c, mPriv->channels) {
+            list << c->details();
+            allRegistered = allRegistered && c->isRegistered();
+        }
+        mPriv->channelsDetails = list;
+        mPriv->channelsDetailsValid = allRegistered;
+    }
+
+    return mPriv->channelsDetails;
 }
 
 /**
@@ -511,12 +579,12 @@ Tp::ChannelDetailsList BaseConnection::channelsDetails()
  */
 Tp::BaseChannelPtr BaseConnection::getExistingChannel(const QVariantMap &request, DBusError *error)
 {
-    if (!request.contains(TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType"))) {
+    if (!request.contains(TP_QT_PROP_CHANNEL_CHANNEL_TYPE)) {
         error->set(TP_QT_ERROR_INVALID_ARGUMENT, QLatin1String("Missing parameters"));
         return Tp::BaseChannelPtr();
     }
 
-    const QString channelType = request.value(TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType")).toString();
+    const QString channelType = request.value(TP_QT_PROP_CHANNEL_CHANNEL_TYPE).toString();
 
     foreach(const BaseChannelPtr &channel, mPriv->channels) {
         if (channel->channelType() != channelType) {
@@ -556,7 +624,7 @@ Tp::BaseChannelPtr BaseConnection::getExistingChannel(const QVariantMap &request
  */
 Tp::BaseChannelPtr BaseConnection::ensureChannel(const QVariantMap &request, bool &yours, bool suppressHandler, DBusError *error)
 {
-    if (!request.contains(TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType"))) {
+    if (!request.contains(TP_QT_PROP_CHANNEL_CHANNEL_TYPE)) {
         error->set(TP_QT_ERROR_INVALID_ARGUMENT, QLatin1String("Missing parameters"));
         return Tp::BaseChannelPtr();
     }
@@ -578,7 +646,17 @@ void BaseConnection::addChannel(BaseChannelPtr channel, bool suppressHandler)
         return;
     }
 
+    if (!channel->isRegistered()) {
+        warning() << "BaseConnection::addChannel: Channel should be registered before it is added,"
+            << "its object path isn't known yet";
+        mPriv->channelsDetailsValid = false;
+    }
+
+    Tp::ChannelDetails details = channel->details();
     mPriv->channels.insert(channel);
+    if (mPriv->channelsDetailsValid) {
+        mPriv->channelsDetails.append(details);
+    }
 
     BaseConnectionRequestsInterfacePtr reqIface =
         BaseConnectionRequestsInterfacePtr::dynamicCast(interface(TP_QT_IFACE_CONNECTION_INTERFACE_REQUESTS));
@@ -587,7 +665,7 @@ void BaseConnection::addChannel(BaseChannelPtr channel, bool suppressHandler)
         //emit after return
         QMetaObject::invokeMethod(reqIface.data(), "newChannels",
                                   Qt::QueuedConnection,
-                                  Q_ARG(Tp::ChannelDetailsList, ChannelDetailsList() << channel->details()));
+                                  Q_ARG(Tp::ChannelDetailsList, ChannelDetailsList() << details));
     }
 
     //emit after return
@@ -611,11 +689,22 @@ void BaseConnection::removeChannel()
     Q_ASSERT(channel);
     Q_ASSERT(mPriv->channels.contains(channel));
 
+    // Only registered channels are in a valid list, so their object paths identify them
+    const QDBusObjectPath objectPath(channel->objectPath());
+    if (mPriv->channelsDetailsValid) {
+        for (int i = 0; i < mPriv->channelsDetails.size(); ++i) {
+            if (mPriv->channelsDetails.at(i).channel == objectPath) {
+                mPriv->channelsDetails.removeAt(i);
+                break;
+            }
+        }
+    }
+
     BaseConnectionRequestsInterfacePtr reqIface =
         BaseConnectionRequestsInterfacePtr::dynamicCast(interface(TP_QT_IFACE_CONNECTION_INTERFACE_REQUESTS));
 
     if (!reqIface.isNull()) {
-        reqIface->channelClosed(QDBusObjectPath(channel->objectPath()));
+        reqIface->channelClosed(objectPath);
     }
 
     mPriv->channels.remove(channel);
@@ -782,16 +871,16 @@ bool BaseConnection::matchChannel(const BaseChannelPtr &channel, const QVariantM
 {
     Q_UNUSED(error);
 
-    if (request.contains(TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandleType"))) {
-        uint targetHandleType = request.value(TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandleType")).toUInt();
+    if (request.contains(TP_QT_PROP_CHANNEL_TARGET_HANDLE_TYPE)) {
+        uint targetHandleType = request.value(TP_QT_PROP_CHANNEL_TARGET_HANDLE_TYPE).toUInt();
         if (channel->targetHandleType() != targetHandleType) {
             return false;
         }
-        if (request.contains(TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandle"))) {
-            uint targetHandle = request.value(TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandle")).toUInt();
+        if (request.contains(TP_QT_PROP_CHANNEL_TARGET_HANDLE)) {
+            uint targetHandle = request.value(TP_QT_PROP_CHANNEL_TARGET_HANDLE).toUInt();
             return channel->targetHandle() == targetHandle;
-        } else  if (request.contains(TP_QT_IFACE_CHANNEL + QLatin1String(".TargetID"))) {
-            const QString targetID = request.value(TP_QT_IFACE_CHANNEL + QLatin1String(".TargetID")).toString();
+        } else  if (request.contains(TP_QT_PROP_CHANNEL_TARGET_ID)) {
+            const QString targetID = request.value(TP_QT_PROP_CHANNEL_TARGET_ID).toString();
             return channel->targetID() == targetID;
         } else {
             // Request is not valid
@@ -817,13 +906,21 @@ bool BaseConnection::matchChannel(const BaseChannelPtr &channel, const QVariantM
  * \brief Base class for all the Connection object interface implementations.
  */
 
+struct TP_QT_NO_EXPORT AbstractConnectionInterface::Private {
+    BuildContactAttributesCallback buildContactAttributesCB;
+    // Attributes built so far, keyed by contact; contacts without attributes map to an empty map
+    QHash<uint, QVariantMap> contactAttributes;
+};
+
 AbstractConnectionInterface::AbstractConnectionInterface(const QString &interfaceName)
-    : AbstractDBusServiceInterface(interfaceName)
+    : AbstractDBusServiceInterface(interfaceName),
+      mPriv(new Private)
 {
 }
 
 AbstractConnectionInterface::~AbstractConnectionInterface()
 {
+    delete mPriv;
 }
 
 void AbstractConnectionInterface::setBaseConnection(BaseConnection *connection)
@@ -831,6 +928,112 @@ void AbstractConnectionInterface::setBaseConnection(BaseConnection *connection)
     Q_UNUSED(connection)
 }
 
+/**
+ * Return whether this interface provides the contact attributes for its interface name to
+ * BaseConnectionContactsInterface.
+ *
+ * Interfaces which do, answer contactAttributes() from a per-contact cache filled by the
+ * callback set with setBuildContactAttributesCallback(), and
+ * BaseConnectionContactsInterface::getContactAttributes() doesn't ask its
+ * GetContactAttributesCallback for their attributes.
+ *
+ * \return \c true if this interface provides contact attributes, \c false otherwise.
+ * \sa contactAttributes(), setBuildContactAttributesCallback()
+ */
+bool AbstractConnectionInterface::providesContactAttributes() const
+{
+    return mPriv->buildContactAttributesCB.isValid();
+}
+
+/**
+ * Return the contact attributes of this interface for \a contacts.
+ *
+ * Attributes are built with the callback set by setBuildContactAttributesCallback() on first
+ * use and cached until invalidateContactAttributes() is called for the contact.
+ *
+ * \param contacts The contacts to get attributes for.
+ * \param error A pointer to an empty DBusError where any possible error will be stored.
+ * \return The attributes, keyed by contact. Contacts without attributes may be omitted.
+ * \sa providesContactAttributes()
+ */
+Tp::ContactAttributesMap AbstractConnectionInterface::contactAttributes(const Tp::UIntList &contacts, DBusError *error)
+{
+    if (!mPriv->buildContactAttributesCB.isValid()) {
+        return Tp::ContactAttributesMap();
+    }
+
+    Tp::UIntList missing;
+    foreach (uint contact, contacts) {
+        if (!mPriv->contactAttributes.contains(contact)) {
+            missing.append(contact);
+        }
+    }
+
+    if (!missing.isEmpty()) {
+        const Tp::ContactAttributesMap built = mPriv->buildContactAttributesCB(missing, error);
+        if (error->isValid()) {
+            return Tp::ContactAttributesMap();
+        }
+
+        // Keep everything we were given, builders may return more contacts than asked for
+        for (Tp::ContactAttributesMap::const_iterator i = built.constBegin(); i != built.constEnd(); ++i) {
+            mPriv->contactAttributes.insert(i.key(), i.value());
+        }
+        foreach (uint contact, missing) {
+            if (!built.contains(contact)) {
+                mPriv->contactAttributes.insert(contact, QVariantMap());
+            }
+        }
+    }
+
+    Tp::ContactAttributesMap result;
+    foreach (uint contact, contacts) {
+        const QVariantMap &attributes = mPriv->contactAttributes[contact];
+        if (!attributes.isEmpty()) {
+            result.insert(contact, attributes);
+        }
+    }
+    return result;
+}
+
+/**
+ * Drop all the contact attributes cached by contactAttributes().
+ *
+ * \sa invalidateContactAttributes(const Tp::UIntList &)
+ */
+void AbstractConnectionInterface::invalidateContactAttributes()
+{
+    mPriv->contactAttributes.clear();
+}
+
+/**
+ * Drop the contact attributes cached by contactAttributes() for \a contacts.
+ *
+ * Interfaces call this whenever the data behind their attributes changes for some contacts.
+ *
+ * \param contacts The contacts whose attributes changed.
+ */
+void AbstractConnectionInterface::invalidateContactAttributes(const Tp::UIntList &contacts)
+{
+    foreach (uint contact, contacts) {
+        mPriv->contactAttributes.remove(contact);
+    }
+}
+
+/**
+ * Set the callback used to build the contact attributes of this interface.
+ *
+ * Interfaces set this when they have the data their attributes are made of, which makes
+ * providesContactAttributes() return \c true. Setting the callback drops all cached attributes.
+ *
+ * \param cb The callback, or an invalid callback to stop providing contact attributes.
+ */
+void AbstractConnectionInterface::setBuildContactAttributesCallback(const BuildContactAttributesCallback &cb)
+{
+    mPriv->buildContactAttributesCB = cb;
+    invalidateContactAttributes();
+}
+
 // Conn.I.Requests
 BaseConnectionRequestsInterface::Adaptee::Adaptee(BaseConnectionRequestsInterface *interface)
     : QObject(interface),
@@ -917,7 +1120,7 @@ BaseConnectionRequestsInterface::~BaseConnectionRequestsInterface()
 QVariantMap BaseConnectionRequestsInterface::immutableProperties() const
 {
     QVariantMap map;
-    map.insert(TP_QT_IFACE_CONNECTION_INTERFACE_REQUESTS + QLatin1String(".RequestableChannelClasses"),
+    map.insert(TP_QT_PROP_CONNECTION_INTERFACE_REQUESTS_REQUESTABLE_CHANNEL_CLASSES,
                QVariant::fromValue(mPriv->adaptee->requestableChannelClasses()));
     return map;
 }
@@ -959,7 +1162,7 @@ void BaseConnectionRequestsInterface::createChannel(const QVariantMap &request,
         QDBusObjectPath &objectPath,
         QVariantMap &details, DBusError *error)
 {
-    if (!request.contains(TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType"))) {
+    if (!request.contains(TP_QT_PROP_CHANNEL_CHANNEL_TYPE)) {
         error->set(TP_QT_ERROR_INVALID_ARGUMENT, QLatin1String("Missing parameters"));
         return;
     }
@@ -1072,7 +1275,7 @@ void BaseConnectionContactsInterface::setBaseConnection(BaseConnection *connecti
 QVariantMap BaseConnectionContactsInterface::immutableProperties() const
 {
     QVariantMap map;
-    map.insert(TP_QT_IFACE_CONNECTION_INTERFACE_CONTACTS + QLatin1String(".ContactAttributeInterfaces"),
+    map.insert(TP_QT_PROP_CONNECTION_INTERFACE_CONTACTS_CONTACT_ATTRIBUTE_INTERFACES,
                QVariant::fromValue(mPriv->adaptee->contactAttributeInterfaces()));
     return map;
 }
@@ -1098,18 +1301,93 @@ void BaseConnectionContactsInterface::setGetContactAttributesCallback(const GetC
     mPriv->getContactAttributesCB = cb;
 }
 
+/**
+ * Return the attributes of \a handles for \a interfaces.
+ *
+ * The attributes of plugged connection interfaces which provide contact attributes (see
+ * AbstractConnectionInterface::providesContactAttributes()) come from their caches. The callback
+ * set with setGetContactAttributesCallback() is only passed the rest of \a interfaces, and the
+ * contacts it returns are the ones the provided attributes are added to.
+ *
+ * Without a callback, contact identifiers are resolved with BaseConnection::inspectHandles() and
+ * all the other attributes have to come from providers.
+ *
+ * \param handles The contacts to get attributes for.
+ * \param interfaces The interfaces to get attributes of.
+ * \param error A pointer to an empty DBusError where any possible error will be stored.
+ * \return The attributes, keyed by contact.
+ */
 Tp::ContactAttributesMap BaseConnectionContactsInterface::getContactAttributes(const Tp::UIntList &handles, const QStringList &interfaces, DBusError *error)
 {
-    if (!mPriv->getContactAttributesCB.isValid()) {
+    QList<AbstractConnectionInterfacePtr> providers;
+    QStringList callbackInterfaces;
+    bool allProvided = true;
+    foreach (const QString &interface, interfaces) {
+        AbstractConnectionInterfacePtr provider;
+        if (mPriv->connection) {
+            provider = mPriv->connection->interface(interface);
+        }
+
+        if (provider && provider->providesContactAttributes()) {
+            if (!providers.contains(provider)) {
+                providers.append(provider);
+            }
+        } else {
+            callbackInterfaces.append(interface);
+            if (interface != TP_QT_IFACE_CONNECTION) {
+                allProvided = false;
+            }
+        }
+    }
+
+    Tp::ContactAttributesMap result;
+    if (mPriv->getContactAttributesCB.isValid()) {
+        result = mPriv->getContactAttributesCB(handles, callbackInterfaces, error);
+    } else if (mPriv->connection && allProvided) {
+        const QStringList identifiers = mPriv->connection->inspectHandles(Tp::HandleTypeContact, handles, error);
+        for (int i = 0; i < identifiers.size(); ++i) {
+            result[handles[i]].insert(TP_QT_TOKEN_CONNECTION_CONTACT_ID, identifiers[i]);
+        }
+    } else {
         error->set(TP_QT_ERROR_NOT_IMPLEMENTED, QLatin1String("Not implemented"));
+    }
+
+    if (error->isValid()) {
         return Tp::ContactAttributesMap();
     }
-    return mPriv->getContactAttributesCB(handles, interfaces, error);
+
+    // Only ask for the contacts the callback considered valid
+    const Tp::UIntList validHandles = result.keys();
+    foreach (const AbstractConnectionInterfacePtr &provider, providers) {
+        const Tp::ContactAttributesMap attributes = provider->contactAttributes(validHandles, error);
+        if (error->isValid()) {
+            return Tp::ContactAttributesMap();
+        }
+
+        for (Tp::ContactAttributesMap::iterator i = result.begin(); i != result.end(); ++i) {
+            const QVariantMap contactAttributes = attributes.value(i.key());
+            for (QVariantMap::const_iterator j = contactAttributes.constBegin(); j != contactAttributes.constEnd(); ++j) {
+                i.value().insert(j.key(), j.value());
+            }
+        }
+    }
+
+    return result;
 }
 
 void BaseConnectionContactsInterface::getContactByID(const QString &identifier, const QStringList &interfaces, uint &handle, QVariantMap &attributes, DBusError *error)
 {
-    const Tp::UIntList handles = mPriv->connection->requestHandles(Tp::HandleTypeContact, QStringList() << identifier, error);
+    Tp::UIntList handles;
+    BaseHandleRepositoryPtr repository = mPriv->connection->handleRepository(Tp::HandleTypeContact);
+    if (repository) {
+        uint contactHandle = repository->ensureHandle(identifier, error);
+        if (!error->isValid()) {
+            handles << contactHandle;
+        }
+    } else {
+        handles = mPriv->connection->requestHandles(Tp::HandleTypeContact, QStringList() << identifier, error);
+    }
+
     if (error->isValid() || handles.isEmpty()) {
         // The check for empty handles is paranoid, because the error must be set in such case.
         error->set(TP_QT_ERROR_INVALID_HANDLE, QLatin1String("Could not process ID"));
@@ -1139,17 +1417,94 @@ BaseConnectionSimplePresenceInterface::Adaptee::~Adaptee()
 
 struct TP_QT_NO_EXPORT BaseConnectionSimplePresenceInterface::Private {
     Private(BaseConnectionSimplePresenceInterface *parent)
-        : maximumStatusMessageLength(0),
+        : parent(parent),
+          maximumStatusMessageLength(0),
+          presencesChangedBatchSize(0),
+          presencesChangedLatency(0),
+          presencesChangedTimer(nullptr),
           adaptee(new BaseConnectionSimplePresenceInterface::Adaptee(parent)) {
     }
+
+    void presencesChanged(const SimpleContactPresences &changes, bool queued);
+    void flushPresencesChanged(bool queued);
+    void emitPresencesChanged(const SimpleContactPresences &changes, bool queued);
+
+    BaseConnectionSimplePresenceInterface *parent;
     SetPresenceCallback setPresenceCB;
     SimpleStatusSpecMap statuses;
     uint maximumStatusMessageLength;
     /* The current presences */
     SimpleContactPresences presences;
+    /* Changes not signalled yet, see setPresencesChangedLatency() */
+    SimpleContactPresences pendingPresencesChanged;
+    int presencesChangedBatchSize;
+    int presencesChangedLatency;
+    QTimer *presencesChangedTimer;
     BaseConnectionSimplePresenceInterface::Adaptee *adaptee;
 };
 
+void BaseConnectionSimplePresenceInterface::Private::presencesChanged(const SimpleContactPresences &changes,
+        bool queued)
+{
+    if (presencesChangedLatency <= 0) {
+        emitPresencesChanged(changes, queued);
+        return;
+    }
+
+    // Later changes to the same contact supersede the pending ones
+    for (SimpleContactPresences::const_iterator i = changes.constBegin(); i != changes.constEnd(); ++i) {
+        pendingPresencesChanged.insert(i.key(), i.value());
+    }
+
+    if (presencesChangedBatchSize > 0 && pendingPresencesChanged.size() >= presencesChangedBatchSize) {
+        flushPresencesChanged(queued);
+    } else if (!presencesChangedTimer->isActive()) {
+        presencesChangedTimer->start(presencesChangedLatency);
+    }
+}
+
+void BaseConnectionSimplePresenceInterface::Private::flushPresencesChanged(bool queued)
+{
+    if (presencesChangedTimer) {
+        presencesChangedTimer->stop();
+    }
+
+    if (pendingPresencesChanged.isEmpty()) {
+        return;
+    }
+
+    SimpleContactPresences changes;
+    changes.swap(pendingPresencesChanged);
+    emitPresencesChanged(changes, queued);
+}
+
+void BaseConnectionSimplePresenceInterface::Private::emitPresencesChanged(const SimpleContactPresences &changes,
+        bool queued)
+{
+    Qt::ConnectionType type = queued ? Qt::QueuedConnection : Qt::AutoConnection;
+
+    if (presencesChangedBatchSize <= 0 || changes.size() <= presencesChangedBatchSize) {
+        QMetaObject::invokeMethod(adaptee, "presencesChanged", type,
+                                  Q_ARG(Tp::SimpleContactPresences, changes)); //Can simply use emit in Qt5
+        return;
+    }
+
+    SimpleContactPresences batch;
+    for (SimpleContactPresences::const_iterator i = changes.constBegin(); i != changes.constEnd(); ++i) {
+        batch.insert(batch.constEnd(), i.key(), i.value());
+        if (batch.size() == presencesChangedBatchSize) {
+            QMetaObject::invokeMethod(adaptee, "presencesChanged", type,
+                                      Q_ARG(Tp::SimpleContactPresences, batch));
+            batch.clear();
+        }
+    }
+
+    if (!batch.isEmpty()) {
+        QMetaObject::invokeMethod(adaptee, "presencesChanged", type,
+                                  Q_ARG(Tp::SimpleContactPresences, batch));
+    }
+}
+
 /**
  * \class BaseConnectionSimplePresenceInterface
  * \ingroup serviceconn
@@ -1165,6 +1520,7 @@ BaseConnectionSimplePresenceInterface::BaseConnectionSimplePresenceInterface()
     : AbstractConnectionInterface(TP_QT_IFACE_CONNECTION_INTERFACE_SIMPLE_PRESENCE),
       mPriv(new Private(this))
 {
+    setBuildContactAttributesCallback(memFun(this, &BaseConnectionSimplePresenceInterface::buildContactAttributes));
 }
 
 /**
@@ -1186,20 +1542,109 @@ void BaseConnectionSimplePresenceInterface::createAdaptor()
 void BaseConnectionSimplePresenceInterface::setPresences(const Tp::SimpleContactPresences &presences)
 {
     Tp::SimpleContactPresences newPresences;
+    Tp::UIntList changedHandles;
 
-    foreach(uint handle, presences.keys()) {
-        if (mPriv->presences.contains(handle) && mPriv->presences.value(handle) == presences.value(handle)) {
+    for (Tp::SimpleContactPresences::const_iterator i = presences.constBegin(); i != presences.constEnd(); ++i) {
+        Tp::SimpleContactPresences::iterator current = mPriv->presences.find(i.key());
+        if (current == mPriv->presences.end()) {
+            mPriv->presences.insert(i.key(), i.value());
+        } else if (current.value() == i.value()) {
             continue;
+        } else {
+            current.value() = i.value();
         }
-        mPriv->presences[handle] = presences[handle];
-        newPresences[handle] = presences[handle];
+
+        // The input is sorted by handle, so appending at the end avoids a lookup per insertion
+        newPresences.insert(newPresences.constEnd(), i.key(), i.value());
+        changedHandles.append(i.key());
     }
 
     if (!newPresences.isEmpty()) {
-        QMetaObject::invokeMethod(mPriv->adaptee, "presencesChanged", Q_ARG(Tp::SimpleContactPresences, newPresences)); //Can simply use emit in Qt5
+        invalidateContactAttributes(changedHandles);
+        mPriv->presencesChanged(newPresences, false);
+    }
+}
+
+/**
+ * Return the maximum number of contacts signalled in a single PresencesChanged signal.
+ *
+ * \return The maximum batch size, 0 if unlimited.
+ * \sa setPresencesChangedBatchSize()
+ */
+int BaseConnectionSimplePresenceInterface::presencesChangedBatchSize() const
+{
+    return mPriv->presencesChangedBatchSize;
+}
+
+/**
+ * Set the maximum number of contacts signalled in a single PresencesChanged signal.
+ *
+ * Larger changes, for instance the presences of the whole roster received after connecting,
+ * are split into several signals.
+ *
+ * \param size The maximum batch size, or 0 for no limit, which is the default.
+ * \sa setPresencesChangedLatency()
+ */
+void BaseConnectionSimplePresenceInterface::setPresencesChangedBatchSize(int size)
+{
+    mPriv->presencesChangedBatchSize = qMax(size, 0);
+}
+
+/**
+ * Return for how long presence changes are collected before PresencesChanged is emitted.
+ *
+ * \return The latency in milliseconds, 0 if changes are signalled immediately.
+ * \sa setPresencesChangedLatency()
+ */
+int BaseConnectionSimplePresenceInterface::presencesChangedLatency() const
+{
+    return mPriv->presencesChangedLatency;
+}
+
+/**
+ * Set for how long presence changes are collected before PresencesChanged is emitted.
+ *
+ * With a non-zero latency, changes passed to setPresences() in quick succession are merged,
+ * keeping only the latest presence of each contact, and signalled together at most \a msecs
+ * later. If a batch size is set with setPresencesChangedBatchSize(), changes are signalled as
+ * soon as a full batch has been collected.
+ *
+ * \param msecs The latency in milliseconds, or 0 to signal changes immediately, which is
+ *              the default.
+ * \sa flushPresencesChanged()
+ */
+void BaseConnectionSimplePresenceInterface::setPresencesChangedLatency(int msecs)
+{
+    mPriv->presencesChangedLatency = qMax(msecs, 0);
+
+    if (mPriv->presencesChangedLatency == 0) {
+        flushPresencesChanged();
+        return;
+    }
+
+    if (!mPriv->presencesChangedTimer) {
+        mPriv->presencesChangedTimer = new QTimer(this);
+        mPriv->presencesChangedTimer->setSingleShot(true);
+        connect(mPriv->presencesChangedTimer,
+                SIGNAL(timeout()),
+                SLOT(onPresencesChangedTimeout()));
     }
 }
 
+/**
+ * Emit PresencesChanged for all the changes collected so far, without waiting for the latency
+ * set with setPresencesChangedLatency() to expire.
+ */
+void BaseConnectionSimplePresenceInterface::flushPresencesChanged()
+{
+    mPriv->flushPresencesChanged(false);
+}
+
+void BaseConnectionSimplePresenceInterface::onPresencesChangedTimeout()
+{
+    flushPresencesChanged();
+}
+
 void BaseConnectionSimplePresenceInterface::setSetPresenceCallback(const SetPresenceCallback &cb)
 {
     mPriv->setPresenceCB = cb;
@@ -1216,6 +1661,19 @@ SimpleContactPresences BaseConnectionSimplePresenceInterface::getPresences(const
     return presences;
 }
 
+Tp::ContactAttributesMap BaseConnectionSimplePresenceInterface::buildContactAttributes(const Tp::UIntList &contacts, DBusError *error)
+{
+    Q_UNUSED(error)
+
+    Tp::ContactAttributesMap attributes;
+    const Tp::SimpleContactPresences presences = getPresences(contacts);
+    for (Tp::SimpleContactPresences::const_iterator i = presences.constBegin(); i != presences.constEnd(); ++i) {
+        attributes[i.key()].insert(TP_QT_TOKEN_CONNECTION_INTERFACE_SIMPLE_PRESENCE_PRESENCE,
+                QVariant::fromValue(i.value()));
+    }
+    return attributes;
+}
+
 Tp::SimpleStatusSpecMap BaseConnectionSimplePresenceInterface::statuses() const
 {
     return mPriv->statuses;
@@ -1279,14 +1737,13 @@ void BaseConnectionSimplePresenceInterface::Adaptee::setPresence(const QString &
     presence.status = status;
     presence.statusMessage = statusMessage;
     mInterface->mPriv->presences[selfHandle] = presence;
+    mInterface->invalidateContactAttributes(Tp::UIntList() << selfHandle);
 
     /* Emit PresencesChanged */
     SimpleContactPresences presences;
     presences[selfHandle] = presence;
     //emit after return
-    QMetaObject::invokeMethod(mInterface->mPriv->adaptee, "presencesChanged",
-                              Qt::QueuedConnection,
-                              Q_ARG(Tp::SimpleContactPresences, presences));
+    mInterface->mPriv->presencesChanged(presences, true);
     context->setFinished();
 }
 
@@ -1304,6 +1761,7 @@ struct TP_QT_NO_EXPORT BaseConnectionContactListInterface::Private {
           canChangeContactList(true),
           requestUsesMessage(false),
           downloadAtConnection(false),
+          connection(nullptr),
           adaptee(new BaseConnectionContactListInterface::Adaptee(parent))
     {
     }
@@ -1320,6 +1778,7 @@ struct TP_QT_NO_EXPORT BaseConnectionContactListInterface::Private {
     UnsubscribeCallback unsubscribeCB;
     UnpublishCallback unpublishCB;
     DownloadCallback downloadCB;
+    BaseConnection *connection;
     BaseConnectionContactListInterface::Adaptee *adaptee;
 };
 
@@ -1538,6 +1997,12 @@ void BaseConnectionContactListInterface::createAdaptor()
 void BaseConnectionContactListInterface::setGetContactListAttributesCallback(const BaseConnectionContactListInterface::GetContactListAttributesCallback &cb)
 {
     mPriv->getContactListAttributesCB = cb;
+    if (cb.isValid()) {
+        setBuildContactAttributesCallback(memFun(this, &BaseConnectionContactListInterface::buildContactAttributes));
+    } else {
+        setBuildContactAttributesCallback(BuildContactAttributesCallback());
+    }
+    invalidateContactGroupsAttributes(Tp::UIntList(), true);
 }
 
 Tp::ContactAttributesMap BaseConnectionContactListInterface::getContactListAttributes(const QStringList &interfaces, bool hold, DBusError *error)
@@ -1635,15 +2100,64 @@ void BaseConnectionContactListInterface::download(DBusError *error)
 
 void BaseConnectionContactListInterface::contactsChangedWithID(const Tp::ContactSubscriptionMap &changes, const Tp::HandleIdentifierMap &identifiers, const Tp::HandleIdentifierMap &removals)
 {
+    const Tp::UIntList contacts = changes.keys() + removals.keys();
+    invalidateContactAttributes(contacts);
+    // Groups are cached from the contact list too, and removed contacts lose theirs
+    invalidateContactGroupsAttributes(contacts, false);
     QMetaObject::invokeMethod(mPriv->adaptee, "contactsChangedWithID", Q_ARG(Tp::ContactSubscriptionMap, changes), Q_ARG(Tp::HandleIdentifierMap, identifiers), Q_ARG(Tp::HandleIdentifierMap, removals)); //Can simply use emit in Qt5
 }
 
+void BaseConnectionContactListInterface::setBaseConnection(BaseConnection *connection)
+{
+    mPriv->connection = connection;
+}
+
+void BaseConnectionContactListInterface::invalidateContactGroupsAttributes(const Tp::UIntList &contacts, bool all)
+{
+    if (!mPriv->connection) {
+        return;
+    }
+
+    AbstractConnectionInterfacePtr contactGroups =
+            mPriv->connection->interface(TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_GROUPS);
+    if (!contactGroups) {
+        return;
+    }
+
+    if (all) {
+        contactGroups->invalidateContactAttributes();
+    } else {
+        contactGroups->invalidateContactAttributes(contacts);
+    }
+}
+
+Tp::ContactAttributesMap BaseConnectionContactListInterface::buildContactAttributes(const Tp::UIntList &contacts, DBusError *error)
+{
+    Q_UNUSED(contacts)
+
+    // The callback returns the whole list at once, which then stays cached
+    const QString prefix = TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_LIST + QLatin1Char('/');
+    const Tp::ContactAttributesMap list = getContactListAttributes(QStringList(), false, error);
+
+    Tp::ContactAttributesMap attributes;
+    for (Tp::ContactAttributesMap::const_iterator i = list.constBegin(); i != list.constEnd(); ++i) {
+        QVariantMap &contactAttributes = attributes[i.key()];
+        for (QVariantMap::const_iterator j = i.value().constBegin(); j != i.value().constEnd(); ++j) {
+            if (j.key().startsWith(prefix)) {
+                contactAttributes.insert(j.key(), j.value());
+            }
+        }
+    }
+    return attributes;
+}
+
 // Conn.I.ContactGroups
 // The BaseConnectionContactGroupsInterface code is fully or partially generated by the TelepathyQt-Generator.
 struct TP_QT_NO_EXPORT BaseConnectionContactGroupsInterface::Private {
     Private(BaseConnectionContactGroupsInterface *parent)
         : disjointGroups(false),
           groupStorage(Tp::ContactMetadataStorageTypeNone),
+          connection(nullptr),
           adaptee(new BaseConnectionContactGroupsInterface::Adaptee(parent))
     {
     }
@@ -1657,6 +2171,7 @@ struct TP_QT_NO_EXPORT BaseConnectionContactGroupsInterface::Private {
     RemoveFromGroupCallback removeFromGroupCB;
     RemoveGroupCallback removeGroupCB;
     RenameGroupCallback renameGroupCB;
+    BaseConnection *connection;
     BaseConnectionContactGroupsInterface::Adaptee *adaptee;
 };
 
@@ -1921,19 +2436,61 @@ void BaseConnectionContactGroupsInterface::groupsCreated(const QStringList &name
 
 void BaseConnectionContactGroupsInterface::groupRenamed(const QString &oldName, const QString &newName)
 {
+    invalidateContactAttributes();
     QMetaObject::invokeMethod(mPriv->adaptee, "groupRenamed", Q_ARG(QString, oldName), Q_ARG(QString, newName)); //Can simply use emit in Qt5
 }
 
 void BaseConnectionContactGroupsInterface::groupsRemoved(const QStringList &names)
 {
+    invalidateContactAttributes();
     QMetaObject::invokeMethod(mPriv->adaptee, "groupsRemoved", Q_ARG(QStringList, names)); //Can simply use emit in Qt5
 }
 
 void BaseConnectionContactGroupsInterface::groupsChanged(const Tp::UIntList &contact, const QStringList &added, const QStringList &removed)
 {
+    invalidateContactAttributes(contact);
     QMetaObject::invokeMethod(mPriv->adaptee, "groupsChanged", Q_ARG(Tp::UIntList, contact), Q_ARG(QStringList, added), Q_ARG(QStringList, removed)); //Can simply use emit in Qt5
 }
 
+void BaseConnectionContactGroupsInterface::setBaseConnection(BaseConnection *connection)
+{
+    mPriv->connection = connection;
+    if (connection) {
+        setBuildContactAttributesCallback(memFun(this, &BaseConnectionContactGroupsInterface::buildContactAttributes));
+    } else {
+        setBuildContactAttributesCallback(BuildContactAttributesCallback());
+    }
+}
+
+Tp::ContactAttributesMap BaseConnectionContactGroupsInterface::buildContactAttributes(const Tp::UIntList &contacts, DBusError *error)
+{
+    Q_UNUSED(contacts)
+
+    // Groups come with the contact list, so cache them for the whole list in one go
+    BaseConnectionContactListInterfacePtr contactList =
+            BaseConnectionContactListInterfacePtr::qObjectCast(
+                    mPriv->connection->interface(TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_LIST));
+    if (!contactList || !contactList->providesContactAttributes()) {
+        // Nothing to take the groups from, leave them to the GetContactAttributes callback
+        return Tp::ContactAttributesMap();
+    }
+
+    const QString key = TP_QT_TOKEN_CONNECTION_INTERFACE_CONTACT_GROUPS_GROUPS;
+    const Tp::ContactAttributesMap list = contactList->getContactListAttributes(
+            QStringList() << TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_GROUPS, false, error);
+
+    Tp::ContactAttributesMap attributes;
+    for (Tp::ContactAttributesMap::const_iterator i = list.constBegin(); i != list.constEnd(); ++i) {
+        QVariantMap::const_iterator groups = i.value().constFind(key);
+        if (groups != i.value().constEnd()) {
+            attributes[i.key()].insert(key, groups.value());
+        } else {
+            attributes.insert(i.key(), QVariantMap());
+        }
+    }
+    return attributes;
+}
+
 // Conn.I.ContactInfo
 struct TP_QT_NO_EXPORT BaseConnectionContactInfoInterface::Private {
     Private(BaseConnectionContactInfoInterface *parent)
@@ -2378,6 +2935,11 @@ QStringList BaseConnectionAliasingInterface::requestAliases(const Tp::UIntList &
 void BaseConnectionAliasingInterface::setGetAliasesCallback(const BaseConnectionAliasingInterface::GetAliasesCallback &cb)
 {
     mPriv->getAliasesCB = cb;
+    if (cb.isValid()) {
+        setBuildContactAttributesCallback(memFun(this, &BaseConnectionAliasingInterface::buildContactAttributes));
+    } else {
+        setBuildContactAttributesCallback(BuildContactAttributesCallback());
+    }
 }
 
 Tp::AliasMap BaseConnectionAliasingInterface::getAliases(const Tp::UIntList &contacts, DBusError *error)
@@ -2405,9 +2967,25 @@ void BaseConnectionAliasingInterface::setAliases(const Tp::AliasMap &aliases, DB
 
 void BaseConnectionAliasingInterface::aliasesChanged(const Tp::AliasPairList &aliases)
 {
+    Tp::UIntList contacts;
+    foreach (const Tp::AliasPair &alias, aliases) {
+        contacts.append(alias.handle);
+    }
+    invalidateContactAttributes(contacts);
+
     QMetaObject::invokeMethod(mPriv->adaptee, "aliasesChanged", Q_ARG(Tp::AliasPairList, aliases)); //Can simply use emit in Qt5
 }
 
+Tp::ContactAttributesMap BaseConnectionAliasingInterface::buildContactAttributes(const Tp::UIntList &contacts, DBusError *error)
+{
+    Tp::ContactAttributesMap attributes;
+    const Tp::AliasMap aliases = getAliases(contacts, error);
+    for (Tp::AliasMap::const_iterator i = aliases.constBegin(); i != aliases.constEnd(); ++i) {
+        attributes[i.key()].insert(TP_QT_TOKEN_CONNECTION_INTERFACE_ALIASING_ALIAS, i.value());
+    }
+    return attributes;
+}
+
 // Conn.I.Avatars
 struct TP_QT_NO_EXPORT BaseConnectionAvatarsInterface::Private {
     Private(BaseConnectionAvatarsInterface *parent)
@@ -2571,6 +3149,11 @@ void BaseConnectionAvatarsInterface::createAdaptor()
 void BaseConnectionAvatarsInterface::setGetKnownAvatarTokensCallback(const BaseConnectionAvatarsInterface::GetKnownAvatarTokensCallback &cb)
 {
     mPriv->getKnownAvatarTokensCB = cb;
+    if (cb.isValid()) {
+        setBuildContactAttributesCallback(memFun(this, &BaseConnectionAvatarsInterface::buildContactAttributes));
+    } else {
+        setBuildContactAttributesCallback(BuildContactAttributesCallback());
+    }
 }
 
 Tp::AvatarTokenMap BaseConnectionAvatarsInterface::getKnownAvatarTokens(const Tp::UIntList &contacts, DBusError *error)
@@ -2626,6 +3209,7 @@ void BaseConnectionAvatarsInterface::clearAvatar(DBusError *error)
 
 void BaseConnectionAvatarsInterface::avatarUpdated(uint contact, const QString &newAvatarToken)
 {
+    invalidateContactAttributes(Tp::UIntList() << contact);
     QMetaObject::invokeMethod(mPriv->adaptee, "avatarUpdated", Q_ARG(uint, contact), Q_ARG(QString, newAvatarToken)); //Can simply use emit in Qt5
 }
 
@@ -2634,6 +3218,16 @@ void BaseConnectionAvatarsInterface::avatarRetrieved(uint contact, const QString
     QMetaObject::invokeMethod(mPriv->adaptee, "avatarRetrieved", Q_ARG(uint, contact), Q_ARG(QString, token), Q_ARG(QByteArray, avatar), Q_ARG(QString, type)); //Can simply use emit in Qt5
 }
 
+Tp::ContactAttributesMap BaseConnectionAvatarsInterface::buildContactAttributes(const Tp::UIntList &contacts, DBusError *error)
+{
+    Tp::ContactAttributesMap attributes;
+    const Tp::AvatarTokenMap tokens = getKnownAvatarTokens(contacts, error);
+    for (Tp::AvatarTokenMap::const_iterator i = tokens.constBegin(); i != tokens.constEnd(); ++i) {
+        attributes[i.key()].insert(TP_QT_TOKEN_CONNECTION_INTERFACE_AVATARS_TOKEN, i.value());
+    }
+    return attributes;
+}
+
 // Conn.I.ClientTypes
 // The BaseConnectionClientTypesInterface code is fully or partially generated by the TelepathyQt-Generator.
 struct TP_QT_NO_EXPORT BaseConnectionClientTypesInterface::Private {
@@ -2717,6 +3311,11 @@ void BaseConnectionClientTypesInterface::createAdaptor()
 void BaseConnectionClientTypesInterface::setGetClientTypesCallback(const GetClientTypesCallback &cb)
 {
     mPriv->getClientTypesCB = cb;
+    if (cb.isValid()) {
+        setBuildContactAttributesCallback(memFun(this, &BaseConnectionClientTypesInterface::buildContactAttributes));
+    } else {
+        setBuildContactAttributesCallback(BuildContactAttributesCallback());
+    }
 }
 
 Tp::ContactClientTypes BaseConnectionClientTypesInterface::getClientTypes(const Tp::UIntList &contacts, DBusError *error)
@@ -2744,9 +3343,20 @@ QStringList BaseConnectionClientTypesInterface::requestClientTypes(uint contact,
 
 void BaseConnectionClientTypesInterface::clientTypesUpdated(uint contact, const QStringList &clientTypes)
 {
+    invalidateContactAttributes(Tp::UIntList() << contact);
     QMetaObject::invokeMethod(mPriv->adaptee, "clientTypesUpdated", Q_ARG(uint, contact), Q_ARG(QStringList, clientTypes)); //Can simply use emit in Qt5
 }
 
+Tp::ContactAttributesMap BaseConnectionClientTypesInterface::buildContactAttributes(const Tp::UIntList &contacts, DBusError *error)
+{
+    Tp::ContactAttributesMap attributes;
+    const Tp::ContactClientTypes clientTypes = getClientTypes(contacts, error);
+    for (Tp::ContactClientTypes::const_iterator i = clientTypes.constBegin(); i != clientTypes.constEnd(); ++i) {
+        attributes[i.key()].insert(TP_QT_TOKEN_CONNECTION_INTERFACE_CLIENT_TYPES_CLIENT_TYPES, i.value());
+    }
+    return attributes;
+}
+
 // Conn.I.ContactCapabilities
 // The BaseConnectionContactCapabilitiesInterface code is fully or partially generated by the TelepathyQt-Generator.
 struct TP_QT_NO_EXPORT BaseConnectionContactCapabilitiesInterface::Private {
@@ -2844,6 +3454,11 @@ void BaseConnectionContactCapabilitiesInterface::updateCapabilities(const Tp::Ha
 void BaseConnectionContactCapabilitiesInterface::setGetContactCapabilitiesCallback(const GetContactCapabilitiesCallback &cb)
 {
     mPriv->getContactCapabilitiesCB = cb;
+    if (cb.isValid()) {
+        setBuildContactAttributesCallback(memFun(this, &BaseConnectionContactCapabilitiesInterface::buildContactAttributes));
+    } else {
+        setBuildContactAttributesCallback(BuildContactAttributesCallback());
+    }
 }
 
 Tp::ContactCapabilitiesMap BaseConnectionContactCapabilitiesInterface::getContactCapabilities(const Tp::UIntList &handles, DBusError *error)
@@ -2857,7 +3472,19 @@ Tp::ContactCapabilitiesMap BaseConnectionContactCapabilitiesInterface::getContac
 
 void BaseConnectionContactCapabilitiesInterface::contactCapabilitiesChanged(const Tp::ContactCapabilitiesMap &caps)
 {
+    invalidateContactAttributes(caps.keys());
     QMetaObject::invokeMethod(mPriv->adaptee, "contactCapabilitiesChanged", Q_ARG(Tp::ContactCapabilitiesMap, caps)); //Can simply use emit in Qt5
 }
 
+Tp::ContactAttributesMap BaseConnectionContactCapabilitiesInterface::buildContactAttributes(const Tp::UIntList &contacts, DBusError *error)
+{
+    Tp::ContactAttributesMap attributes;
+    const Tp::ContactCapabilitiesMap capabilities = getContactCapabilities(contacts, error);
+    for (Tp::ContactCapabilitiesMap::const_iterator i = capabilities.constBegin(); i != capabilities.constEnd(); ++i) {
+        attributes[i.key()].insert(TP_QT_TOKEN_CONNECTION_INTERFACE_CONTACT_CAPABILITIES_CAPABILITIES,
+                QVariant::fromValue(i.value()));
+    }
+    return attributes;
+}
+
 }
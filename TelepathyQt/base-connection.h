@@ -28,6 +28,7 @@
 #endif
 
 #include <TelepathyQt/AvatarSpec>
+#include <TelepathyQt/BaseHandleRepository>
 #include <TelepathyQt/DBusService>
 #include <TelepathyQt/Global>
 #include <TelepathyQt/Types>
@@ -96,6 +97,9 @@ public:
     void setRequestHandlesCallback(const RequestHandlesCallback &cb);
     Tp::UIntList requestHandles(uint handleType, const QStringList &identifiers, DBusError *error);
 
+    void setHandleRepository(const BaseHandleRepositoryPtr &repository);
+    BaseHandleRepositoryPtr handleRepository(uint handleType) const;
+
     Tp::ChannelInfoList channelsInfo();
     Tp::ChannelDetailsList channelsDetails();
 
@@ -144,9 +148,17 @@ public:
     AbstractConnectionInterface(const QString &interfaceName);
     ~AbstractConnectionInterface() override;
 
+    bool providesContactAttributes() const;
+    Tp::ContactAttributesMap contactAttributes(const Tp::UIntList &contacts, DBusError *error);
+    void invalidateContactAttributes();
+    void invalidateContactAttributes(const Tp::UIntList &contacts);
+
 protected:
     virtual void setBaseConnection(BaseConnection *connection);
 
+    typedef Callback2<Tp::ContactAttributesMap, const Tp::UIntList &, DBusError*> BuildContactAttributesCallback;
+    void setBuildContactAttributesCallback(const BuildContactAttributesCallback &cb);
+
 private:
     friend class BaseConnection;
 
@@ -273,11 +285,21 @@ public:
 
     Tp::SimpleContactPresences getPresences(const Tp::UIntList &contacts);
 
+    int presencesChangedBatchSize() const;
+    void setPresencesChangedBatchSize(int size);
+    int presencesChangedLatency() const;
+    void setPresencesChangedLatency(int msecs);
+    void flushPresencesChanged();
+
 protected:
     BaseConnectionSimplePresenceInterface();
 
+private Q_SLOTS:
+    TP_QT_NO_EXPORT void onPresencesChangedTimeout();
+
 private:
     void createAdaptor() override;
+    TP_QT_NO_EXPORT Tp::ContactAttributesMap buildContactAttributes(const Tp::UIntList &contacts, DBusError *error);
 
     class Adaptee;
     friend class Adaptee;
@@ -352,9 +374,12 @@ public:
 
 protected:
     BaseConnectionContactListInterface();
+    void setBaseConnection(BaseConnection *connection) override;
 
 private:
     void createAdaptor() override;
+    TP_QT_NO_EXPORT Tp::ContactAttributesMap buildContactAttributes(const Tp::UIntList &contacts, DBusError *error);
+    TP_QT_NO_EXPORT void invalidateContactGroupsAttributes(const Tp::UIntList &contacts, bool all);
 
     class Adaptee;
     friend class Adaptee;
@@ -422,9 +447,11 @@ public:
 
 protected:
     BaseConnectionContactGroupsInterface();
+    void setBaseConnection(BaseConnection *connection) override;
 
 private:
     void createAdaptor() override;
+    TP_QT_NO_EXPORT Tp::ContactAttributesMap buildContactAttributes(const Tp::UIntList &contacts, DBusError *error);
 
     class Adaptee;
     friend class Adaptee;
@@ -569,6 +596,7 @@ protected:
 
 private:
     void createAdaptor() override;
+    TP_QT_NO_EXPORT Tp::ContactAttributesMap buildContactAttributes(const Tp::UIntList &contacts, DBusError *error);
 
     class Adaptee;
     friend class Adaptee;
@@ -623,6 +651,7 @@ protected:
 
 private:
     void createAdaptor() override;
+    TP_QT_NO_EXPORT Tp::ContactAttributesMap buildContactAttributes(const Tp::UIntList &contacts, DBusError *error);
 
     class Adaptee;
     friend class Adaptee;
@@ -665,6 +694,7 @@ protected:
 
 private:
     void createAdaptor() override;
+    TP_QT_NO_EXPORT Tp::ContactAttributesMap buildContactAttributes(const Tp::UIntList &contacts, DBusError *error);
 
     class Adaptee;
     friend class Adaptee;
@@ -707,6 +737,7 @@ protected:
 
 private:
     void createAdaptor() override;
+    TP_QT_NO_EXPORT Tp::ContactAttributesMap buildContactAttributes(const Tp::UIntList &contacts, DBusError *error);
 
     class Adaptee;
     friend class Adaptee;
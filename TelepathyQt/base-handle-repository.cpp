@@ -0,0 +1,316 @@
+/**
+ * This file is part of TelepathyQt
+ *
+ * @copyright Copyright (C) 2026 Collabora Ltd. <http://www.collabora.co.uk/>
+ * @license LGPL 2.1
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <TelepathyQt/BaseHandleRepository>
+
+#include <TelepathyQt/Constants>
+#include <TelepathyQt/DBusError>
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace Tp
+{
+
+struct TP_QT_NO_EXPORT BaseHandleRepository::Private
+{
+    Private(uint handleType)
+        : handleType(handleType),
+          normalizationCacheSize(4096)
+    {
+    }
+
+    uint intern(const QString &normalizedIdentifier);
+
+    uint handleType;
+    NormalizeCallback normalizeCB;
+    int normalizationCacheSize;
+
+    // Handle N is identifiers[N - 1]; both containers share the same implicitly shared strings
+    QVector<QString> identifiers;
+    QHash<QString, uint> handles;
+
+    // Maps identifiers as given by clients to their interned normalized form
+    QHash<QString, QString> normalized;
+};
+
+uint BaseHandleRepository::Private::intern(const QString &normalizedIdentifier)
+{
+    QHash<QString, uint>::const_iterator i = handles.constFind(normalizedIdentifier);
+    if (i != handles.constEnd()) {
+        return i.value();
+    }
+
+    identifiers.append(normalizedIdentifier);
+    uint handle = identifiers.size();
+    handles.insert(normalizedIdentifier, handle);
+    return handle;
+}
+
+/**
+ * \class BaseHandleRepository
+ * \ingroup serviceconn
+ * \headerfile TelepathyQt/base-handle-repository.h <TelepathyQt/BaseHandleRepository>
+ *
+ * \brief Ready-made mapping between identifiers and handles of one handle type.
+ *
+ * Connection managers built on BaseConnection must provide handles for the
+ * identifiers they deal with. Instead of implementing
+ * BaseConnection::RequestHandlesCallback and BaseConnection::InspectHandlesCallback
+ * themselves, they can create a BaseHandleRepository per handle type and pass it to
+ * BaseConnection::setHandleRepository(), which then answers RequestHandles, InspectHandles
+ * and Contacts.GetContactByID from the repository.
+ *
+ * Identifiers are normalized with the callback set by setNormalizeCallback(),
+ * and the results are memoized. Each normalized identifier is stored once and
+ * is assigned a handle. The handle never changes for the repository's lifetime.
+ * Lookups in both directions take constant time.
+ */
+
+/**
+ * Construct a new BaseHandleRepository object.
+ *
+ * \param handleType The handle type of the handles managed by this repository, as
+ *                   defined in #HandleType.
+ */
+BaseHandleRepository::BaseHandleRepository(uint handleType)
+    : mPriv(new Private(handleType))
+{
+}
+
+/**
+ * Class destructor.
+ */
+BaseHandleRepository::~BaseHandleRepository()
+{
+    delete mPriv;
+}
+
+/**
+ * Return the handle type of the handles managed by this repository.
+ *
+ * \return The handle type, as defined in #HandleType.
+ */
+uint BaseHandleRepository::handleType() const
+{
+    return mPriv->handleType;
+}
+
+/**
+ * Set the function used to normalize identifiers before they are assigned handles.
+ *
+ * The callback should set \a error and may return an empty string if the identifier is
+ * not valid. If no callback is set, identifiers are used as given.
+ *
+ * Changing the callback clears the normalization cache, but keeps existing handles.
+ *
+ * \param cb The normalization callback.
+ */
+void BaseHandleRepository::setNormalizeCallback(const NormalizeCallback &cb)
+{
+    mPriv->normalizeCB = cb;
+    mPriv->normalized.clear();
+}
+
+/**
+ * Return the normalized form of \a identifier.
+ *
+ * Results of the normalization callback are cached, see setNormalizationCacheSize().
+ *
+ * \param identifier The identifier to normalize.
+ * \param error Set if \a identifier is not valid.
+ * \return The normalized identifier, or an empty string on error.
+ */
+QString BaseHandleRepository::normalize(const QString &identifier, DBusError *error)
+{
+    QHash<QString, QString>::const_iterator i = mPriv->normalized.constFind(identifier);
+    if (i != mPriv->normalized.constEnd()) {
+        return i.value();
+    }
+
+    QString result = identifier;
+    if (mPriv->normalizeCB.isValid()) {
+        result = mPriv->normalizeCB(identifier, error);
+        if (error->isValid()) {
+            return QString();
+        }
+    }
+
+    if (result.isEmpty()) {
+        error->set(TP_QT_ERROR_INVALID_HANDLE,
+                QString(QLatin1String("Invalid identifier \"%1\"")).arg(identifier));
+        return QString();
+    }
+
+    if (mPriv->normalizationCacheSize > 0) {
+        if (mPriv->normalized.size() >= mPriv->normalizationCacheSize) {
+            mPriv->normalized.clear();
+        }
+
+        mPriv->normalized.insert(identifier, result);
+    }
+
+    return result;
+}
+
+/**
+ * Return the maximum number of normalization results cached by this repository.
+ *
+ * \return The cache size, 0 if caching is disabled.
+ * \sa setNormalizationCacheSize()
+ */
+int BaseHandleRepository::normalizationCacheSize() const
+{
+    return mPriv->normalizationCacheSize;
+}
+
+/**
+ * Set the maximum number of normalization results cached by this repository.
+ *
+ * The cache is dropped as a whole when it fills up, so the size should be larger than the set of
+ * identifiers in active use. The default size is 4096.
+ *
+ * \param size The cache size, or 0 to call the normalization callback every time.
+ */
+void BaseHandleRepository::setNormalizationCacheSize(int size)
+{
+    mPriv->normalizationCacheSize = qMax(size, 0);
+    if (mPriv->normalized.size() > mPriv->normalizationCacheSize) {
+        mPriv->normalized.clear();
+    }
+}
+
+/**
+ * Return the handle for \a identifier, assigning a new one if needed.
+ *
+ * \param identifier The identifier, which will be normalized.
+ * \param error Set if \a identifier is not valid.
+ * \return The handle, or 0 on error.
+ */
+uint BaseHandleRepository::ensureHandle(const QString &identifier, DBusError *error)
+{
+    QString normalizedIdentifier = normalize(identifier, error);
+    if (error->isValid()) {
+        return 0;
+    }
+
+    return mPriv->intern(normalizedIdentifier);
+}
+
+/**
+ * Return the handles for \a identifiers, assigning new ones if needed.
+ *
+ * \param identifiers The identifiers, which will be normalized.
+ * \param error Set if any of \a identifiers is not valid.
+ * \return The handles, in the same order as \a identifiers, or an empty list on error.
+ */
+Tp::UIntList BaseHandleRepository::ensureHandles(const QStringList &identifiers, DBusError *error)
+{
+    Tp::UIntList result;
+    result.reserve(identifiers.size());
+
+    foreach (const QString &identifier, identifiers) {
+        uint handle = ensureHandle(identifier, error);
+        if (error->isValid()) {
+            return Tp::UIntList();
+        }
+        result.append(handle);
+    }
+
+    return result;
+}
+
+/**
+ * Return the handle already assigned to \a normalizedIdentifier.
+ *
+ * Unlike ensureHandle(), this neither normalizes the identifier nor assigns a new handle.
+ *
+ * \param normalizedIdentifier An identifier in normalized form.
+ * \return The handle, or 0 if none has been assigned.
+ */
+uint BaseHandleRepository::handle(const QString &normalizedIdentifier) const
+{
+    return mPriv->handles.value(normalizedIdentifier);
+}
+
+/**
+ * Return whether \a handle has been assigned by this repository.
+ *
+ * \param handle The handle to check.
+ * \return \c true if \a handle is valid, \c false otherwise.
+ */
+bool BaseHandleRepository::isValid(uint handle) const
+{
+    return handle > 0 && handle <= static_cast<uint>(mPriv->identifiers.size());
+}
+
+/**
+ * Return the normalized identifier of \a handle.
+ *
+ * \param handle The handle.
+ * \return The identifier, or an empty string if \a handle is not valid.
+ */
+QString BaseHandleRepository::identifier(uint handle) const
+{
+    if (!isValid(handle)) {
+        return QString();
+    }
+
+    return mPriv->identifiers[handle - 1];
+}
+
+/**
+ * Return the normalized identifiers of \a handles.
+ *
+ * \param handles The handles.
+ * \param error Set if any of \a handles is not valid.
+ * \return The identifiers, in the same order as \a handles, or an empty list on error.
+ */
+QStringList BaseHandleRepository::identifiers(const Tp::UIntList &handles, DBusError *error) const
+{
+    QStringList result;
+    result.reserve(handles.size());
+
+    foreach (uint handle, handles) {
+        if (!isValid(handle)) {
+            error->set(TP_QT_ERROR_INVALID_HANDLE,
+                    QString(QLatin1String("Invalid handle %1")).arg(handle));
+            return QStringList();
+        }
+        result.append(mPriv->identifiers[handle - 1]);
+    }
+
+    return result;
+}
+
+/**
+ * Return the number of handles assigned by this repository.
+ *
+ * \return The number of handles.
+ */
+int BaseHandleRepository::count() const
+{
+    return mPriv->identifiers.size();
+}
+
+} // Tp
@@ -30,6 +30,10 @@
 #include <TelepathyQt/Functors>
 #include <TelepathyQt/Global>
 
+#include <new>
+#include <type_traits>
+#include <utility>
+
 namespace Tp
 {
 
@@ -62,43 +66,113 @@ struct BaseFunctorCaller : public AbstractFunctorCaller
     Functor functor;
 };
 
+/* the CallbackN classes invoke the functor themselves, so no hook is needed */
+template <class Functor>
+struct FunctorCaller : public BaseFunctorCaller<FunctorCaller<Functor>, Functor>
+{
+    explicit FunctorCaller(const Functor &functor)
+        : BaseFunctorCaller<FunctorCaller<Functor>, Functor>(functor, nullptr) {}
+};
+
 struct TP_QT_EXPORT BaseCallback
 {
-    BaseCallback() : caller(nullptr) {}
+    BaseCallback() : caller(nullptr), isLocal(false) {}
     /* takes ownership of caller */
-    BaseCallback(AbstractFunctorCaller *caller) : caller(caller) {}
-    BaseCallback(const BaseCallback &other) : caller(other.caller->clone()) {}
+    BaseCallback(AbstractFunctorCaller *caller) : caller(caller), isLocal(false) {}
+    BaseCallback(const BaseCallback &other)
+        : caller(other.caller ? other.caller->clone() : nullptr), isLocal(other.isLocal)
+    {
+        if (isLocal) {
+            storage = other.storage;
+        }
+    }
+    BaseCallback(BaseCallback &&other) noexcept : caller(other.caller), isLocal(other.isLocal)
+    {
+        if (isLocal) {
+            storage = other.storage;
+        }
+        other.caller = nullptr;
+        other.isLocal = false;
+    }
     virtual ~BaseCallback() { delete caller; }
 
-    bool isValid() const { return caller != nullptr; }
+    bool isValid() const { return caller != nullptr || isLocal; }
 
     BaseCallback &operator=(const BaseCallback &other)
     {
-        if (caller == other.caller) return *this;
+        if (this == &other) return *this;
+        AbstractFunctorCaller *newCaller = other.caller ? other.caller->clone() : nullptr;
         delete caller;
-        caller = other.caller->clone();
+        caller = newCaller;
+        isLocal = other.isLocal;
+        if (isLocal) {
+            storage = other.storage;
+        }
+        return *this;
+    }
+
+    BaseCallback &operator=(BaseCallback &&other) noexcept
+    {
+        if (this != &other) {
+            delete caller;
+            caller = other.caller;
+            isLocal = other.isLocal;
+            if (isLocal) {
+                storage = other.storage;
+            }
+            other.caller = nullptr;
+            other.isLocal = false;
+        }
         return *this;
     }
 
 protected:
-    /* may be null */
-    AbstractFunctorCaller *caller;
-};
+    /* large enough for a MemberFunctor, i.e. an object and a member function pointer */
+    enum { LocalSize = 4 * sizeof(void*) };
 
-template <class Functor, class R >
-struct FunctorCaller0 : public BaseFunctorCaller<FunctorCaller0<Functor, R >, Functor>
-{
-    typedef R ResultType;
-    typedef R (*InvokeType)(AbstractFunctorCaller* );
+    union Storage
+    {
+        void *object;
+        void (*function)();
+        qint64 integer;
+        double real;
+        char data[LocalSize];
+    };
+
+    template <class Functor>
+    struct IsLocal
+    {
+        static const bool value = sizeof(Functor) <= sizeof(Storage) &&
+            alignof(Functor) <= alignof(Storage) &&
+            std::is_trivially_copyable<Functor>::value &&
+            std::is_trivially_destructible<Functor>::value;
+    };
 
-    explicit FunctorCaller0(const Functor &functor) : BaseFunctorCaller<FunctorCaller0, Functor>(functor, reinterpret_cast<AbstractFunctorCaller::HookType>(&FunctorCaller0<Functor, R >::invoke)) {}
+    template <class Functor>
+    void init(const Functor &functor)
+    {
+        if (IsLocal<Functor>::value) {
+            new (storage.data) Functor(functor);
+            isLocal = true;
+        } else {
+            caller = new FunctorCaller<Functor>(functor);
+        }
+    }
 
-    static ResultType invoke(AbstractFunctorCaller *call )
+    /* the functor may have a non-const call operator, as with the previous callers */
+    template <class Functor>
+    Functor &target() const
     {
-        typedef FunctorCaller0<Functor, R > Type;
-        Type *typed = static_cast<Type*>(call);
-        return (typed->functor)();
+        if (IsLocal<Functor>::value) {
+            return *reinterpret_cast<Functor*>(storage.data);
+        }
+        return static_cast<FunctorCaller<Functor>*>(caller)->functor;
     }
+
+    /* may be null; owned by this callback and cloned when it is copied */
+    AbstractFunctorCaller *caller;
+    mutable Storage storage;
+    bool isLocal;
 };
 
 template <class R >
@@ -107,35 +181,28 @@ struct Callback0 : public BaseCallback
     typedef R (*FunctionType)();
     typedef R ResultType;
 
-    Callback0() {}
+    Callback0() : invokeMethod(nullptr) {}
     template <class Functor>
-    Callback0(const Functor &functor) : BaseCallback(new FunctorCaller0<Functor, R >(functor)) {}
+    Callback0(const Functor &functor) : invokeMethod(&Callback0::invoke<Functor>) { init(functor); }
 
     ResultType operator()() const
     {
-        if (caller) {
-            typedef R (*InvokeType)(AbstractFunctorCaller* );
-            InvokeType invokeMethod = reinterpret_cast<InvokeType>(caller->invokeMethodHook);
-            return invokeMethod(caller );
+        if (isValid()) {
+            return invokeMethod(this );
         }
         return ResultType();
     }
-};
 
-template <class Functor, class R , class Arg1>
-struct FunctorCaller1 : public BaseFunctorCaller<FunctorCaller1<Functor, R , Arg1>, Functor>
-{
-    typedef R ResultType;
-    typedef R (*InvokeType)(AbstractFunctorCaller* , Arg1);
-
-    explicit FunctorCaller1(const Functor &functor) : BaseFunctorCaller<FunctorCaller1, Functor>(functor, reinterpret_cast<AbstractFunctorCaller::HookType>(&FunctorCaller1<Functor, R , Arg1>::invoke)) {}
+private:
+    typedef R (*InvokeType)(const Callback0* );
 
-    static ResultType invoke(AbstractFunctorCaller *call , Arg1 a1)
+    template <class Functor>
+    static ResultType invoke(const Callback0 *callback )
     {
-        typedef FunctorCaller1<Functor, R , Arg1> Type;
-        Type *typed = static_cast<Type*>(call);
-        return (typed->functor)(a1);
+        return callback->template target<Functor>()();
     }
+
+    InvokeType invokeMethod;
 };
 
 template <class R , class Arg1>
@@ -144,35 +211,28 @@ struct Callback1 : public BaseCallback
     typedef R (*FunctionType)(Arg1);
     typedef R ResultType;
 
-    Callback1() {}
+    Callback1() : invokeMethod(nullptr) {}
     template <class Functor>
-    Callback1(const Functor &functor) : BaseCallback(new FunctorCaller1<Functor, R , Arg1>(functor)) {}
+    Callback1(const Functor &functor) : invokeMethod(&Callback1::invoke<Functor>) { init(functor); }
 
     ResultType operator()(Arg1 a1) const
     {
-        if (caller) {
-            typedef R (*InvokeType)(AbstractFunctorCaller* , Arg1);
-            InvokeType invokeMethod = reinterpret_cast<InvokeType>(caller->invokeMethodHook);
-            return invokeMethod(caller , a1);
+        if (isValid()) {
+            return invokeMethod(this , a1);
         }
         return ResultType();
     }
-};
 
-template <class Functor, class R , class Arg1, class Arg2>
-struct FunctorCaller2 : public BaseFunctorCaller<FunctorCaller2<Functor, R , Arg1, Arg2>, Functor>
-{
-    typedef R ResultType;
-    typedef R (*InvokeType)(AbstractFunctorCaller* , Arg1, Arg2);
-
-    explicit FunctorCaller2(const Functor &functor) : BaseFunctorCaller<FunctorCaller2, Functor>(functor, reinterpret_cast<AbstractFunctorCaller::HookType>(&FunctorCaller2<Functor, R , Arg1, Arg2>::invoke)) {}
+private:
+    typedef R (*InvokeType)(const Callback1* , Arg1);
 
-    static ResultType invoke(AbstractFunctorCaller *call , Arg1 a1, Arg2 a2)
+    template <class Functor>
+    static ResultType invoke(const Callback1 *callback , Arg1 a1)
     {
-        typedef FunctorCaller2<Functor, R , Arg1, Arg2> Type;
-        Type *typed = static_cast<Type*>(call);
-        return (typed->functor)(a1, a2);
+        return callback->template target<Functor>()(a1);
     }
+
+    InvokeType invokeMethod;
 };
 
 template <class R , class Arg1, class Arg2>
@@ -181,35 +241,28 @@ struct Callback2 : public BaseCallback
     typedef R (*FunctionType)(Arg1, Arg2);
     typedef R ResultType;
 
-    Callback2() {}
+    Callback2() : invokeMethod(nullptr) {}
     template <class Functor>
-    Callback2(const Functor &functor) : BaseCallback(new FunctorCaller2<Functor, R , Arg1, Arg2>(functor)) {}
+    Callback2(const Functor &functor) : invokeMethod(&Callback2::invoke<Functor>) { init(functor); }
 
     ResultType operator()(Arg1 a1, Arg2 a2) const
     {
-        if (caller) {
-            typedef R (*InvokeType)(AbstractFunctorCaller* , Arg1, Arg2);
-            InvokeType invokeMethod = reinterpret_cast<InvokeType>(caller->invokeMethodHook);
-            return invokeMethod(caller , a1, a2);
+        if (isValid()) {
+            return invokeMethod(this , a1, a2);
         }
         return ResultType();
     }
-};
-
-template <class Functor, class R , class Arg1, class Arg2, class Arg3>
-struct FunctorCaller3 : public BaseFunctorCaller<FunctorCaller3<Functor, R , Arg1, Arg2, Arg3>, Functor>
-{
-    typedef R ResultType;
-    typedef R (*InvokeType)(AbstractFunctorCaller* , Arg1, Arg2, Arg3);
 
-    explicit FunctorCaller3(const Functor &functor) : BaseFunctorCaller<FunctorCaller3, Functor>(functor, reinterpret_cast<AbstractFunctorCaller::HookType>(&FunctorCaller3<Functor, R , Arg1, Arg2, Arg3>::invoke)) {}
+private:
+    typedef R (*InvokeType)(const Callback2* , Arg1, Arg2);
 
-    static ResultType invoke(AbstractFunctorCaller *call , Arg1 a1, Arg2 a2, Arg3 a3)
+    template <class Functor>
+    static ResultType invoke(const Callback2 *callback , Arg1 a1, Arg2 a2)
     {
-        typedef FunctorCaller3<Functor, R , Arg1, Arg2, Arg3> Type;
-        Type *typed = static_cast<Type*>(call);
-        return (typed->functor)(a1, a2, a3);
+        return callback->template target<Functor>()(a1, a2);
     }
+
+    InvokeType invokeMethod;
 };
 
 template <class R , class Arg1, class Arg2, class Arg3>
@@ -218,35 +271,28 @@ struct Callback3 : public BaseCallback
     typedef R (*FunctionType)(Arg1, Arg2, Arg3);
     typedef R ResultType;
 
-    Callback3() {}
+    Callback3() : invokeMethod(nullptr) {}
     template <class Functor>
-    Callback3(const Functor &functor) : BaseCallback(new FunctorCaller3<Functor, R , Arg1, Arg2, Arg3>(functor)) {}
+    Callback3(const Functor &functor) : invokeMethod(&Callback3::invoke<Functor>) { init(functor); }
 
     ResultType operator()(Arg1 a1, Arg2 a2, Arg3 a3) const
     {
-        if (caller) {
-            typedef R (*InvokeType)(AbstractFunctorCaller* , Arg1, Arg2, Arg3);
-            InvokeType invokeMethod = reinterpret_cast<InvokeType>(caller->invokeMethodHook);
-            return invokeMethod(caller , a1, a2, a3);
+        if (isValid()) {
+            return invokeMethod(this , a1, a2, a3);
         }
         return ResultType();
     }
-};
-
-template <class Functor, class R , class Arg1, class Arg2, class Arg3, class Arg4>
-struct FunctorCaller4 : public BaseFunctorCaller<FunctorCaller4<Functor, R , Arg1, Arg2, Arg3, Arg4>, Functor>
-{
-    typedef R ResultType;
-    typedef R (*InvokeType)(AbstractFunctorCaller* , Arg1, Arg2, Arg3, Arg4);
 
-    explicit FunctorCaller4(const Functor &functor) : BaseFunctorCaller<FunctorCaller4, Functor>(functor, reinterpret_cast<AbstractFunctorCaller::HookType>(&FunctorCaller4<Functor, R , Arg1, Arg2, Arg3, Arg4>::invoke)) {}
+private:
+    typedef R (*InvokeType)(const Callback3* , Arg1, Arg2, Arg3);
 
-    static ResultType invoke(AbstractFunctorCaller *call , Arg1 a1, Arg2 a2, Arg3 a3, Arg4 a4)
+    template <class Functor>
+    static ResultType invoke(const Callback3 *callback , Arg1 a1, Arg2 a2, Arg3 a3)
     {
-        typedef FunctorCaller4<Functor, R , Arg1, Arg2, Arg3, Arg4> Type;
-        Type *typed = static_cast<Type*>(call);
-        return (typed->functor)(a1, a2, a3, a4);
+        return callback->template target<Functor>()(a1, a2, a3);
     }
+
+    InvokeType invokeMethod;
 };
 
 template <class R , class Arg1, class Arg2, class Arg3, class Arg4>
@@ -255,35 +301,28 @@ struct Callback4 : public BaseCallback
     typedef R (*FunctionType)(Arg1, Arg2, Arg3, Arg4);
     typedef R ResultType;
 
-    Callback4() {}
+    Callback4() : invokeMethod(nullptr) {}
     template <class Functor>
-    Callback4(const Functor &functor) : BaseCallback(new FunctorCaller4<Functor, R , Arg1, Arg2, Arg3, Arg4>(functor)) {}
+    Callback4(const Functor &functor) : invokeMethod(&Callback4::invoke<Functor>) { init(functor); }
 
     ResultType operator()(Arg1 a1, Arg2 a2, Arg3 a3, Arg4 a4) const
     {
-        if (caller) {
-            typedef R (*InvokeType)(AbstractFunctorCaller* , Arg1, Arg2, Arg3, Arg4);
-            InvokeType invokeMethod = reinterpret_cast<InvokeType>(caller->invokeMethodHook);
-            return invokeMethod(caller , a1, a2, a3, a4);
+        if (isValid()) {
+            return invokeMethod(this , a1, a2, a3, a4);
         }
         return ResultType();
     }
-};
 
-template <class Functor, class R , class Arg1, class Arg2, class Arg3, class Arg4, class Arg5>
-struct FunctorCaller5 : public BaseFunctorCaller<FunctorCaller5<Functor, R , Arg1, Arg2, Arg3, Arg4, Arg5>, Functor>
-{
-    typedef R ResultType;
-    typedef R (*InvokeType)(AbstractFunctorCaller* , Arg1, Arg2, Arg3, Arg4, Arg5);
-
-    explicit FunctorCaller5(const Functor &functor) : BaseFunctorCaller<FunctorCaller5, Functor>(functor, reinterpret_cast<AbstractFunctorCaller::HookType>(&FunctorCaller5<Functor, R , Arg1, Arg2, Arg3, Arg4, Arg5>::invoke)) {}
+private:
+    typedef R (*InvokeType)(const Callback4* , Arg1, Arg2, Arg3, Arg4);
 
-    static ResultType invoke(AbstractFunctorCaller *call , Arg1 a1, Arg2 a2, Arg3 a3, Arg4 a4, Arg5 a5)
+    template <class Functor>
+    static ResultType invoke(const Callback4 *callback , Arg1 a1, Arg2 a2, Arg3 a3, Arg4 a4)
     {
-        typedef FunctorCaller5<Functor, R , Arg1, Arg2, Arg3, Arg4, Arg5> Type;
-        Type *typed = static_cast<Type*>(call);
-        return (typed->functor)(a1, a2, a3, a4, a5);
+        return callback->template target<Functor>()(a1, a2, a3, a4);
     }
+
+    InvokeType invokeMethod;
 };
 
 template <class R , class Arg1, class Arg2, class Arg3, class Arg4, class Arg5>
@@ -292,35 +331,28 @@ struct Callback5 : public BaseCallback
     typedef R (*FunctionType)(Arg1, Arg2, Arg3, Arg4, Arg5);
     typedef R ResultType;
 
-    Callback5() {}
+    Callback5() : invokeMethod(nullptr) {}
     template <class Functor>
-    Callback5(const Functor &functor) : BaseCallback(new FunctorCaller5<Functor, R , Arg1, Arg2, Arg3, Arg4, Arg5>(functor)) {}
+    Callback5(const Functor &functor) : invokeMethod(&Callback5::invoke<Functor>) { init(functor); }
 
     ResultType operator()(Arg1 a1, Arg2 a2, Arg3 a3, Arg4 a4, Arg5 a5) const
     {
-        if (caller) {
-            typedef R (*InvokeType)(AbstractFunctorCaller* , Arg1, Arg2, Arg3, Arg4, Arg5);
-            InvokeType invokeMethod = reinterpret_cast<InvokeType>(caller->invokeMethodHook);
-            return invokeMethod(caller , a1, a2, a3, a4, a5);
+        if (isValid()) {
+            return invokeMethod(this , a1, a2, a3, a4, a5);
         }
         return ResultType();
     }
-};
-
-template <class Functor, class R , class Arg1, class Arg2, class Arg3, class Arg4, class Arg5, class Arg6>
-struct FunctorCaller6 : public BaseFunctorCaller<FunctorCaller6<Functor, R , Arg1, Arg2, Arg3, Arg4, Arg5, Arg6>, Functor>
-{
-    typedef R ResultType;
-    typedef R (*InvokeType)(AbstractFunctorCaller* , Arg1, Arg2, Arg3, Arg4, Arg5, Arg6);
 
-    explicit FunctorCaller6(const Functor &functor) : BaseFunctorCaller<FunctorCaller6, Functor>(functor, reinterpret_cast<AbstractFunctorCaller::HookType>(&FunctorCaller6<Functor, R , Arg1, Arg2, Arg3, Arg4, Arg5, Arg6>::invoke)) {}
+private:
+    typedef R (*InvokeType)(const Callback5* , Arg1, Arg2, Arg3, Arg4, Arg5);
 
-    static ResultType invoke(AbstractFunctorCaller *call , Arg1 a1, Arg2 a2, Arg3 a3, Arg4 a4, Arg5 a5, Arg6 a6)
+    template <class Functor>
+    static ResultType invoke(const Callback5 *callback , Arg1 a1, Arg2 a2, Arg3 a3, Arg4 a4, Arg5 a5)
     {
-        typedef FunctorCaller6<Functor, R , Arg1, Arg2, Arg3, Arg4, Arg5, Arg6> Type;
-        Type *typed = static_cast<Type*>(call);
-        return (typed->functor)(a1, a2, a3, a4, a5, a6);
+        return callback->template target<Functor>()(a1, a2, a3, a4, a5);
     }
+
+    InvokeType invokeMethod;
 };
 
 template <class R , class Arg1, class Arg2, class Arg3, class Arg4, class Arg5, class Arg6>
@@ -329,35 +361,28 @@ struct Callback6 : public BaseCallback
     typedef R (*FunctionType)(Arg1, Arg2, Arg3, Arg4, Arg5, Arg6);
     typedef R ResultType;
 
-    Callback6() {}
+    Callback6() : invokeMethod(nullptr) {}
     template <class Functor>
-    Callback6(const Functor &functor) : BaseCallback(new FunctorCaller6<Functor, R , Arg1, Arg2, Arg3, Arg4, Arg5, Arg6>(functor)) {}
+    Callback6(const Functor &functor) : invokeMethod(&Callback6::invoke<Functor>) { init(functor); }
 
     ResultType operator()(Arg1 a1, Arg2 a2, Arg3 a3, Arg4 a4, Arg5 a5, Arg6 a6) const
     {
-        if (caller) {
-            typedef R (*InvokeType)(AbstractFunctorCaller* , Arg1, Arg2, Arg3, Arg4, Arg5, Arg6);
-            InvokeType invokeMethod = reinterpret_cast<InvokeType>(caller->invokeMethodHook);
-            return invokeMethod(caller , a1, a2, a3, a4, a5, a6);
+        if (isValid()) {
+            return invokeMethod(this , a1, a2, a3, a4, a5, a6);
         }
         return ResultType();
     }
-};
-
-template <class Functor, class R , class Arg1, class Arg2, class Arg3, class Arg4, class Arg5, class Arg6, class Arg7>
-struct FunctorCaller7 : public BaseFunctorCaller<FunctorCaller7<Functor, R , Arg1, Arg2, Arg3, Arg4, Arg5, Arg6, Arg7>, Functor>
-{
-    typedef R ResultType;
-    typedef R (*InvokeType)(AbstractFunctorCaller* , Arg1, Arg2, Arg3, Arg4, Arg5, Arg6, Arg7);
 
-    explicit FunctorCaller7(const Functor &functor) : BaseFunctorCaller<FunctorCaller7, Functor>(functor, reinterpret_cast<AbstractFunctorCaller::HookType>(&FunctorCaller7<Functor, R , Arg1, Arg2, Arg3, Arg4, Arg5, Arg6, Arg7>::invoke)) {}
+private:
+    typedef R (*InvokeType)(const Callback6* , Arg1, Arg2, Arg3, Arg4, Arg5, Arg6);
 
-    static ResultType invoke(AbstractFunctorCaller *call , Arg1 a1, Arg2 a2, Arg3 a3, Arg4 a4, Arg5 a5, Arg6 a6, Arg7 a7)
+    template <class Functor>
+    static ResultType invoke(const Callback6 *callback , Arg1 a1, Arg2 a2, Arg3 a3, Arg4 a4, Arg5 a5, Arg6 a6)
     {
-        typedef FunctorCaller7<Functor, R , Arg1, Arg2, Arg3, Arg4, Arg5, Arg6, Arg7> Type;
-        Type *typed = static_cast<Type*>(call);
-        return (typed->functor)(a1, a2, a3, a4, a5, a6, a7);
+        return callback->template target<Functor>()(a1, a2, a3, a4, a5, a6);
     }
+
+    InvokeType invokeMethod;
 };
 
 template <class R , class Arg1, class Arg2, class Arg3, class Arg4, class Arg5, class Arg6, class Arg7>
@@ -366,19 +391,28 @@ struct Callback7 : public BaseCallback
     typedef R (*FunctionType)(Arg1, Arg2, Arg3, Arg4, Arg5, Arg6, Arg7);
     typedef R ResultType;
 
-    Callback7() {}
+    Callback7() : invokeMethod(nullptr) {}
     template <class Functor>
-    Callback7(const Functor &functor) : BaseCallback(new FunctorCaller7<Functor, R , Arg1, Arg2, Arg3, Arg4, Arg5, Arg6, Arg7>(functor)) {}
+    Callback7(const Functor &functor) : invokeMethod(&Callback7::invoke<Functor>) { init(functor); }
 
     ResultType operator()(Arg1 a1, Arg2 a2, Arg3 a3, Arg4 a4, Arg5 a5, Arg6 a6, Arg7 a7) const
     {
-        if (caller) {
-            typedef R (*InvokeType)(AbstractFunctorCaller* , Arg1, Arg2, Arg3, Arg4, Arg5, Arg6, Arg7);
-            InvokeType invokeMethod = reinterpret_cast<InvokeType>(caller->invokeMethodHook);
-            return invokeMethod(caller , a1, a2, a3, a4, a5, a6, a7);
+        if (isValid()) {
+            return invokeMethod(this , a1, a2, a3, a4, a5, a6, a7);
         }
         return ResultType();
     }
+
+private:
+    typedef R (*InvokeType)(const Callback7* , Arg1, Arg2, Arg3, Arg4, Arg5, Arg6, Arg7);
+
+    template <class Functor>
+    static ResultType invoke(const Callback7 *callback , Arg1 a1, Arg2 a2, Arg3 a3, Arg4 a4, Arg5 a5, Arg6 a6, Arg7 a7)
+    {
+        return callback->template target<Functor>()(a1, a2, a3, a4, a5, a6, a7);
+    }
+
+    InvokeType invokeMethod;
 };
 
 }
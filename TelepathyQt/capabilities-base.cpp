@@ -25,6 +25,8 @@
 #include <TelepathyQt/Constants>
 #include <TelepathyQt/Types>
 
+#include <QAtomicInt>
+
 namespace Tp
 {
 
@@ -33,20 +35,95 @@ struct TP_QT_NO_EXPORT CapabilitiesBase::Private : public QSharedData
     Private(bool specificToContact);
     Private(const RequestableChannelClassSpecList &rccSpecs, bool specificToContact);
 
+    int wellKnownCapabilities() const;
+    int classify() const;
+
     RequestableChannelClassSpecList rccSpecs;
     bool specificToContact;
+
+    // WellKnownCapability bits of rccSpecs, valid once the Classified bit is set. Computing them
+    // concurrently from several copies sharing this data is harmless, as they all get the same bits
+    enum { Classified = 1 << 30 };
+    mutable QAtomicInt capabilities;
 };
 
 CapabilitiesBase::Private::Private(bool specificToContact)
-    : specificToContact(specificToContact)
+    : specificToContact(specificToContact),
+      capabilities(0)
 {
 }
 
 CapabilitiesBase::Private::Private(const RequestableChannelClassSpecList &rccSpecs,
         bool specificToContact)
     : rccSpecs(rccSpecs),
-      specificToContact(specificToContact)
+      specificToContact(specificToContact),
+      capabilities(0)
+{
+}
+
+int CapabilitiesBase::Private::wellKnownCapabilities() const
 {
+    int caps = capabilities.loadAcquire();
+    if (!(caps & Classified)) {
+        caps = classify() | Classified;
+        capabilities.storeRelease(caps);
+    }
+    return caps;
+}
+
+int CapabilitiesBase::Private::classify() const
+{
+    typedef RequestableChannelClassSpec Spec;
+    static const struct {
+        int capability;
+        Spec (*spec)();
+    } wellKnownSpecs[] = {
+        { TextChat, &Spec::textChat },
+        { AudioCall, &Spec::audioCall },
+        { VideoCall, &Spec::videoCall },
+        { VideoCallWithAudio, &Spec::videoCallWithAudioAllowed },
+        { VideoCallWithAudio, &Spec::audioCallWithVideoAllowed },
+        { StreamedMediaCall, &Spec::streamedMediaCall },
+        { StreamedMediaAudioCall, &Spec::streamedMediaAudioCall },
+        { StreamedMediaVideoCall, &Spec::streamedMediaVideoCall },
+        { StreamedMediaVideoCallWithAudio, &Spec::streamedMediaVideoCallWithAudio },
+        { FileTransfer, &Spec::fileTransfer },
+        { TextChatroom, &Spec::textChatroom },
+        { ConferenceStreamedMediaCall, &Spec::conferenceStreamedMediaCall },
+        { ConferenceStreamedMediaCallWithInvitees, &Spec::conferenceStreamedMediaCallWithInvitees },
+        { ConferenceTextChat, &Spec::conferenceTextChat },
+        { ConferenceTextChatWithInvitees, &Spec::conferenceTextChatWithInvitees },
+        { ConferenceTextChatroom, &Spec::conferenceTextChatroom },
+        { ConferenceTextChatroomWithInvitees, &Spec::conferenceTextChatroomWithInvitees },
+        { ContactSearch, &Spec::contactSearch },
+        { ContactSearchWithSpecificServer, &Spec::contactSearchWithSpecificServer },
+        { ContactSearchWithLimit, &Spec::contactSearchWithLimit },
+        { DBusTube, []() { return Spec::dbusTube(); } },
+        { StreamTube, []() { return Spec::streamTube(); } }
+    };
+    const int numWellKnownSpecs = sizeof(wellKnownSpecs) / sizeof(wellKnownSpecs[0]);
+
+    int caps = 0;
+    foreach (const RequestableChannelClassSpec &rccSpec, rccSpecs) {
+        for (int i = 0; i < numWellKnownSpecs; ++i) {
+            if (!(caps & wellKnownSpecs[i].capability) &&
+                rccSpec.supports(wellKnownSpecs[i].spec())) {
+                caps |= wellKnownSpecs[i].capability;
+            }
+        }
+
+        const QString channelType = rccSpec.channelType();
+        if (channelType == TP_QT_IFACE_CHANNEL_TYPE_CALL &&
+            rccSpec.allowsProperty(TP_QT_PROP_CHANNEL_TYPE_CALL_MUTABLE_CONTENTS)) {
+            caps |= UpgradingCall;
+        } else if (channelType == TP_QT_IFACE_CHANNEL_TYPE_STREAMED_MEDIA &&
+            !rccSpec.allowsProperty(TP_QT_PROP_CHANNEL_TYPE_STREAMED_MEDIA_IMMUTABLE_STREAMS)) {
+            // TODO should we test all classes that have channelType
+            //      StreamedMedia or just one is fine?
+            caps |= UpgradingStreamedMediaCall;
+        }
+    }
+    return caps;
 }
 
 /**
@@ -147,6 +224,12 @@ void CapabilitiesBase::updateRequestableChannelClasses(
         const RequestableChannelClassList &rccs)
 {
     mPriv->rccSpecs = RequestableChannelClassSpecList(rccs);
+    mPriv->capabilities.storeRelease(0);
+}
+
+bool CapabilitiesBase::hasWellKnownCapability(WellKnownCapability capability) const
+{
+    return mPriv->wellKnownCapabilities() & capability;
 }
 
 /**
@@ -189,54 +272,27 @@ bool CapabilitiesBase::isSpecificToContact() const
  */
 bool CapabilitiesBase::textChats() const
 {
-    foreach (const RequestableChannelClassSpec &rccSpec, mPriv->rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::textChat())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(TextChat);
 }
 
 bool CapabilitiesBase::audioCalls() const
 {
-    foreach (const RequestableChannelClassSpec &rccSpec, mPriv->rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::audioCall())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(AudioCall);
 }
 
 bool CapabilitiesBase::videoCalls() const
 {
-    foreach (const RequestableChannelClassSpec &rccSpec, mPriv->rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::videoCall())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(VideoCall);
 }
 
 bool CapabilitiesBase::videoCallsWithAudio() const
 {
-    foreach (const RequestableChannelClassSpec &rccSpec, mPriv->rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::videoCallWithAudioAllowed()) ||
-            rccSpec.supports(RequestableChannelClassSpec::audioCallWithVideoAllowed())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(VideoCallWithAudio);
 }
 
 bool CapabilitiesBase::upgradingCalls() const
 {
-    foreach (const RequestableChannelClassSpec &rccSpec, mPriv->rccSpecs) {
-        if (rccSpec.channelType() == TP_QT_IFACE_CHANNEL_TYPE_CALL &&
-            rccSpec.allowsProperty(TP_QT_IFACE_CHANNEL_TYPE_CALL + QLatin1String(".MutableContents"))) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(UpgradingCall);
 }
 
 /**
@@ -254,12 +310,7 @@ bool CapabilitiesBase::upgradingCalls() const
  */
 bool CapabilitiesBase::streamedMediaCalls() const
 {
-    foreach (const RequestableChannelClassSpec &rccSpec, mPriv->rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::streamedMediaCall())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(StreamedMediaCall);
 }
 
 /**
@@ -285,12 +336,7 @@ bool CapabilitiesBase::streamedMediaCalls() const
  */
 bool CapabilitiesBase::streamedMediaAudioCalls() const
 {
-    foreach (const RequestableChannelClassSpec &rccSpec, mPriv->rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::streamedMediaAudioCall())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(StreamedMediaAudioCall);
 }
 
 /**
@@ -305,12 +351,7 @@ bool CapabilitiesBase::streamedMediaAudioCalls() const
  */
 bool CapabilitiesBase::streamedMediaVideoCalls() const
 {
-    foreach (const RequestableChannelClassSpec &rccSpec, mPriv->rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::streamedMediaVideoCall())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(StreamedMediaVideoCall);
 }
 
 /**
@@ -325,12 +366,7 @@ bool CapabilitiesBase::streamedMediaVideoCalls() const
  */
 bool CapabilitiesBase::streamedMediaVideoCallsWithAudio() const
 {
-    foreach (const RequestableChannelClassSpec &rccSpec, mPriv->rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::streamedMediaVideoCallWithAudio())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(StreamedMediaVideoCallWithAudio);
 }
 
 /**
@@ -360,15 +396,7 @@ bool CapabilitiesBase::streamedMediaVideoCallsWithAudio() const
  */
 bool CapabilitiesBase::upgradingStreamedMediaCalls() const
 {
-    foreach (const RequestableChannelClassSpec &rccSpec, mPriv->rccSpecs) {
-        if (rccSpec.channelType() == TP_QT_IFACE_CHANNEL_TYPE_STREAMED_MEDIA &&
-            !rccSpec.allowsProperty(TP_QT_IFACE_CHANNEL_TYPE_STREAMED_MEDIA + QLatin1String(".ImmutableStreams"))) {
-            // TODO should we test all classes that have channelType
-            //      StreamedMedia or just one is fine?
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(UpgradingStreamedMediaCall);
 }
 
 /**
@@ -379,12 +407,7 @@ bool CapabilitiesBase::upgradingStreamedMediaCalls() const
  */
 bool CapabilitiesBase::fileTransfers() const
 {
-    foreach (const RequestableChannelClassSpec &rccSpec, mPriv->rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::fileTransfer())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(FileTransfer);
 }
 
 } // Tp
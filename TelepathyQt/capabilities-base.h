@@ -76,8 +76,37 @@ protected:
 
 private:
     friend class Connection;
+    friend class ConnectionCapabilities;
     friend class Contact;
 
+    enum WellKnownCapability {
+        TextChat = 1 << 0,
+        AudioCall = 1 << 1,
+        VideoCall = 1 << 2,
+        VideoCallWithAudio = 1 << 3,
+        UpgradingCall = 1 << 4,
+        StreamedMediaCall = 1 << 5,
+        StreamedMediaAudioCall = 1 << 6,
+        StreamedMediaVideoCall = 1 << 7,
+        StreamedMediaVideoCallWithAudio = 1 << 8,
+        UpgradingStreamedMediaCall = 1 << 9,
+        FileTransfer = 1 << 10,
+        TextChatroom = 1 << 11,
+        ConferenceStreamedMediaCall = 1 << 12,
+        ConferenceStreamedMediaCallWithInvitees = 1 << 13,
+        ConferenceTextChat = 1 << 14,
+        ConferenceTextChatWithInvitees = 1 << 15,
+        ConferenceTextChatroom = 1 << 16,
+        ConferenceTextChatroomWithInvitees = 1 << 17,
+        ContactSearch = 1 << 18,
+        ContactSearchWithSpecificServer = 1 << 19,
+        ContactSearchWithLimit = 1 << 20,
+        DBusTube = 1 << 21,
+        StreamTube = 1 << 22
+    };
+
+    TP_QT_NO_EXPORT bool hasWellKnownCapability(WellKnownCapability capability) const;
+
     struct Private;
     friend struct Private;
     QSharedDataPointer<Private> mPriv;
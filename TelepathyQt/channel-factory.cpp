@@ -48,6 +48,8 @@
 #include <TelepathyQt/StreamedMediaChannel>
 #include <TelepathyQt/TextChannel>
 
+#include <QHash>
+
 namespace Tp
 {
 
@@ -644,6 +646,48 @@ PendingReady *ChannelFactory::proxy(const ConnectionPtr &connection, const QStri
     return nowHaveProxy(proxy);
 }
 
+/**
+ * Constructs Channel proxies for each of \a channels and begins making them ready.
+ *
+ * This is equivalent to calling proxy() for each of \a channels, but all of the proxies are looked
+ * up from the factory cache in one pass and tracked by a single operation, with the channels
+ * prepared concurrently.
+ *
+ * The proxies can be accessed immediately after this function returns using
+ * PendingProxies::proxies().
+ *
+ * \param connection Proxy for the owning connection of the channels.
+ * \param channels The object paths and immutable properties of the channels.
+ * \return A PendingProxies operation with the proxies in PendingProxies::proxies(), in the same
+ *         order as \a channels.
+ */
+PendingProxies *ChannelFactory::proxies(const ConnectionPtr &connection,
+        const ChannelDetailsList &channels) const
+{
+    QStringList channelPaths;
+    channelPaths.reserve(channels.size());
+    foreach (const ChannelDetails &channelDetails, channels) {
+        channelPaths.append(channelDetails.channel.path());
+    }
+
+    QList<DBusProxyPtr> proxies = cachedProxies(connection->busName(), channelPaths);
+    // A channel listed more than once gets the proxy constructed for its first occurrence
+    QHash<QString, DBusProxyPtr> constructed;
+    for (int i = 0; i < proxies.size(); ++i) {
+        if (proxies[i].isNull()) {
+            DBusProxyPtr &proxy = constructed[channelPaths[i]];
+            if (proxy.isNull()) {
+                const ChannelDetails &channelDetails = channels[i];
+                proxy = constructorFor(ChannelClassSpec(channelDetails.properties))->construct(
+                        connection, channelPaths[i], channelDetails.properties);
+            }
+            proxies[i] = proxy;
+        }
+    }
+
+    return nowHaveProxies(proxies);
+}
+
 /**
  * Transforms well-known names to the corresponding unique names, as is appropriate for Channel
  *
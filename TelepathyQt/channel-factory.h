@@ -42,6 +42,7 @@ namespace Tp
 {
 
 class ChannelClassSpec;
+class PendingProxies;
 
 class TP_QT_EXPORT ChannelFactory : public DBusProxyFactory
 {
@@ -361,6 +362,8 @@ public:
 
     PendingReady *proxy(const ConnectionPtr &connection, const QString &channelPath,
             const QVariantMap &immutableProperties) const;
+    PendingProxies *proxies(const ConnectionPtr &connection,
+            const ChannelDetailsList &channels) const;
 
 protected:
     ChannelFactory(const QDBusConnection &bus);
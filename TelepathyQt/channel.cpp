@@ -64,6 +64,8 @@ struct TP_QT_NO_EXPORT Channel::Private
     ~Private();
 
     static void introspectMain(Private *self);
+    void prefetchProperties();
+    bool needsMainPropertiesIntrospection() const;
     void introspectMainProperties();
     void introspectMainFallbackChannelType();
     void introspectMainFallbackHandle();
@@ -73,11 +75,18 @@ struct TP_QT_NO_EXPORT Channel::Private
     void introspectGroupFallbackMembers();
     void introspectGroupFallbackLocalPendingWithInfo();
     void introspectGroupFallbackSelfHandle();
+    void connectGroupSignals();
     void introspectConference();
+    void connectConferenceSignals();
 
     static void introspectConferenceInitialInviteeContacts(Private *self);
 
     void continueIntrospection();
+    bool takePrefetchedProperties(QDBusPendingCallWatcher **prefetched,
+            void (Channel::*handler)(QDBusPendingCallWatcher *));
+    void dropPrefetchedProperties(QDBusPendingCallWatcher **prefetched);
+    bool isAwaitingPrefetchedProperties(QDBusPendingCallWatcher **prefetched, bool awaiting);
+    void dropAllPrefetchedProperties();
 
     void extractMainProps(const QVariantMap &props);
     void extract0176GroupProps(const QVariantMap &props);
@@ -93,6 +102,8 @@ struct TP_QT_NO_EXPORT Channel::Private
     void processMembersChanged();
     void updateContacts(const QList<ContactPtr> &contacts =
             QList<ContactPtr>());
+    static Contacts contactSet(const QHash<uint, ContactPtr> &contacts,
+            const ContactPtr &excludedContact);
     bool fakeGroupInterfaceIfNeeded();
     void setReady();
 
@@ -140,6 +151,16 @@ struct TP_QT_NO_EXPORT Channel::Private
     // Introspection
     QQueue<void (Private::*)()> introspectQueue;
 
+    // Properties::GetAll calls issued up front when the immutable properties already tell us
+    // which interfaces will need introspecting, so they don't wait for each other
+    QDBusPendingCallWatcher *prefetchedMainProperties;
+    QDBusPendingCallWatcher *prefetchedGroupProperties;
+    QDBusPendingCallWatcher *prefetchedConferenceProperties;
+    // Whether the Group/Conference signals were connected for a prefetch that introspection
+    // hasn't got to yet
+    bool awaitingGroupProperties;
+    bool awaitingConferenceProperties;
+
     // Introspected properties
 
     // Main interface
@@ -208,6 +229,9 @@ struct TP_QT_NO_EXPORT Channel::Private
     bool buildingConferenceChannelRemovedActorContact;
 
     static const QString keyActor;
+    static const QString mainPropertyNames[];
+    static const QString qualifiedMainPropertyNames[];
+    static const unsigned numMainPropertyNames;
 };
 
 struct TP_QT_NO_EXPORT Channel::Private::GroupMembersChangedInfo
@@ -254,6 +278,27 @@ struct TP_QT_NO_EXPORT Channel::Private::ConferenceChannelRemovedInfo
 };
 
 const QString Channel::Private::keyActor(QLatin1String("actor"));
+const QString Channel::Private::mainPropertyNames[] = {
+    QLatin1String("ChannelType"),
+    QLatin1String("Interfaces"),
+    QLatin1String("TargetHandleType"),
+    QLatin1String("TargetHandle"),
+    QLatin1String("TargetID"),
+    QLatin1String("Requested"),
+    QLatin1String("InitiatorHandle"),
+    QLatin1String("InitiatorID")
+};
+const QString Channel::Private::qualifiedMainPropertyNames[] = {
+    TP_QT_PROP_CHANNEL_CHANNEL_TYPE,
+    TP_QT_PROP_CHANNEL_INTERFACES,
+    TP_QT_PROP_CHANNEL_TARGET_HANDLE_TYPE,
+    TP_QT_PROP_CHANNEL_TARGET_HANDLE,
+    TP_QT_PROP_CHANNEL_TARGET_ID,
+    TP_QT_PROP_CHANNEL_REQUESTED,
+    TP_QT_PROP_CHANNEL_INITIATOR_HANDLE,
+    TP_QT_PROP_CHANNEL_INITIATOR_ID
+};
+const unsigned Channel::Private::numMainPropertyNames = 8;
 const QString Channel::Private::GroupMembersChangedInfo::keyChangeReason(
         QLatin1String("change-reason"));
 const QString Channel::Private::GroupMembersChangedInfo::keyMessage(QLatin1String("message"));
@@ -269,6 +314,11 @@ Channel::Private::Private(Channel *parent, const ConnectionPtr &connection,
       group(nullptr),
       conference(nullptr),
       readinessHelper(parent->readinessHelper()),
+      prefetchedMainProperties(nullptr),
+      prefetchedGroupProperties(nullptr),
+      prefetchedConferenceProperties(nullptr),
+      awaitingGroupProperties(false),
+      awaitingConferenceProperties(false),
       targetHandleType(0),
       targetHandle(0),
       requested(false),
@@ -297,6 +347,10 @@ Channel::Private::Private(Channel *parent, const ConnectionPtr &connection,
         parent->connect(connection.data(),
                         SIGNAL(invalidated(Tp::DBusProxy*,QString,QString)),
                         SLOT(onConnectionInvalidated()));
+
+        parent->connect(parent,
+                        SIGNAL(invalidated(Tp::DBusProxy*,QString,QString)),
+                        SLOT(onInvalidated()));
     }
     else {
         warning() << "Connection given as the owner for a Channel was "
@@ -342,6 +396,10 @@ Channel::Private::~Private()
 
 void Channel::Private::introspectMain(Channel::Private *self)
 {
+    // Fire the property fetches we already know we'll need, so they are in flight while we wait
+    // for the connection and for each other, instead of being one round trip each
+    self->prefetchProperties();
+
     // Make sure connection object is ready, as we need to use some methods that
     // are only available after connection object gets ready.
     debug() << "Calling Connection::becomeReady()";
@@ -350,38 +408,61 @@ void Channel::Private::introspectMain(Channel::Private *self)
             SLOT(onConnectionReady(Tp::PendingOperation*)));
 }
 
+void Channel::Private::prefetchProperties()
+{
+    Q_ASSERT(properties != nullptr);
+
+    if (needsMainPropertiesIntrospection()) {
+        debug() << "Calling Properties::GetAll(Channel) up front";
+        prefetchedMainProperties = new QDBusPendingCallWatcher(
+                properties->GetAll(TP_QT_IFACE_CHANNEL), parent);
+    }
+
+    // Only trust the interfaces given in the immutable properties to decide what to prefetch;
+    // if the main GetAll later disagrees the prefetched replies are simply dropped
+    const static QString keyInterfaces(TP_QT_PROP_CHANNEL_INTERFACES);
+    if (!immutableProperties.contains(keyInterfaces)) {
+        return;
+    }
+
+    QStringList interfaces = qdbus_cast<QStringList>(immutableProperties.value(keyInterfaces));
+
+    if (interfaces.contains(TP_QT_IFACE_CHANNEL_INTERFACE_GROUP)) {
+        awaitingGroupProperties = true;
+        connectGroupSignals();
+
+        debug() << "Calling Properties::GetAll(Channel.Interface.Group) up front";
+        prefetchedGroupProperties = new QDBusPendingCallWatcher(
+                properties->GetAll(TP_QT_IFACE_CHANNEL_INTERFACE_GROUP), parent);
+    }
+
+    if (interfaces.contains(TP_QT_IFACE_CHANNEL_INTERFACE_CONFERENCE)) {
+        awaitingConferenceProperties = true;
+        connectConferenceSignals();
+
+        debug() << "Calling Properties::GetAll(Channel.Interface.Conference) up front";
+        prefetchedConferenceProperties = new QDBusPendingCallWatcher(
+                properties->GetAll(TP_QT_IFACE_CHANNEL_INTERFACE_CONFERENCE), parent);
+    }
+}
+
+bool Channel::Private::needsMainPropertiesIntrospection() const
+{
+    for (unsigned i = 0; i < numMainPropertyNames; ++i) {
+        if (!immutableProperties.contains(qualifiedMainPropertyNames[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void Channel::Private::introspectMainProperties()
 {
     QVariantMap props;
-    bool needIntrospectMainProps = false;
-    const unsigned numNames = 8;
-    const static QString names[numNames] = {
-        QLatin1String("ChannelType"),
-        QLatin1String("Interfaces"),
-        QLatin1String("TargetHandleType"),
-        QLatin1String("TargetHandle"),
-        QLatin1String("TargetID"),
-        QLatin1String("Requested"),
-        QLatin1String("InitiatorHandle"),
-        QLatin1String("InitiatorID")
-    };
-    const static QString qualifiedNames[numNames] = {
-        TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType"),
-        TP_QT_IFACE_CHANNEL + QLatin1String(".Interfaces"),
-        TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandleType"),
-        TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandle"),
-        TP_QT_IFACE_CHANNEL + QLatin1String(".TargetID"),
-        TP_QT_IFACE_CHANNEL + QLatin1String(".Requested"),
-        TP_QT_IFACE_CHANNEL + QLatin1String(".InitiatorHandle"),
-        TP_QT_IFACE_CHANNEL + QLatin1String(".InitiatorID")
-    };
-    for (unsigned i = 0; i < numNames; ++i) {
-        const QString &qualified = qualifiedNames[i];
-        if (!immutableProperties.contains(qualified)) {
-            needIntrospectMainProps = true;
-            break;
-        }
-        props.insert(names[i], immutableProperties.value(qualified));
+    bool needIntrospectMainProps = needsMainPropertiesIntrospection();
+    for (unsigned i = 0; !needIntrospectMainProps && i < numMainPropertyNames; ++i) {
+        props.insert(mainPropertyNames[i],
+                immutableProperties.value(qualifiedMainPropertyNames[i]));
     }
 
     // Save Requested and InitiatorHandle here, so even if the GetAll return doesn't have them but
@@ -395,6 +476,11 @@ void Channel::Private::introspectMainProperties()
     }
 
     if (needIntrospectMainProps) {
+        if (takePrefetchedProperties(&prefetchedMainProperties,
+                    &Channel::gotMainProperties)) {
+            return;
+        }
+
         debug() << "Calling Properties::GetAll(Channel)";
         QDBusPendingCallWatcher *watcher =
             new QDBusPendingCallWatcher(
@@ -443,12 +529,34 @@ void Channel::Private::introspectGroup()
 {
     Q_ASSERT(properties != nullptr);
 
-    if (!group) {
-        group = parent->interface<Client::ChannelInterfaceGroupInterface>();
-        Q_ASSERT(group != nullptr);
+    debug() << "Introspecting Channel.Interface.Group for" << parent->objectPath();
+
+    awaitingGroupProperties = false;
+    if (takePrefetchedProperties(&prefetchedGroupProperties,
+                &Channel::gotGroupProperties)) {
+        return;
     }
 
-    debug() << "Introspecting Channel.Interface.Group for" << parent->objectPath();
+    connectGroupSignals();
+
+    debug() << "Calling Properties::GetAll(Channel.Interface.Group)";
+    QDBusPendingCallWatcher *watcher =
+        new QDBusPendingCallWatcher(
+                properties->GetAll(TP_QT_IFACE_CHANNEL_INTERFACE_GROUP),
+                parent);
+    parent->connect(watcher,
+                    SIGNAL(finished(QDBusPendingCallWatcher*)),
+                    SLOT(gotGroupProperties(QDBusPendingCallWatcher*)));
+}
+
+void Channel::Private::connectGroupSignals()
+{
+    if (group) {
+        return;
+    }
+
+    group = parent->interface<Client::ChannelInterfaceGroupInterface>();
+    Q_ASSERT(group != nullptr);
 
     parent->connect(group,
                     SIGNAL(GroupFlagsChanged(uint,uint)),
@@ -478,15 +586,6 @@ void Channel::Private::introspectGroup()
     parent->connect(group,
                     SIGNAL(SelfHandleChanged(uint)),
                     SLOT(onSelfHandleChanged(uint)));
-
-    debug() << "Calling Properties::GetAll(Channel.Interface.Group)";
-    QDBusPendingCallWatcher *watcher =
-        new QDBusPendingCallWatcher(
-                properties->GetAll(TP_QT_IFACE_CHANNEL_INTERFACE_GROUP),
-                parent);
-    parent->connect(watcher,
-                    SIGNAL(finished(QDBusPendingCallWatcher*)),
-                    SLOT(gotGroupProperties(QDBusPendingCallWatcher*)));
 }
 
 void Channel::Private::introspectGroupFallbackFlags()
@@ -541,21 +640,18 @@ void Channel::Private::introspectGroupFallbackSelfHandle()
 void Channel::Private::introspectConference()
 {
     Q_ASSERT(properties != nullptr);
-    Q_ASSERT(conference == nullptr);
 
     debug() << "Introspecting Conference interface";
-    conference = parent->interface<Client::ChannelInterfaceConferenceInterface>();
-    Q_ASSERT(conference != nullptr);
 
     introspectingConference = true;
 
-    debug() << "Connecting to Channel.Interface.Conference.ChannelMerged/Removed";
-    parent->connect(conference,
-            SIGNAL(ChannelMerged(QDBusObjectPath,uint,QVariantMap)),
-            SLOT(onConferenceChannelMerged(QDBusObjectPath,uint,QVariantMap)));
-    parent->connect(conference,
-            SIGNAL(ChannelRemoved(QDBusObjectPath,QVariantMap)),
-            SLOT(onConferenceChannelRemoved(QDBusObjectPath,QVariantMap)));
+    awaitingConferenceProperties = false;
+    if (takePrefetchedProperties(&prefetchedConferenceProperties,
+                &Channel::gotConferenceProperties)) {
+        return;
+    }
+
+    connectConferenceSignals();
 
     debug() << "Calling Properties::GetAll(Channel.Interface.Conference)";
     QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(
@@ -566,6 +662,24 @@ void Channel::Private::introspectConference()
             SLOT(gotConferenceProperties(QDBusPendingCallWatcher*)));
 }
 
+void Channel::Private::connectConferenceSignals()
+{
+    if (conference) {
+        return;
+    }
+
+    conference = parent->interface<Client::ChannelInterfaceConferenceInterface>();
+    Q_ASSERT(conference != nullptr);
+
+    debug() << "Connecting to Channel.Interface.Conference.ChannelMerged/Removed";
+    parent->connect(conference,
+            SIGNAL(ChannelMerged(QDBusObjectPath,uint,QVariantMap)),
+            SLOT(onConferenceChannelMerged(QDBusObjectPath,uint,QVariantMap)));
+    parent->connect(conference,
+            SIGNAL(ChannelRemoved(QDBusObjectPath,QVariantMap)),
+            SLOT(onConferenceChannelRemoved(QDBusObjectPath,QVariantMap)));
+}
+
 void Channel::Private::introspectConferenceInitialInviteeContacts(Private *self)
 {
     if (!self->conferenceInitialInviteeHandles.isEmpty()) {
@@ -599,6 +713,53 @@ void Channel::Private::continueIntrospection()
     }
 }
 
+bool Channel::Private::takePrefetchedProperties(QDBusPendingCallWatcher **prefetched,
+        void (Channel::*handler)(QDBusPendingCallWatcher *))
+{
+    QDBusPendingCallWatcher *watcher = *prefetched;
+    if (!watcher) {
+        return false;
+    }
+
+    *prefetched = nullptr;
+
+    if (watcher->isFinished()) {
+        // The reply may already be in while its finished() signal is still queued, but as
+        // nothing is connected to it yet, handing it over directly can't process it twice
+        (parent->*handler)(watcher);
+    } else {
+        QObject::connect(watcher, &QDBusPendingCallWatcher::finished, parent, handler);
+    }
+    return true;
+}
+
+void Channel::Private::dropPrefetchedProperties(QDBusPendingCallWatcher **prefetched)
+{
+    delete *prefetched;
+    *prefetched = nullptr;
+}
+
+bool Channel::Private::isAwaitingPrefetchedProperties(QDBusPendingCallWatcher **prefetched,
+        bool awaiting)
+{
+    // Signals received before the reply are already reflected in it, but one received after it
+    // means the reply is out of date by the time we get to use it, so ask again at that point
+    if (*prefetched && (*prefetched)->isFinished()) {
+        debug() << "Dropping prefetched properties made stale by a change signal";
+        dropPrefetchedProperties(prefetched);
+    }
+
+    // Either way, the properties introspection will use still have to come and include the change
+    return awaiting;
+}
+
+void Channel::Private::dropAllPrefetchedProperties()
+{
+    dropPrefetchedProperties(&prefetchedMainProperties);
+    dropPrefetchedProperties(&prefetchedGroupProperties);
+    dropPrefetchedProperties(&prefetchedConferenceProperties);
+}
+
 void Channel::Private::extractMainProps(const QVariantMap &props)
 {
     const static QString keyChannelType(QLatin1String("ChannelType"));
@@ -963,6 +1124,22 @@ void Channel::Private::processMembersChanged()
     buildContacts();
 }
 
+Contacts Channel::Private::contactSet(const QHash<uint, ContactPtr> &contacts,
+        const ContactPtr &excludedContact)
+{
+    // Fill the set straight from the hash: going through values() would take and drop an extra
+    // reference to every contact
+    Contacts ret;
+    ret.reserve(contacts.size());
+    for (QHash<uint, ContactPtr>::const_iterator i = contacts.constBegin();
+            i != contacts.constEnd(); ++i) {
+        if (!excludedContact || i.value() != excludedContact) {
+            ret.insert(i.value());
+        }
+    }
+    return ret;
+}
+
 void Channel::Private::updateContacts(const QList<ContactPtr> &contacts)
 {
     Contacts groupContactsAdded;
@@ -974,7 +1151,7 @@ void Channel::Private::updateContacts(const QList<ContactPtr> &contacts)
     debug() << "Entering Chan::Priv::updateContacts() with" << contacts.size() << "contacts";
 
     // FIXME: simplify. Some duplication of logic present.
-    foreach (ContactPtr contact, contacts) {
+    foreach (const ContactPtr &contact, contacts) {
         uint handle = contact->handle()[0];
         if (pendingGroupMembers.contains(handle)) {
             groupContactsAdded.insert(contact);
@@ -1027,7 +1204,7 @@ void Channel::Private::updateContacts(const QList<ContactPtr> &contacts)
 
     // FIXME: This shouldn't be needed. Clearer would be to first scan for the actor being present
     // in the contacts supplied.
-    foreach (ContactPtr contact, contacts) {
+    foreach (const ContactPtr &contact, contacts) {
         uint handle = contact->handle()[0];
         if (groupLocalPendingContactsChangeInfo.contains(handle)) {
             groupLocalPendingContactsChangeInfo[handle] =
@@ -1163,6 +1340,9 @@ void Channel::Private::setReady()
             "tracked:" << (groupIsSelfHandleTracked ? "yes" : "no");
     }
 
+    // Drop prefetched replies for interfaces the channel turned out not to have after all
+    dropAllPrefetchedProperties();
+
     readinessHelper->setIntrospectCompleted(FeatureCore, true);
 }
 
@@ -1626,42 +1806,42 @@ QVariantMap Channel::immutableProperties() const
     if (isReady(Channel::FeatureCore)) {
         QString key;
 
-        key = TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType");
+        key = TP_QT_PROP_CHANNEL_CHANNEL_TYPE;
         if (!mPriv->immutableProperties.contains(key)) {
             mPriv->immutableProperties.insert(key, mPriv->channelType);
         }
 
-        key = TP_QT_IFACE_CHANNEL + QLatin1String(".Interfaces");
+        key = TP_QT_PROP_CHANNEL_INTERFACES;
         if (!mPriv->immutableProperties.contains(key)) {
             mPriv->immutableProperties.insert(key, interfaces());
         }
 
-        key = TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandleType");
+        key = TP_QT_PROP_CHANNEL_TARGET_HANDLE_TYPE;
         if (!mPriv->immutableProperties.contains(key)) {
             mPriv->immutableProperties.insert(key, mPriv->targetHandleType);
         }
 
-        key = TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandle");
+        key = TP_QT_PROP_CHANNEL_TARGET_HANDLE;
         if (!mPriv->immutableProperties.contains(key)) {
             mPriv->immutableProperties.insert(key, mPriv->targetHandle);
         }
 
-        key = TP_QT_IFACE_CHANNEL + QLatin1String(".TargetID");
+        key = TP_QT_PROP_CHANNEL_TARGET_ID;
         if (!mPriv->immutableProperties.contains(key)) {
             mPriv->immutableProperties.insert(key, mPriv->targetId);
         }
 
-        key = TP_QT_IFACE_CHANNEL + QLatin1String(".Requested");
+        key = TP_QT_PROP_CHANNEL_REQUESTED;
         if (!mPriv->immutableProperties.contains(key)) {
             mPriv->immutableProperties.insert(key, mPriv->requested);
         }
 
-        key = TP_QT_IFACE_CHANNEL + QLatin1String(".InitiatorHandle");
+        key = TP_QT_PROP_CHANNEL_INITIATOR_HANDLE;
         if (!mPriv->immutableProperties.contains(key)) {
             mPriv->immutableProperties.insert(key, mPriv->initiatorHandle);
         }
 
-        key = TP_QT_IFACE_CHANNEL + QLatin1String(".InitiatorID");
+        key = TP_QT_PROP_CHANNEL_INITIATOR_ID;
         if (!mPriv->immutableProperties.contains(key) && !mPriv->initiatorContact.isNull()) {
             mPriv->immutableProperties.insert(key, mPriv->initiatorContact->id());
         }
@@ -2374,11 +2554,8 @@ Contacts Channel::groupContacts(bool includeSelfContact) const
         warning() << "Channel::groupMembers() used channel not ready";
     }
 
-    Contacts ret = mPriv->groupContacts.values().toSet();
-    if (!includeSelfContact) {
-        ret.remove(groupSelfContact());
-    }
-    return ret;
+    return Private::contactSet(mPriv->groupContacts,
+            includeSelfContact ? ContactPtr() : groupSelfContact());
 }
 
 /**
@@ -2405,11 +2582,8 @@ Contacts Channel::groupLocalPendingContacts(bool includeSelfContact) const
         warning() << "Channel::groupLocalPendingContacts() used with no group interface";
     }
 
-    Contacts ret = mPriv->groupLocalPendingContacts.values().toSet();
-    if (!includeSelfContact) {
-        ret.remove(groupSelfContact());
-    }
-    return ret;
+    return Private::contactSet(mPriv->groupLocalPendingContacts,
+            includeSelfContact ? ContactPtr() : groupSelfContact());
 }
 
 /**
@@ -2437,11 +2611,8 @@ Contacts Channel::groupRemotePendingContacts(bool includeSelfContact) const
             "group interface";
     }
 
-    Contacts ret = mPriv->groupRemotePendingContacts.values().toSet();
-    if (!includeSelfContact) {
-        ret.remove(groupSelfContact());
-    }
-    return ret;
+    return Private::contactSet(mPriv->groupRemotePendingContacts,
+            includeSelfContact ? ContactPtr() : groupSelfContact());
 }
 
 /**
@@ -2864,6 +3035,8 @@ void Channel::gotMainProperties(QDBusPendingCallWatcher *watcher)
     QDBusPendingReply<QVariantMap> reply = *watcher;
     QVariantMap props;
 
+    watcher->deleteLater();
+
     if (!reply.isError()) {
         debug() << "Got reply to Properties::GetAll(Channel)";
         props = reply.value();
@@ -2978,6 +3151,12 @@ void Channel::onConnectionReady(PendingOperation *op)
     mPriv->introspectMainProperties();
 }
 
+void Channel::onInvalidated()
+{
+    // Introspection won't get to the prefetched replies anymore
+    mPriv->dropAllPrefetchedProperties();
+}
+
 void Channel::onConnectionInvalidated()
 {
     debug() << "Owning connection died leaving an orphan Channel, "
@@ -2991,6 +3170,8 @@ void Channel::gotGroupProperties(QDBusPendingCallWatcher *watcher)
     QDBusPendingReply<QVariantMap> reply = *watcher;
     QVariantMap props;
 
+    watcher->deleteLater();
+
     if (!reply.isError()) {
         debug() << "Got reply to Properties::GetAll(Channel.Interface.Group)";
         props = reply.value();
@@ -3125,6 +3306,11 @@ void Channel::onGroupFlagsChanged(uint added, uint removed)
     debug().nospace() << "Got Channel.Interface.Group::GroupFlagsChanged(" <<
         hex << added << ", " << removed << ")";
 
+    if (mPriv->isAwaitingPrefetchedProperties(&mPriv->prefetchedGroupProperties,
+                mPriv->awaitingGroupProperties)) {
+        return;
+    }
+
     added &= ~(mPriv->groupFlags);
     removed &= mPriv->groupFlags;
 
@@ -3167,6 +3353,11 @@ void Channel::onMembersChanged(const QString &message,
         const UIntList &localPending, const UIntList &remotePending,
         uint actor, uint reason)
 {
+    if (mPriv->isAwaitingPrefetchedProperties(&mPriv->prefetchedGroupProperties,
+                mPriv->awaitingGroupProperties)) {
+        return;
+    }
+
     // Ignore the signal if we're using the MCD signal to not duplicate events
     if (mPriv->usingMembersChangedDetailed) {
         return;
@@ -3198,6 +3389,11 @@ void Channel::onMembersChangedDetailed(
         const UIntList &localPending, const UIntList &remotePending,
         const QVariantMap &details)
 {
+    if (mPriv->isAwaitingPrefetchedProperties(&mPriv->prefetchedGroupProperties,
+                mPriv->awaitingGroupProperties)) {
+        return;
+    }
+
     // Ignore the signal if we aren't (yet) using MCD to not duplicate events
     if (!mPriv->usingMembersChangedDetailed) {
         return;
@@ -3284,6 +3480,11 @@ void Channel::onHandleOwnersChanged(const HandleOwnerMap &added,
     debug() << "Got Channel.Interface.Group::HandleOwnersChanged with" <<
         added.size() << "added," << removed.size() << "removed";
 
+    if (mPriv->isAwaitingPrefetchedProperties(&mPriv->prefetchedGroupProperties,
+                mPriv->awaitingGroupProperties)) {
+        return;
+    }
+
     if (!mPriv->groupAreHandleOwnersAvailable) {
         debug() << "Still waiting for initial handle owners, so ignoring "
             "delta signal...";
@@ -3329,6 +3530,11 @@ void Channel::onSelfHandleChanged(uint selfHandle)
 {
     debug().nospace() << "Got Channel.Interface.Group::SelfHandleChanged";
 
+    if (mPriv->isAwaitingPrefetchedProperties(&mPriv->prefetchedGroupProperties,
+                mPriv->awaitingGroupProperties)) {
+        return;
+    }
+
     if (selfHandle != mPriv->groupSelfHandle) {
         mPriv->groupSelfHandle = selfHandle;
         debug() << " Emitting groupSelfHandleChanged with new self handle" <<
@@ -3344,6 +3550,8 @@ void Channel::gotConferenceProperties(QDBusPendingCallWatcher *watcher)
     QDBusPendingReply<QVariantMap> reply = *watcher;
     QVariantMap props;
 
+    watcher->deleteLater();
+
     mPriv->introspectingConference = false;
 
     if (!reply.isError()) {
@@ -3438,6 +3646,11 @@ void Channel::gotConferenceInitialInviteeContacts(PendingOperation *op)
 void Channel::onConferenceChannelMerged(const QDBusObjectPath &channelPath,
         uint channelSpecificHandle, const QVariantMap &properties)
 {
+    if (mPriv->isAwaitingPrefetchedProperties(&mPriv->prefetchedConferenceProperties,
+                mPriv->awaitingConferenceProperties)) {
+        return;
+    }
+
     if (mPriv->conferenceChannels.contains(channelPath.path())) {
         return;
     }
@@ -3465,6 +3678,11 @@ void Channel::onConferenceChannelMerged(const QDBusObjectPath &channelPath)
 void Channel::onConferenceChannelRemoved(const QDBusObjectPath &channelPath,
         const QVariantMap &details)
 {
+    if (mPriv->isAwaitingPrefetchedProperties(&mPriv->prefetchedConferenceProperties,
+                mPriv->awaitingConferenceProperties)) {
+        return;
+    }
+
     if (!mPriv->conferenceChannels.contains(channelPath.path())) {
         return;
     }
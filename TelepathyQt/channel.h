@@ -207,6 +207,7 @@ private Q_SLOTS:
 
     TP_QT_NO_EXPORT void onConnectionReady(Tp::PendingOperation *op);
     TP_QT_NO_EXPORT void onConnectionInvalidated();
+    TP_QT_NO_EXPORT void onInvalidated();
 
     TP_QT_NO_EXPORT void gotGroupProperties(QDBusPendingCallWatcher *watcher);
     TP_QT_NO_EXPORT void gotGroupFlags(QDBusPendingCallWatcher *watcher);
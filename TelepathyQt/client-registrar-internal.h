@@ -295,6 +295,7 @@ private:
         ConnectionPtr conn;
         QList<ChannelPtr> chans;
         QList<ChannelRequestPtr> chanReqs;
+        ObjectPathList requestsSatisfied;
         QDateTime time;
         AbstractClientHandler::HandlerInfo handlerInfo;
     };
@@ -38,6 +38,7 @@
 #include <TelepathyQt/Connection>
 #include <TelepathyQt/MethodInvocationContext>
 #include <TelepathyQt/PendingComposite>
+#include <TelepathyQt/PendingProxies>
 #include <TelepathyQt/PendingReady>
 
 namespace Tp
@@ -145,13 +146,11 @@ void ClientObserverAdaptor::ObserveChannels(const QDBusObjectPath &accountPath,
     invocation->conn = ConnectionPtr::qObjectCast(connReady->proxy());
     readyOps.append(connReady);
 
-    foreach (const ChannelDetails &channelDetails, channelDetailsList) {
-        PendingReady *chanReady = chanFactory->proxy(invocation->conn,
-                channelDetails.channel.path(), channelDetails.properties);
-        ChannelPtr channel = ChannelPtr::qObjectCast(chanReady->proxy());
-        invocation->chans.append(channel);
-        readyOps.append(chanReady);
+    PendingProxies *chansReady = chanFactory->proxies(invocation->conn, channelDetailsList);
+    foreach (const DBusProxyPtr &proxy, chansReady->proxies()) {
+        invocation->chans.append(ChannelPtr::qObjectCast(proxy));
     }
+    readyOps.append(chansReady);
 
     // Yes, we don't give the choice of making CDO and CR ready or not - however, readifying them is
     // 0-1 D-Bus calls each, for CR mostly 0 - and their constructors start making them ready
@@ -299,12 +298,11 @@ void ClientApproverAdaptor::AddDispatchOperation(const Tp::ChannelDetailsList &c
 
     SharedPtr<InvocationData> invocation(new InvocationData);
 
-    foreach (const ChannelDetails &channelDetails, channelDetailsList) {
-        PendingReady *chanReady = chanFactory->proxy(connection, channelDetails.channel.path(),
-                channelDetails.properties);
-        invocation->chans.append(ChannelPtr::qObjectCast(chanReady->proxy()));
-        readyOps.append(chanReady);
+    PendingProxies *chansReady = chanFactory->proxies(connection, channelDetailsList);
+    foreach (const DBusProxyPtr &proxy, chansReady->proxies()) {
+        invocation->chans.append(ChannelPtr::qObjectCast(proxy));
     }
+    readyOps.append(chansReady);
 
     invocation->dispatchOp = ChannelDispatchOperation::create(mBus,
             dispatchOperationPath.path(), properties, invocation->chans, accFactory, connFactory,
@@ -406,11 +404,16 @@ void ClientHandlerAdaptor::HandleChannels(const QDBusObjectPath &accountPath,
     SharedPtr<InvocationData> invocation(new InvocationData());
     QList<PendingOperation *> readyOps;
 
-    RequestTemporaryHandler *tempHandler = dynamic_cast<RequestTemporaryHandler *>(mClient);
+    RequestTemporaryHandlerHost *tempHandler =
+        dynamic_cast<RequestTemporaryHandlerHost *>(mClient);
     if (tempHandler) {
         debug() << "  This is a temporary handler for the Request & Handle API,"
             << "giving an early signal of the invocation";
-        tempHandler->setDBusHandlerInvoked();
+        QStringList channelPaths;
+        foreach (const ChannelDetails &channelDetails, channelDetailsList) {
+            channelPaths.append(channelDetails.channel.path());
+        }
+        tempHandler->setDBusHandlerInvoked(channelPaths, requestsSatisfied);
     }
 
     PendingReady *accReady = accFactory->proxy(TP_QT_ACCOUNT_MANAGER_BUS_NAME,
@@ -428,14 +431,13 @@ void ClientHandlerAdaptor::HandleChannels(const QDBusObjectPath &accountPath,
     invocation->conn = ConnectionPtr::qObjectCast(connReady->proxy());
     readyOps.append(connReady);
 
-    foreach (const ChannelDetails &channelDetails, channelDetailsList) {
-        PendingReady *chanReady = chanFactory->proxy(invocation->conn,
-                channelDetails.channel.path(), channelDetails.properties);
-        ChannelPtr channel = ChannelPtr::qObjectCast(chanReady->proxy());
-        invocation->chans.append(channel);
-        readyOps.append(chanReady);
+    PendingProxies *chansReady = chanFactory->proxies(invocation->conn, channelDetailsList);
+    foreach (const DBusProxyPtr &proxy, chansReady->proxies()) {
+        invocation->chans.append(ChannelPtr::qObjectCast(proxy));
     }
+    readyOps.append(chansReady);
 
+    invocation->requestsSatisfied = requestsSatisfied;
     invocation->handlerInfo = AbstractClientHandler::HandlerInfo(handlerInfo);
 
     ObjectImmutablePropertiesMap reqPropsMap = qdbus_cast<ObjectImmutablePropertiesMap>(
@@ -506,10 +508,16 @@ void ClientHandlerAdaptor::onReadyOpFinished(Tp::PendingOperation *op)
         SharedPtr<InvocationData> invocation = mInvocations.takeFirst();
 
         if (!invocation->error.isEmpty()) {
-            RequestTemporaryHandler *tempHandler = dynamic_cast<RequestTemporaryHandler *>(mClient);
+            RequestTemporaryHandlerHost *tempHandler =
+                dynamic_cast<RequestTemporaryHandlerHost *>(mClient);
             if (tempHandler) {
                 debug() << "  This is a temporary handler for the Request & Handle API, indicating failure";
-                tempHandler->setDBusHandlerErrored(invocation->error, invocation->message);
+                QStringList channelPaths;
+                foreach (const ChannelPtr &channel, invocation->chans) {
+                    channelPaths.append(channel->objectPath());
+                }
+                tempHandler->setDBusHandlerErrored(channelPaths, invocation->requestsSatisfied,
+                        invocation->error, invocation->message);
             }
 
             // We guarantee that the proxies were ready - so we can't invoke the client if they
@@ -86,13 +86,7 @@ ConnectionCapabilities::~ConnectionCapabilities()
  */
 bool ConnectionCapabilities::textChatrooms() const
 {
-    RequestableChannelClassSpecList rccSpecs = allClassSpecs();
-    foreach (const RequestableChannelClassSpec &rccSpec, rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::textChatroom())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(TextChatroom);
 }
 
 /**
@@ -102,13 +96,7 @@ bool ConnectionCapabilities::textChatrooms() const
  */
 bool ConnectionCapabilities::conferenceStreamedMediaCalls() const
 {
-    RequestableChannelClassSpecList rccSpecs = allClassSpecs();
-    foreach (const RequestableChannelClassSpec &rccSpec, rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::conferenceStreamedMediaCall())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(ConferenceStreamedMediaCall);
 }
 
 /**
@@ -125,13 +113,7 @@ bool ConnectionCapabilities::conferenceStreamedMediaCalls() const
  */
 bool ConnectionCapabilities::conferenceStreamedMediaCallsWithInvitees() const
 {
-    RequestableChannelClassSpecList rccSpecs = allClassSpecs();
-    foreach (const RequestableChannelClassSpec &rccSpec, rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::conferenceStreamedMediaCallWithInvitees())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(ConferenceStreamedMediaCallWithInvitees);
 }
 
 /**
@@ -141,13 +123,7 @@ bool ConnectionCapabilities::conferenceStreamedMediaCallsWithInvitees() const
  */
 bool ConnectionCapabilities::conferenceTextChats() const
 {
-    RequestableChannelClassSpecList rccSpecs = allClassSpecs();
-    foreach (const RequestableChannelClassSpec &rccSpec, rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::conferenceTextChat())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(ConferenceTextChat);
 }
 
 /**
@@ -164,13 +140,7 @@ bool ConnectionCapabilities::conferenceTextChats() const
  */
 bool ConnectionCapabilities::conferenceTextChatsWithInvitees() const
 {
-    RequestableChannelClassSpecList rccSpecs = allClassSpecs();
-    foreach (const RequestableChannelClassSpec &rccSpec, rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::conferenceTextChatWithInvitees())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(ConferenceTextChatWithInvitees);
 }
 
 /**
@@ -180,13 +150,7 @@ bool ConnectionCapabilities::conferenceTextChatsWithInvitees() const
  */
 bool ConnectionCapabilities::conferenceTextChatrooms() const
 {
-    RequestableChannelClassSpecList rccSpecs = allClassSpecs();
-    foreach (const RequestableChannelClassSpec &rccSpec, rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::conferenceTextChatroom())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(ConferenceTextChatroom);
 }
 
 /**
@@ -203,13 +167,7 @@ bool ConnectionCapabilities::conferenceTextChatrooms() const
  */
 bool ConnectionCapabilities::conferenceTextChatroomsWithInvitees() const
 {
-    RequestableChannelClassSpecList rccSpecs = allClassSpecs();
-    foreach (const RequestableChannelClassSpec &rccSpec, rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::conferenceTextChatroomWithInvitees())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(ConferenceTextChatroomWithInvitees);
 }
 
 /**
@@ -219,13 +177,7 @@ bool ConnectionCapabilities::conferenceTextChatroomsWithInvitees() const
  */
 bool ConnectionCapabilities::contactSearches() const
 {
-    RequestableChannelClassSpecList rccSpecs = allClassSpecs();
-    foreach (const RequestableChannelClassSpec &rccSpec, rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::contactSearch())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(ContactSearch);
 }
 
 /**
@@ -235,13 +187,7 @@ bool ConnectionCapabilities::contactSearches() const
  */
 bool ConnectionCapabilities::contactSearchesWithSpecificServer() const
 {
-    RequestableChannelClassSpecList rccSpecs = allClassSpecs();
-    foreach (const RequestableChannelClassSpec &rccSpec, rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::contactSearchWithSpecificServer())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(ContactSearchWithSpecificServer);
 }
 
 /**
@@ -251,13 +197,7 @@ bool ConnectionCapabilities::contactSearchesWithSpecificServer() const
  */
 bool ConnectionCapabilities::contactSearchesWithLimit() const
 {
-    RequestableChannelClassSpecList rccSpecs = allClassSpecs();
-    foreach (const RequestableChannelClassSpec &rccSpec, rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::contactSearchWithLimit())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(ContactSearchWithLimit);
 }
 
 /**
@@ -267,13 +207,7 @@ bool ConnectionCapabilities::contactSearchesWithLimit() const
  */
 bool ConnectionCapabilities::dbusTubes() const
 {
-    RequestableChannelClassSpecList rccSpecs = allClassSpecs();
-    foreach (const RequestableChannelClassSpec &rccSpec, rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::dbusTube())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(DBusTube);
 }
 
 /**
@@ -283,13 +217,7 @@ bool ConnectionCapabilities::dbusTubes() const
  */
 bool ConnectionCapabilities::streamTubes() const
 {
-    RequestableChannelClassSpecList rccSpecs = allClassSpecs();
-    foreach (const RequestableChannelClassSpec &rccSpec, rccSpecs) {
-        if (rccSpec.supports(RequestableChannelClassSpec::streamTube())) {
-            return true;
-        }
-    }
-    return false;
+    return hasWellKnownCapability(StreamTube);
 }
 
 } // Tp
@@ -71,6 +71,7 @@ struct TP_QT_NO_EXPORT Connection::Private
     void introspectMainFallbackStatus();
     void introspectMainFallbackInterfaces();
     void introspectMainFallbackSelfHandle();
+    void introspectInterfaceProperties();
     void introspectCapabilities();
     void introspectContactAttributeInterfaces();
     static void introspectSelfContact(Private *self);
@@ -110,7 +111,12 @@ struct TP_QT_NO_EXPORT Connection::Private
     ReadinessHelper *readinessHelper;
 
     // Introspection
+    // Fallback steps which have to be run one after another, before we know the interfaces
     QQueue<void (Private::*)()> introspectMainQueue;
+    // Calls belonging to FeatureCore which haven't replied yet
+    uint introspectMainCallsInFlight;
+    // Whether the calls depending only on the interfaces list have been issued
+    bool introspectedInterfaceProperties;
 
     // FeatureCore
     // keep pendingStatus and pendingStatusReason until we emit statusChanged
@@ -203,6 +209,8 @@ Connection::Private::Private(Connection *parent,
       properties(parent->interface<Client::DBus::PropertiesInterface>()),
       simplePresence(nullptr),
       readinessHelper(parent->readinessHelper()),
+      introspectMainCallsInFlight(0),
+      introspectedInterfaceProperties(false),
       introspectingConnected(false),
       pendingStatus((uint) -1),
       pendingStatusReason(ConnectionStatusReasonNoneSpecified),
@@ -402,6 +410,9 @@ void Connection::Private::init()
 
 void Connection::Private::introspectMain(Connection::Private *self)
 {
+    self->introspectMainCallsInFlight = 1;
+    self->introspectedInterfaceProperties = false;
+
     debug() << "Calling Properties::GetAll(Connection)";
     QDBusPendingCallWatcher *watcher =
         new QDBusPendingCallWatcher(
@@ -445,6 +456,26 @@ void Connection::Private::introspectMainFallbackSelfHandle()
             SLOT(gotSelfHandle(QDBusPendingCallWatcher*)));
 }
 
+void Connection::Private::introspectInterfaceProperties()
+{
+    // Everything from here on only depends on the interfaces list, so issue all of it at once
+    // and complete FeatureCore when the last reply lands, rather than one round trip after another
+    QList<void (Private::*)()> calls;
+
+    if (parent->hasInterface(TP_QT_IFACE_CONNECTION_INTERFACE_REQUESTS)) {
+        calls << &Private::introspectCapabilities;
+    }
+
+    if (parent->hasInterface(TP_QT_IFACE_CONNECTION_INTERFACE_CONTACTS)) {
+        calls << &Private::introspectContactAttributeInterfaces;
+    }
+
+    introspectMainCallsInFlight = calls.size();
+    foreach (void (Private::*call)(), calls) {
+        (this->*call)();
+    }
+}
+
 void Connection::Private::introspectCapabilities()
 {
     debug() << "Retrieving capabilities";
@@ -565,10 +596,22 @@ void Connection::Private::continueMainIntrospection()
         return;
     }
 
-    if (introspectMainQueue.isEmpty()) {
-        readinessHelper->setIntrospectCompleted(FeatureCore, true);
-    } else {
+    Q_ASSERT(introspectMainCallsInFlight > 0);
+    if (--introspectMainCallsInFlight > 0) {
+        // Other calls issued together with this one are still to reply
+        return;
+    }
+
+    if (!introspectMainQueue.isEmpty()) {
+        introspectMainCallsInFlight = 1;
         (this->*(introspectMainQueue.dequeue()))();
+    } else if (!introspectedInterfaceProperties) {
+        introspectedInterfaceProperties = true;
+        introspectInterfaceProperties();
+    }
+
+    if (introspectMainCallsInFlight == 0) {
+        readinessHelper->setIntrospectCompleted(FeatureCore, true);
     }
 }
 
@@ -582,6 +625,7 @@ void Connection::Private::setCurrentStatus(uint status)
     // pending introspect ops from our local introspection queue when it's waiting for us.
 
     introspectMainQueue.clear();
+    introspectedInterfaceProperties = true;
 
     if (introspectingConnected) {
         // On the other hand, we have to finish the Connected introspection for now, as
@@ -1570,16 +1614,8 @@ void Connection::gotMainProperties(QDBusPendingCallWatcher *watcher)
         mPriv->immortalHandles = qdbus_cast<bool>(props[QLatin1String("HasImmortalHandles")]);
     }
 
-    if (hasInterface(TP_QT_IFACE_CONNECTION_INTERFACE_REQUESTS)) {
-        mPriv->introspectMainQueue.enqueue(
-                &Private::introspectCapabilities);
-    }
-
-    if (hasInterface(TP_QT_IFACE_CONNECTION_INTERFACE_CONTACTS)) {
-        mPriv->introspectMainQueue.enqueue(
-                &Private::introspectContactAttributeInterfaces);
-    }
-
+    // Capabilities and contact attribute interfaces are fetched concurrently by
+    // continueMainIntrospection() once the fallbacks, if any, have told us the interfaces
     mPriv->continueMainIntrospection();
 
     watcher->deleteLater();
@@ -1866,7 +1902,7 @@ PendingChannel *ConnectionLowlevel::createChannel(const QVariantMap &request,
                 QLatin1String("Connection does not support Requests Interface"));
     }
 
-    if (!request.contains(TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType"))) {
+    if (!request.contains(TP_QT_PROP_CHANNEL_CHANNEL_TYPE)) {
         return new PendingChannel(conn,
                 TP_QT_ERROR_INVALID_ARGUMENT,
                 QLatin1String("Invalid 'request' argument"));
@@ -1937,7 +1973,7 @@ PendingChannel *ConnectionLowlevel::ensureChannel(const QVariantMap &request,
                 QLatin1String("Connection does not support Requests Interface"));
     }
 
-    if (!request.contains(TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType"))) {
+    if (!request.contains(TP_QT_PROP_CHANNEL_CHANNEL_TYPE)) {
         return new PendingChannel(conn,
                 TP_QT_ERROR_INVALID_ARGUMENT,
                 QLatin1String("Invalid 'request' argument"));
@@ -114,10 +114,8 @@ QStringList ContactCapabilities::dbusTubeServices() const
     foreach (const RequestableChannelClassSpec &rccSpec, rccSpecs) {
         if (rccSpec.channelType() == TP_QT_IFACE_CHANNEL_TYPE_DBUS_TUBE &&
             rccSpec.targetHandleType() == HandleTypeContact &&
-            rccSpec.hasFixedProperty(
-                    TP_QT_IFACE_CHANNEL_TYPE_DBUS_TUBE + QLatin1String(".ServiceName"))) {
-            ret << rccSpec.fixedProperty(
-                    TP_QT_IFACE_CHANNEL_TYPE_DBUS_TUBE + QLatin1String(".ServiceName")).toString();
+            rccSpec.hasFixedProperty(TP_QT_PROP_CHANNEL_TYPE_DBUS_TUBE_SERVICE_NAME)) {
+            ret << rccSpec.fixedProperty(TP_QT_PROP_CHANNEL_TYPE_DBUS_TUBE_SERVICE_NAME).toString();
         }
     }
 
@@ -155,10 +153,8 @@ QStringList ContactCapabilities::streamTubeServices() const
     foreach (const RequestableChannelClassSpec &rccSpec, rccSpecs) {
         if (rccSpec.channelType() == TP_QT_IFACE_CHANNEL_TYPE_STREAM_TUBE &&
             rccSpec.targetHandleType() == HandleTypeContact &&
-            rccSpec.hasFixedProperty(
-                    TP_QT_IFACE_CHANNEL_TYPE_STREAM_TUBE + QLatin1String(".Service"))) {
-            ret << rccSpec.fixedProperty(
-                    TP_QT_IFACE_CHANNEL_TYPE_STREAM_TUBE + QLatin1String(".Service")).toString();
+            rccSpec.hasFixedProperty(TP_QT_PROP_CHANNEL_TYPE_STREAM_TUBE_SERVICE)) {
+            ret << rccSpec.fixedProperty(TP_QT_PROP_CHANNEL_TYPE_STREAM_TUBE_SERVICE).toString();
         }
     }
 
@@ -237,11 +237,11 @@ PendingOperation *ContactManager::Roster::addGroup(const QString &group)
 
     if (usingFallbackContactList) {
         QVariantMap request;
-        request.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType"),
+        request.insert(TP_QT_PROP_CHANNEL_CHANNEL_TYPE,
                                      TP_QT_IFACE_CHANNEL_TYPE_CONTACT_LIST);
-        request.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandleType"),
+        request.insert(TP_QT_PROP_CHANNEL_TARGET_HANDLE_TYPE,
                                      (uint) Tp::HandleTypeGroup);
-        request.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".TargetID"),
+        request.insert(TP_QT_PROP_CHANNEL_TARGET_ID,
                                      group);
         return conn->lowlevel()->ensureChannel(request);
     }
@@ -817,16 +817,18 @@ void ContactManager::Roster::gotContactListContacts(QDBusPendingCallWatcher *wat
     gotContactListInitialContacts = true;
 
     ConnectionPtr conn(contactManager->connection());
-    ContactAttributesMap attrsMap = reply.value();
+    const Features features = conn->contactFactory()->features();
+    const ContactAttributesMap attrsMap = reply.value();
+    cachedAllKnownContacts.reserve(cachedAllKnownContacts.size() + attrsMap.size());
+    contactListContacts.reserve(contactListContacts.size() + attrsMap.size());
     ContactAttributesMap::const_iterator begin = attrsMap.constBegin();
     ContactAttributesMap::const_iterator end = attrsMap.constEnd();
     for (ContactAttributesMap::const_iterator i = begin; i != end; ++i) {
         uint bareHandle = i.key();
-        QVariantMap attrs = i.value();
 
         ContactPtr contact = contactManager->ensureContact(ReferencedHandles(conn,
                     HandleTypeContact, UIntList() << bareHandle),
-                conn->contactFactory()->features(), attrs);
+                features, i.value());
         cachedAllKnownContacts.insert(contact);
         contactListContacts.insert(contact);
     }
@@ -1202,11 +1204,11 @@ void ContactManager::Roster::gotContactListChannelHandle(PendingOperation *op)
 
     debug() << "Requesting channel for" << channelId << "channel";
     QVariantMap request;
-    request.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType"),
+    request.insert(TP_QT_PROP_CHANNEL_CHANNEL_TYPE,
             TP_QT_IFACE_CHANNEL_TYPE_CONTACT_LIST);
-    request.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandleType"),
+    request.insert(TP_QT_PROP_CHANNEL_TARGET_HANDLE_TYPE,
             (uint) HandleTypeList);
-    request.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandle"),
+    request.insert(TP_QT_PROP_CHANNEL_TARGET_HANDLE,
             handle[0]);
     ConnectionPtr conn(contactManager->connection());
     /* Request the channel passing INT_MAX as timeout (meaning no timeout), as
@@ -1380,14 +1382,13 @@ void ContactManager::Roster::onNewChannels(const Tp::ChannelDetailsList &channel
     QString channelType;
     uint handleType;
     foreach (const ChannelDetails &channelDetails, channelDetailsList) {
-        channelType = channelDetails.properties.value(
-                TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType")).toString();
+        channelType = channelDetails.properties.value(TP_QT_PROP_CHANNEL_CHANNEL_TYPE).toString();
         if (channelType != TP_QT_IFACE_CHANNEL_TYPE_CONTACT_LIST) {
             continue;
         }
 
         handleType = channelDetails.properties.value(
-                TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandleType")).toUInt();
+                TP_QT_PROP_CHANNEL_TARGET_HANDLE_TYPE).toUInt();
         if (handleType != Tp::HandleTypeGroup) {
             continue;
         }
@@ -1459,11 +1460,11 @@ void ContactManager::Roster::onStoredChannelMembersChanged(
         warning() << "Found remote pending contacts on stored list";
     }
 
-    foreach (ContactPtr contact, groupMembersAdded) {
+    foreach (const ContactPtr &contact, groupMembersAdded) {
         debug() << "Contact" << contact->id() << "on stored list";
     }
 
-    foreach (ContactPtr contact, groupMembersRemoved) {
+    foreach (const ContactPtr &contact, groupMembersRemoved) {
         debug() << "Contact" << contact->id() << "removed from stored list";
     }
 
@@ -1484,17 +1485,17 @@ void ContactManager::Roster::onSubscribeChannelMembersChanged(
         warning() << "Found local pending contacts on subscribe list";
     }
 
-    foreach (ContactPtr contact, groupMembersAdded) {
+    foreach (const ContactPtr &contact, groupMembersAdded) {
         debug() << "Contact" << contact->id() << "on subscribe list";
         contact->setSubscriptionState(SubscriptionStateYes);
     }
 
-    foreach (ContactPtr contact, groupRemotePendingMembersAdded) {
+    foreach (const ContactPtr &contact, groupRemotePendingMembersAdded) {
         debug() << "Contact" << contact->id() << "added to subscribe list";
         contact->setSubscriptionState(SubscriptionStateAsk);
     }
 
-    foreach (ContactPtr contact, groupMembersRemoved) {
+    foreach (const ContactPtr &contact, groupMembersRemoved) {
         debug() << "Contact" << contact->id() << "removed from subscribe list";
         contact->setSubscriptionState(SubscriptionStateNo);
     }
@@ -1516,17 +1517,17 @@ void ContactManager::Roster::onPublishChannelMembersChanged(
         warning() << "Found remote pending contacts on publish list";
     }
 
-    foreach (ContactPtr contact, groupMembersAdded) {
+    foreach (const ContactPtr &contact, groupMembersAdded) {
         debug() << "Contact" << contact->id() << "on publish list";
         contact->setPublishState(SubscriptionStateYes);
     }
 
-    foreach (ContactPtr contact, groupLocalPendingMembersAdded) {
+    foreach (const ContactPtr &contact, groupLocalPendingMembersAdded) {
         debug() << "Contact" << contact->id() << "added to publish list";
         contact->setPublishState(SubscriptionStateAsk, details.message());
     }
 
-    foreach (ContactPtr contact, groupMembersRemoved) {
+    foreach (const ContactPtr &contact, groupMembersRemoved) {
         debug() << "Contact" << contact->id() << "removed from publish list";
         contact->setPublishState(SubscriptionStateNo);
     }
@@ -1556,12 +1557,12 @@ void ContactManager::Roster::onDenyChannelMembersChanged(
         warning() << "Found remote pending contacts on deny list";
     }
 
-    foreach (ContactPtr contact, groupMembersAdded) {
+    foreach (const ContactPtr &contact, groupMembersAdded) {
         debug() << "Contact" << contact->id() << "added to deny list";
         contact->setBlocked(true);
     }
 
-    foreach (ContactPtr contact, groupMembersRemoved) {
+    foreach (const ContactPtr &contact, groupMembersRemoved) {
         debug() << "Contact" << contact->id() << "removed from deny list";
         contact->setBlocked(false);
     }
@@ -1581,7 +1582,7 @@ void ContactManager::Roster::onContactListGroupMembersChanged(
     ChannelPtr contactListGroupChannel = ChannelPtr(
             qobject_cast<Channel*>(sender()));
     QString id = contactListGroupChannel->immutableProperties().value(
-            TP_QT_IFACE_CHANNEL + QLatin1String(".TargetID")).toString();
+            TP_QT_PROP_CHANNEL_TARGET_ID).toString();
 
     foreach (const ContactPtr &contact, groupMembersAdded) {
         contact->setAddedToGroup(id);
@@ -1606,7 +1607,7 @@ void ContactManager::Roster::onContactListGroupRemoved(Tp::DBusProxy *proxy,
     // invalidates itself when it gets closed.
     ChannelPtr contactListGroupChannel = ChannelPtr(qobject_cast<Channel*>(proxy));
     QString id = contactListGroupChannel->immutableProperties().value(
-            TP_QT_IFACE_CHANNEL + QLatin1String(".TargetID")).toString();
+            TP_QT_PROP_CHANNEL_TARGET_ID).toString();
     contactListGroupChannels.remove(id);
     removedContactListGroupChannels.append(contactListGroupChannel);
     disconnect(contactListGroupChannel.data(), nullptr, nullptr, nullptr);
@@ -1981,7 +1982,7 @@ void ContactManager::Roster::updateContactsPresenceState()
     }
 
     Contacts contacts = cachedAllKnownContacts;
-    foreach (ContactPtr contact, contacts) {
+    foreach (const ContactPtr &contact, contacts) {
         if (subscribeChannel) {
             // not in "subscribe" -> No, in "subscribe" lp -> Ask, in "subscribe" current -> Yes
             if (subscribeContacts.contains(contact)) {
@@ -2087,7 +2088,7 @@ void ContactManager::Roster::setContactListGroupChannelsReady()
 QString ContactManager::Roster::addContactListGroupChannel(const ChannelPtr &contactListGroupChannel)
 {
     QString id = contactListGroupChannel->immutableProperties().value(
-            TP_QT_IFACE_CHANNEL + QLatin1String(".TargetID")).toString();
+            TP_QT_PROP_CHANNEL_TARGET_ID).toString();
     contactListGroupChannels.insert(id, contactListGroupChannel);
     connect(contactListGroupChannel.data(),
             SIGNAL(groupMembersChanged(
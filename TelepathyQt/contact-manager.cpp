@@ -41,7 +41,9 @@
 #include <TelepathyQt/ReferencedHandles>
 #include <TelepathyQt/Utils>
 
+#include <QElapsedTimer>
 #include <QMap>
+#include <QTimer>
 
 namespace Tp
 {
@@ -72,6 +74,38 @@ struct TP_QT_NO_EXPORT ContactManager::Private
 
     // contact info
     PendingRefreshContactInfo *refreshInfoOp;
+
+    // GetContactAttributes calls in flight, so overlapping requests can share them
+    struct InFlightAttributes
+    {
+        UIntList handles;
+        QSet<QString> interfaces;
+    };
+    QHash<PendingOperation *, InFlightAttributes> inFlightAttributes;
+    QHash<uint, QList<PendingContactAttributes *> > inFlightAttributesByHandle;
+    uint inFlightAttributesHits;
+    uint inFlightAttributesMisses;
+
+    // Contacts kept alive after their last user dropped them, least recently used first
+    void retainContact(const ContactPtr &contact);
+    void trimContactCache();
+
+    struct RetainedContact
+    {
+        ContactPtr contact;
+        quint64 serial;
+        qint64 lastUsed;
+    };
+    QHash<uint, RetainedContact> retainedContacts;
+    QMap<quint64, uint> retainedContactsOrder;
+    quint64 retainedContactsSerial;
+    QElapsedTimer retainedContactsClock;
+    QTimer *retainedContactsTimer;
+    int contactCacheSize;
+    int contactCacheTimeout;
+    QHash<uint, ContactPtr> pinnedContacts;
+    uint contactCacheHits;
+    uint contactCacheMisses;
 };
 
 ContactManager::Private::Private(ContactManager *parent, Connection *connection)
@@ -79,8 +113,17 @@ ContactManager::Private::Private(ContactManager *parent, Connection *connection)
       connection(connection),
       roster(new ContactManager::Roster(parent)),
       requestAvatarsIdle(false),
-      refreshInfoOp(nullptr)
+      refreshInfoOp(nullptr),
+      inFlightAttributesHits(0),
+      inFlightAttributesMisses(0),
+      retainedContactsSerial(0),
+      retainedContactsTimer(nullptr),
+      contactCacheSize(0),
+      contactCacheTimeout(0),
+      contactCacheHits(0),
+      contactCacheMisses(0)
 {
+    retainedContactsClock.start();
 }
 
 ContactManager::Private::~Private()
@@ -111,6 +154,48 @@ bool ContactManager::Private::buildAvatarFileName(QString token, bool createDir,
     return true;
 }
 
+void ContactManager::Private::retainContact(const ContactPtr &contact)
+{
+    if (contactCacheSize <= 0) {
+        return;
+    }
+
+    uint handle = contact->handle()[0];
+    if (pinnedContacts.contains(handle)) {
+        return;
+    }
+
+    QHash<uint, RetainedContact>::iterator i = retainedContacts.find(handle);
+    if (i != retainedContacts.end()) {
+        retainedContactsOrder.remove(i->serial);
+    } else {
+        i = retainedContacts.insert(handle, RetainedContact());
+        i->contact = contact;
+    }
+
+    i->serial = ++retainedContactsSerial;
+    i->lastUsed = retainedContactsClock.elapsed();
+    retainedContactsOrder.insert(i->serial, handle);
+
+    trimContactCache();
+}
+
+void ContactManager::Private::trimContactCache()
+{
+    qint64 now = retainedContactsClock.elapsed();
+    while (!retainedContactsOrder.isEmpty()) {
+        QMap<quint64, uint>::iterator oldest = retainedContactsOrder.begin();
+        if (retainedContacts.size() <= contactCacheSize && (contactCacheTimeout <= 0 ||
+                now - retainedContacts.value(oldest.value()).lastUsed < contactCacheTimeout)) {
+            break;
+        }
+
+        // Dropping our reference destroys the Contact unless someone else still holds it
+        retainedContacts.remove(oldest.value());
+        retainedContactsOrder.erase(oldest);
+    }
+}
+
 Features ContactManager::Private::realFeatures(const Features &features)
 {
     Features ret(features);
@@ -1025,6 +1110,9 @@ PendingContacts *ContactManager::contactsForHandles(const UIntList &handles,
     foreach (uint handle, handles) {
         ContactPtr contact = lookupContactByHandle(handle);
         if (contact) {
+            ++mPriv->contactCacheHits;
+            mPriv->retainContact(contact);
+
             if ((realFeatures - contact->requestedFeatures()).isEmpty()) {
                 // Contact exists and has all the requested features
                 satisfyingContacts.insert(handle, contact);
@@ -1034,6 +1122,8 @@ PendingContacts *ContactManager::contactsForHandles(const UIntList &handles,
                 missingFeatures.unite(realFeatures - contact->requestedFeatures());
             }
         } else {
+            ++mPriv->contactCacheMisses;
+
             // Contact doesn't exist - we need to get all of the features (same as unite(features))
             missingFeatures = realFeatures;
             otherContacts.insert(handle);
@@ -1158,6 +1248,130 @@ PendingContacts *ContactManager::contactsForUris(const QStringList &uris,
     return contacts;
 }
 
+/**
+ * Request contacts and enable their \a features using the given \a identifiers, splitting the
+ * request into batches.
+ *
+ * This behaves like contactsForIdentifiers(), but rather than resolving all the identifiers in one
+ * go, which for very large lists can exceed D-Bus message size limits or connection manager
+ * timeouts, at most \a batchSize identifiers are resolved per request and at most
+ * \a maxBatchesInFlight of those requests are in progress at the same time. The contacts of each
+ * completed batch are reported through PendingBatchedContacts::contactsRetrieved().
+ *
+ * This method requires Connection::FeatureCore to be ready.
+ *
+ * \param identifiers A list of identifiers.
+ * \param features The Contact features to enable.
+ * \param batchSize The maximum number of identifiers to resolve per request.
+ * \param maxBatchesInFlight The maximum number of requests in progress at the same time.
+ * \return A PendingBatchedContacts, which will emit PendingContacts::finished
+ *         when all the contacts are retrieved or an error occurred.
+ * \sa contactsForIdentifiers(), contactsForVCardAddressesInBatches(), contactsForUrisInBatches()
+ */
+PendingBatchedContacts *ContactManager::contactsForIdentifiersInBatches(
+        const QStringList &identifiers, const Features &features,
+        int batchSize, int maxBatchesInFlight)
+{
+    if (!connection()->isValid()) {
+        return new PendingBatchedContacts(ContactManagerPtr(this),
+                PendingContacts::ForIdentifiers, QString(), identifiers, features,
+                batchSize, maxBatchesInFlight,
+                TP_QT_ERROR_NOT_AVAILABLE,
+                QLatin1String("Connection is invalid"));
+    } else if (!connection()->isReady(Connection::FeatureCore)) {
+        return new PendingBatchedContacts(ContactManagerPtr(this),
+                PendingContacts::ForIdentifiers, QString(), identifiers, features,
+                batchSize, maxBatchesInFlight,
+                TP_QT_ERROR_NOT_AVAILABLE,
+                QLatin1String("Connection::FeatureCore is not ready"));
+    }
+
+    return new PendingBatchedContacts(ContactManagerPtr(this),
+            PendingContacts::ForIdentifiers, QString(), identifiers,
+            mPriv->realFeatures(features), batchSize, maxBatchesInFlight);
+}
+
+/**
+ * Request contacts and enable their \a features using a given field in their vcards, splitting
+ * the request into batches.
+ *
+ * This behaves like contactsForVCardAddresses(), with the request split into batches as explained
+ * in contactsForIdentifiersInBatches().
+ *
+ * This method requires Connection::FeatureCore to be ready.
+ *
+ * \param vcardField The vcard field of the addresses we are requesting.
+ * \param vcardAddresses The addresses to get contacts for.
+ * \param features The Contact features to enable.
+ * \param batchSize The maximum number of addresses to resolve per request.
+ * \param maxBatchesInFlight The maximum number of requests in progress at the same time.
+ * \return A PendingBatchedContacts, which will emit PendingContacts::finished
+ *         when all the contacts are retrieved or an error occurred.
+ * \sa contactsForVCardAddresses(), contactsForIdentifiersInBatches(), contactsForUrisInBatches()
+ */
+PendingBatchedContacts *ContactManager::contactsForVCardAddressesInBatches(
+        const QString &vcardField, const QStringList &vcardAddresses,
+        const Features &features, int batchSize, int maxBatchesInFlight)
+{
+    if (!connection()->isValid()) {
+        return new PendingBatchedContacts(ContactManagerPtr(this),
+                PendingContacts::ForVCardAddresses, vcardField, vcardAddresses, features,
+                batchSize, maxBatchesInFlight,
+                TP_QT_ERROR_NOT_AVAILABLE,
+                QLatin1String("Connection is invalid"));
+    } else if (!connection()->isReady(Connection::FeatureCore)) {
+        return new PendingBatchedContacts(ContactManagerPtr(this),
+                PendingContacts::ForVCardAddresses, vcardField, vcardAddresses, features,
+                batchSize, maxBatchesInFlight,
+                TP_QT_ERROR_NOT_AVAILABLE,
+                QLatin1String("Connection::FeatureCore is not ready"));
+    }
+
+    return new PendingBatchedContacts(ContactManagerPtr(this),
+            PendingContacts::ForVCardAddresses, vcardField, vcardAddresses,
+            mPriv->realFeatures(features), batchSize, maxBatchesInFlight);
+}
+
+/**
+ * Request contacts and enable their \a features using the given URI addresses, splitting the
+ * request into batches.
+ *
+ * This behaves like contactsForUris(), with the request split into batches as explained
+ * in contactsForIdentifiersInBatches().
+ *
+ * This method requires Connection::FeatureCore to be ready.
+ *
+ * \param uris The URI addresses to get contacts for.
+ * \param features The Contact features to enable.
+ * \param batchSize The maximum number of URIs to resolve per request.
+ * \param maxBatchesInFlight The maximum number of requests in progress at the same time.
+ * \return A PendingBatchedContacts, which will emit PendingContacts::finished
+ *         when all the contacts are retrieved or an error occurred.
+ * \sa contactsForUris(), contactsForIdentifiersInBatches(),
+ *     contactsForVCardAddressesInBatches()
+ */
+PendingBatchedContacts *ContactManager::contactsForUrisInBatches(const QStringList &uris,
+        const Features &features, int batchSize, int maxBatchesInFlight)
+{
+    if (!connection()->isValid()) {
+        return new PendingBatchedContacts(ContactManagerPtr(this),
+                PendingContacts::ForUris, QString(), uris, features,
+                batchSize, maxBatchesInFlight,
+                TP_QT_ERROR_NOT_AVAILABLE,
+                QLatin1String("Connection is invalid"));
+    } else if (!connection()->isReady(Connection::FeatureCore)) {
+        return new PendingBatchedContacts(ContactManagerPtr(this),
+                PendingContacts::ForUris, QString(), uris, features,
+                batchSize, maxBatchesInFlight,
+                TP_QT_ERROR_NOT_AVAILABLE,
+                QLatin1String("Connection::FeatureCore is not ready"));
+    }
+
+    return new PendingBatchedContacts(ContactManagerPtr(this),
+            PendingContacts::ForUris, QString(), uris,
+            mPriv->realFeatures(features), batchSize, maxBatchesInFlight);
+}
+
 PendingContacts *ContactManager::upgradeContacts(const QList<ContactPtr> &contacts,
         const Features &features)
 {
@@ -1174,17 +1388,251 @@ PendingContacts *ContactManager::upgradeContacts(const QList<ContactPtr> &contac
     return new PendingContacts(ContactManagerPtr(this), contacts, features);
 }
 
-ContactPtr ContactManager::lookupContactByHandle(uint handle)
+/**
+ * Return the maximum number of Contact objects kept alive by this manager after the application
+ * has dropped all references to them.
+ *
+ * \return The maximum number of retained contacts, 0 if retention is disabled.
+ * \sa setContactCacheSize()
+ */
+int ContactManager::contactCacheSize() const
 {
-    ContactPtr contact;
+    return mPriv->contactCacheSize;
+}
 
-    if (mPriv->contacts.contains(handle)) {
-        contact = ContactPtr(mPriv->contacts.value(handle));
+/**
+ * Set the maximum number of Contact objects kept alive by this manager after the application
+ * has dropped all references to them.
+ *
+ * Normally a Contact is destroyed as soon as the last ContactPtr referencing it goes away, and
+ * requesting it again refetches all its attributes from the connection manager. With a non-zero
+ * size, the \a size most recently used contacts are kept alive, so requesting them again with
+ * the same features completes without any D-Bus round trip. This is useful when the same contacts
+ * are repeatedly requested and dropped, for instance when scrolling through a large member list.
+ *
+ * Retention is disabled by default.
+ *
+ * \param size The maximum number of retained contacts, or 0 to disable retention.
+ * \sa setContactCacheTimeout(), pinContacts(), contactCacheHits()
+ */
+void ContactManager::setContactCacheSize(int size)
+{
+    mPriv->contactCacheSize = qMax(size, 0);
+    if (mPriv->contactCacheSize == 0) {
+        mPriv->retainedContacts.clear();
+        mPriv->retainedContactsOrder.clear();
+    } else {
+        mPriv->trimContactCache();
+    }
+}
+
+/**
+ * Return for how long a retained Contact is kept alive after it has last been used.
+ *
+ * \return The timeout in milliseconds, 0 if contacts are only evicted by the size limit.
+ * \sa setContactCacheTimeout()
+ */
+int ContactManager::contactCacheTimeout() const
+{
+    return mPriv->contactCacheTimeout;
+}
+
+/**
+ * Set for how long a retained Contact is kept alive after it has last been used.
+ *
+ * This only has effect if a contact cache size has been set with setContactCacheSize().
+ *
+ * \param msecs The timeout in milliseconds, or 0 to only evict contacts by the size limit.
+ * \sa setContactCacheSize()
+ */
+void ContactManager::setContactCacheTimeout(int msecs)
+{
+    mPriv->contactCacheTimeout = qMax(msecs, 0);
+
+    if (mPriv->contactCacheTimeout == 0) {
+        delete mPriv->retainedContactsTimer;
+        mPriv->retainedContactsTimer = nullptr;
+        return;
+    }
+
+    if (!mPriv->retainedContactsTimer) {
+        mPriv->retainedContactsTimer = new QTimer(this);
+        connect(mPriv->retainedContactsTimer,
+                SIGNAL(timeout()),
+                SLOT(onContactCacheTimeout()));
+    }
+    // Expire at a finer granularity than the timeout itself, without waking up too often
+    mPriv->retainedContactsTimer->start(qMax(mPriv->contactCacheTimeout / 4, 1000));
+    mPriv->trimContactCache();
+}
+
+/**
+ * Keep the given \a contacts alive until unpinContacts() is called for them, regardless of
+ * the contact cache size and timeout.
+ *
+ * Pinning is not counted; a single call to unpinContacts() releases a contact however many
+ * times it has been pinned.
+ *
+ * \param contacts The contacts to pin.
+ * \sa unpinContacts()
+ */
+void ContactManager::pinContacts(const QList<ContactPtr> &contacts)
+{
+    foreach (const ContactPtr &contact, contacts) {
+        if (!contact || contact->manager().data() != this) {
+            continue;
+        }
+
+        // Pinned contacts don't take up room in the cache
+        uint handle = contact->handle()[0];
+        mPriv->pinnedContacts.insert(handle, contact);
+        if (mPriv->retainedContacts.contains(handle)) {
+            mPriv->retainedContactsOrder.remove(mPriv->retainedContacts.take(handle).serial);
+        }
+    }
+}
+
+/**
+ * Release the given \a contacts previously pinned with pinContacts().
+ *
+ * The contacts then fall back to the normal contact cache policy.
+ *
+ * \param contacts The contacts to unpin.
+ * \sa pinContacts()
+ */
+void ContactManager::unpinContacts(const QList<ContactPtr> &contacts)
+{
+    foreach (const ContactPtr &contact, contacts) {
         if (!contact) {
-            // Dangling weak pointer, remove it
-            mPriv->contacts.remove(handle);
+            continue;
+        }
+
+        if (mPriv->pinnedContacts.remove(contact->handle()[0])) {
+            mPriv->retainContact(contact);
         }
     }
+}
+
+/**
+ * Return the number of contacts requested through contactsForHandles() and the other
+ * contactsFor*() methods which resolve to handles, for which a Contact object was still alive.
+ *
+ * Together with contactCacheMisses() this allows tuning setContactCacheSize() and
+ * setContactCacheTimeout().
+ *
+ * \return The number of contact lookups which found an existing Contact.
+ * \sa contactCacheMisses()
+ */
+uint ContactManager::contactCacheHits() const
+{
+    return mPriv->contactCacheHits;
+}
+
+/**
+ * Return the number of contacts requested through contactsForHandles() and the other
+ * contactsFor*() methods which resolve to handles, for which a new Contact object had to be built.
+ *
+ * \return The number of contact lookups which did not find an existing Contact.
+ * \sa contactCacheHits()
+ */
+uint ContactManager::contactCacheMisses() const
+{
+    return mPriv->contactCacheMisses;
+}
+
+/**
+ * Return the number of contacts whose attributes were taken from a request already in flight
+ * for another PendingContacts, instead of being requested again.
+ *
+ * \return The number of contacts served by an in-flight request.
+ * \sa inFlightAttributesMisses()
+ */
+uint ContactManager::inFlightAttributesHits() const
+{
+    return mPriv->inFlightAttributesHits;
+}
+
+/**
+ * Return the number of contacts whose attributes had to be requested from the connection
+ * manager, as no request in flight covered them.
+ *
+ * \return The number of contacts needing a new request.
+ * \sa inFlightAttributesHits()
+ */
+uint ContactManager::inFlightAttributesMisses() const
+{
+    return mPriv->inFlightAttributesMisses;
+}
+
+QList<PendingContactAttributes *> ContactManager::contactAttributes(const QSet<uint> &handles,
+        const QSet<QString> &interfaces)
+{
+    QList<PendingContactAttributes *> ret;
+    UIntList toRequest;
+
+    foreach (uint handle, handles) {
+        // A handle can be served by the requests in flight if together they cover all the
+        // interfaces we need for it
+        const QList<PendingContactAttributes *> covering =
+            mPriv->inFlightAttributesByHandle.value(handle);
+        QSet<QString> covered;
+        foreach (PendingContactAttributes *attributes, covering) {
+            covered.unite(mPriv->inFlightAttributes[attributes].interfaces);
+        }
+
+        if (!covering.isEmpty() && covered.contains(interfaces)) {
+            ++mPriv->inFlightAttributesHits;
+            foreach (PendingContactAttributes *attributes, covering) {
+                if (!ret.contains(attributes)) {
+                    ret.append(attributes);
+                }
+            }
+        } else {
+            ++mPriv->inFlightAttributesMisses;
+            toRequest.append(handle);
+        }
+    }
+
+    if (!toRequest.isEmpty()) {
+        PendingContactAttributes *attributes =
+            connection()->lowlevel()->contactAttributes(toRequest, interfaces.toList(), true);
+        if (!attributes->isFinished()) {
+            Private::InFlightAttributes &inFlight = mPriv->inFlightAttributes[attributes];
+            inFlight.handles = toRequest;
+            inFlight.interfaces = interfaces;
+            foreach (uint handle, toRequest) {
+                mPriv->inFlightAttributesByHandle[handle].append(attributes);
+            }
+
+            // Connected before any PendingContacts, so it's no longer shared by the time they
+            // get the result
+            connect(attributes,
+                    SIGNAL(finished(Tp::PendingOperation*)),
+                    SLOT(onContactAttributesFinished(Tp::PendingOperation*)));
+        }
+        ret.append(attributes);
+    }
+
+    debug() << "Attributes for" << handles.size() << "contacts:" <<
+        handles.size() - toRequest.size() << "from requests in flight," <<
+        toRequest.size() << "requested";
+
+    return ret;
+}
+
+ContactPtr ContactManager::lookupContactByHandle(uint handle)
+{
+    // Upgrade the stored weak pointer in place, copying it would be one more atomic ref/deref pair
+    QHash<uint, WeakPtr<Contact> >::iterator i = mPriv->contacts.find(handle);
+    if (i == mPriv->contacts.end()) {
+        return ContactPtr();
+    }
+
+    ContactPtr contact(i.value());
+    if (!contact) {
+        // Dangling weak pointer, remove it
+        mPriv->contacts.erase(i);
+    }
 
     return contact;
 }
@@ -1430,6 +1878,28 @@ void ContactManager::onClientTypesUpdated(uint handle, const QStringList &client
     }
 }
 
+void ContactManager::onContactAttributesFinished(PendingOperation *operation)
+{
+    Private::InFlightAttributes inFlight = mPriv->inFlightAttributes.take(operation);
+    foreach (uint handle, inFlight.handles) {
+        QHash<uint, QList<PendingContactAttributes *> >::iterator i =
+            mPriv->inFlightAttributesByHandle.find(handle);
+        if (i == mPriv->inFlightAttributesByHandle.end()) {
+            continue;
+        }
+
+        i->removeOne(static_cast<PendingContactAttributes *>(operation));
+        if (i->isEmpty()) {
+            mPriv->inFlightAttributesByHandle.erase(i);
+        }
+    }
+}
+
+void ContactManager::onContactCacheTimeout()
+{
+    mPriv->trimContactCache();
+}
+
 void ContactManager::doRefreshInfo()
 {
     PendingRefreshContactInfo *op = mPriv->refreshInfoOp;
@@ -1450,6 +1920,7 @@ ContactPtr ContactManager::ensureContact(const ReferencedHandles &handle,
     }
 
     contact->augment(features, attributes);
+    mPriv->retainContact(contact);
 
     return contact;
 }
@@ -1461,7 +1932,7 @@ ContactPtr ContactManager::ensureContact(uint bareHandle, const QString &id,
 
     if (!contact) {
         QVariantMap attributes;
-        attributes.insert(TP_QT_IFACE_CONNECTION + QLatin1String("/contact-id"), id);
+        attributes.insert(TP_QT_TOKEN_CONNECTION_CONTACT_ID, id);
 
         contact = connection()->contactFactory()->construct(this,
                 ReferencedHandles(connection(), HandleTypeContact, UIntList() << bareHandle),
@@ -1471,6 +1942,8 @@ ContactPtr ContactManager::ensureContact(uint bareHandle, const QString &id,
         // do not call augment here as this is a fake contact
     }
 
+    mPriv->retainContact(contact);
+
     return contact;
 }
 
@@ -1591,6 +2064,11 @@ PendingOperation *ContactManager::introspectRosterGroups()
 void ContactManager::resetRoster()
 {
     mPriv->roster->reset();
+
+    // Release retained contacts while their handles can still be released cleanly
+    mPriv->retainedContacts.clear();
+    mPriv->retainedContactsOrder.clear();
+    mPriv->pinnedContacts.clear();
 }
 
 /**
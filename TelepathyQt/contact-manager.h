@@ -44,6 +44,8 @@ namespace Tp
 {
 
 class Connection;
+class PendingBatchedContacts;
+class PendingContactAttributes;
 class PendingContacts;
 class PendingOperation;
 
@@ -122,6 +124,17 @@ public:
     PendingContacts *contactsForUris(const QStringList &uris,
             const Features &features = Features());
 
+    PendingBatchedContacts *contactsForIdentifiersInBatches(const QStringList &identifiers,
+            const Features &features = Features(),
+            int batchSize = 500, int maxBatchesInFlight = 4);
+    PendingBatchedContacts *contactsForVCardAddressesInBatches(const QString &vcardField,
+            const QStringList &vcardAddresses,
+            const Features &features = Features(),
+            int batchSize = 500, int maxBatchesInFlight = 4);
+    PendingBatchedContacts *contactsForUrisInBatches(const QStringList &uris,
+            const Features &features = Features(),
+            int batchSize = 500, int maxBatchesInFlight = 4);
+
     PendingContacts *upgradeContacts(const QList<ContactPtr> &contacts,
             const Features &features);
 
@@ -129,6 +142,18 @@ public:
 
     PendingOperation *refreshContactInfo(const QList<ContactPtr> &contact);
 
+    uint inFlightAttributesHits() const;
+    uint inFlightAttributesMisses() const;
+
+    int contactCacheSize() const;
+    void setContactCacheSize(int size);
+    int contactCacheTimeout() const;
+    void setContactCacheTimeout(int msecs);
+    void pinContacts(const QList<ContactPtr> &contacts);
+    void unpinContacts(const QList<ContactPtr> &contacts);
+    uint contactCacheHits() const;
+    uint contactCacheMisses() const;
+
 Q_SIGNALS:
     void stateChanged(Tp::ContactListState state);
 
@@ -158,12 +183,15 @@ private Q_SLOTS:
     TP_QT_NO_EXPORT void onContactInfoChanged(uint, const Tp::ContactInfoFieldList &);
     TP_QT_NO_EXPORT void onClientTypesUpdated(uint, const QStringList &);
     TP_QT_NO_EXPORT void doRefreshInfo();
+    TP_QT_NO_EXPORT void onContactAttributesFinished(Tp::PendingOperation *);
+    TP_QT_NO_EXPORT void onContactCacheTimeout();
 
 private:
     class PendingRefreshContactInfo;
     class Roster;
     friend class Channel;
     friend class Connection;
+    friend class PendingBatchedContacts;
     friend class PendingContacts;
     friend class PendingRefreshContactInfo;
     friend class Roster;
@@ -172,6 +200,9 @@ private:
 
     TP_QT_NO_EXPORT ContactPtr lookupContactByHandle(uint handle);
 
+    TP_QT_NO_EXPORT QList<PendingContactAttributes *> contactAttributes(const QSet<uint> &handles,
+            const QSet<QString> &interfaces);
+
     TP_QT_NO_EXPORT ContactPtr ensureContact(const ReferencedHandles &handle,
             const Features &features,
             const QVariantMap &attributes);
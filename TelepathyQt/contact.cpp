@@ -40,6 +40,8 @@
 #include <TelepathyQt/Presence>
 #include <TelepathyQt/ReferencedHandles>
 
+#include <QHash>
+
 namespace Tp
 {
 
@@ -60,6 +62,8 @@ struct TP_QT_NO_EXPORT Contact::Private
     {
     }
 
+    struct Attributes;
+
     void updateAvatarData();
 
     Contact *parent;
@@ -116,6 +120,75 @@ void Contact::Private::updateAvatarData()
     parent->manager()->requestContactAvatars(QList<ContactPtr>() << ContactPtr(parent));
 }
 
+// Index of the attributes of one contact, filled in a single pass over the attribute map
+struct TP_QT_NO_EXPORT Contact::Private::Attributes
+{
+    enum Key {
+        ContactId = 0,
+        Subscribe,
+        Publish,
+        PublishRequest,
+        Alias,
+        AvatarToken,
+        Capabilities,
+        Info,
+        Location,
+        SimplePresence,
+        Groups,
+        Addresses,
+        Uris,
+        ClientTypes,
+        NumKeys
+    };
+
+    Attributes(const QVariantMap &attributes);
+
+    bool contains(Key key) const { return values[key] != nullptr; }
+
+    template <class T>
+    T value(Key key) const
+    {
+        return values[key] ? qdbus_cast<T>(*values[key]) : T();
+    }
+
+    // Point into the attribute map, which outlives this index
+    const QVariant *values[NumKeys];
+};
+
+Contact::Private::Attributes::Attributes(const QVariantMap &attributes)
+{
+    static const QHash<QString, int> keys = []() {
+        QHash<QString, int> keys;
+        keys.insert(TP_QT_TOKEN_CONNECTION_CONTACT_ID, ContactId);
+        keys.insert(TP_QT_TOKEN_CONNECTION_INTERFACE_CONTACT_LIST_SUBSCRIBE, Subscribe);
+        keys.insert(TP_QT_TOKEN_CONNECTION_INTERFACE_CONTACT_LIST_PUBLISH, Publish);
+        keys.insert(TP_QT_TOKEN_CONNECTION_INTERFACE_CONTACT_LIST_PUBLISH_REQUEST, PublishRequest);
+        keys.insert(TP_QT_TOKEN_CONNECTION_INTERFACE_ALIASING_ALIAS, Alias);
+        keys.insert(TP_QT_TOKEN_CONNECTION_INTERFACE_AVATARS_TOKEN, AvatarToken);
+        keys.insert(TP_QT_TOKEN_CONNECTION_INTERFACE_CONTACT_CAPABILITIES_CAPABILITIES,
+                Capabilities);
+        keys.insert(TP_QT_TOKEN_CONNECTION_INTERFACE_CONTACT_INFO_INFO, Info);
+        keys.insert(TP_QT_TOKEN_CONNECTION_INTERFACE_LOCATION_LOCATION, Location);
+        keys.insert(TP_QT_TOKEN_CONNECTION_INTERFACE_SIMPLE_PRESENCE_PRESENCE, SimplePresence);
+        keys.insert(TP_QT_TOKEN_CONNECTION_INTERFACE_CONTACT_GROUPS_GROUPS, Groups);
+        keys.insert(TP_QT_TOKEN_CONNECTION_INTERFACE_ADDRESSING_ADDRESSES, Addresses);
+        keys.insert(TP_QT_TOKEN_CONNECTION_INTERFACE_ADDRESSING_URIS, Uris);
+        keys.insert(TP_QT_TOKEN_CONNECTION_INTERFACE_CLIENT_TYPES_CLIENT_TYPES, ClientTypes);
+        return keys;
+    }();
+
+    for (int i = 0; i < NumKeys; ++i) {
+        values[i] = nullptr;
+    }
+
+    for (QVariantMap::const_iterator i = attributes.constBegin(); i != attributes.constEnd(); ++i) {
+        QHash<QString, int>::const_iterator key = keys.constFind(i.key());
+        if (key != keys.constEnd()) {
+            values[key.value()] = &i.value();
+        }
+    }
+}
+
 struct TP_QT_NO_EXPORT Contact::InfoFields::Private : public QSharedData
 {
     Private(const ContactInfoFieldList &allFields)
@@ -322,8 +395,7 @@ Contact::Contact(ContactManager *manager, const ReferencedHandles &handle,
       mPriv(new Private(this, manager, handle))
 {
     mPriv->requestedFeatures.unite(requestedFeatures);
-    mPriv->id = qdbus_cast<QString>(attributes[
-            TP_QT_IFACE_CONNECTION + QLatin1String("/contact-id")]);
+    mPriv->id = qdbus_cast<QString>(attributes[TP_QT_TOKEN_CONNECTION_CONTACT_ID]);
 }
 
 /**
@@ -987,37 +1059,32 @@ PendingStringList *Contact::requestClientTypes()
 
 void Contact::augment(const Features &requestedFeatures, const QVariantMap &attributes)
 {
+    typedef Private::Attributes Attributes;
+
     mPriv->requestedFeatures.unite(requestedFeatures);
 
-    mPriv->id = qdbus_cast<QString>(attributes[
-            TP_QT_IFACE_CONNECTION + QLatin1String("/contact-id")]);
+    const Attributes attrs(attributes);
+
+    mPriv->id = attrs.value<QString>(Attributes::ContactId);
 
-    if (attributes.contains(TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_LIST +
-                QLatin1String("/subscribe"))) {
-        uint subscriptionState = qdbus_cast<uint>(attributes.value(
-                     TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_LIST + QLatin1String("/subscribe")));
-        setSubscriptionState((SubscriptionState) subscriptionState);
+    if (attrs.contains(Attributes::Subscribe)) {
+        setSubscriptionState((SubscriptionState) attrs.value<uint>(Attributes::Subscribe));
     }
 
-    if (attributes.contains(TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_LIST +
-                QLatin1String("/publish"))) {
-        uint publishState = qdbus_cast<uint>(attributes.value(
-                    TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_LIST + QLatin1String("/publish")));
-        QString publishRequest = qdbus_cast<QString>(attributes.value(
-                    TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_LIST + QLatin1String("/publish-request")));
-        setPublishState((SubscriptionState) publishState, publishRequest);
+    if (attrs.contains(Attributes::Publish)) {
+        setPublishState((SubscriptionState) attrs.value<uint>(Attributes::Publish),
+                attrs.value<QString>(Attributes::PublishRequest));
     }
 
-    foreach (const Feature &feature, requestedFeatures) {
-        QString maybeAlias;
-        SimplePresence maybePresence;
-        RequestableChannelClassList maybeCaps;
-        QVariantMap maybeLocation;
-        ContactInfoFieldList maybeInfo;
+    if (requestedFeatures.isEmpty()) {
+        return;
+    }
 
+    const Features supportedFeatures = manager()->supportedFeatures();
+
+    foreach (const Feature &feature, requestedFeatures) {
         if (feature == FeatureAlias) {
-            maybeAlias = qdbus_cast<QString>(attributes.value(
-                        TP_QT_IFACE_CONNECTION_INTERFACE_ALIASING + QLatin1String("/alias")));
+            QString maybeAlias = attrs.value<QString>(Attributes::Alias);
 
             if (!maybeAlias.isEmpty()) {
                 receiveAlias(maybeAlias);
@@ -1025,17 +1092,15 @@ void Contact::augment(const Features &requestedFeatures, const QVariantMap &attr
                 mPriv->alias = mPriv->id;
             }
         } else if (feature == FeatureAvatarData) {
-            if (manager()->supportedFeatures().contains(FeatureAvatarData)) {
+            if (supportedFeatures.contains(FeatureAvatarData)) {
                 mPriv->actualFeatures.insert(FeatureAvatarData);
                 mPriv->updateAvatarData();
             }
         } else if (feature == FeatureAvatarToken) {
-            if (attributes.contains(
-                        TP_QT_IFACE_CONNECTION_INTERFACE_AVATARS + QLatin1String("/token"))) {
-                receiveAvatarToken(qdbus_cast<QString>(attributes.value(
-                                TP_QT_IFACE_CONNECTION_INTERFACE_AVATARS + QLatin1String("/token"))));
+            if (attrs.contains(Attributes::AvatarToken)) {
+                receiveAvatarToken(attrs.value<QString>(Attributes::AvatarToken));
             } else {
-                if (manager()->supportedFeatures().contains(FeatureAvatarToken)) {
+                if (supportedFeatures.contains(FeatureAvatarToken)) {
                     // AvatarToken being supported but not included in the mapping indicates
                     // that the avatar token is not known - however, the feature is working fine
                     mPriv->actualFeatures.insert(FeatureAvatarToken);
@@ -1045,13 +1110,13 @@ void Contact::augment(const Features &requestedFeatures, const QVariantMap &attr
                 mPriv->avatarToken = QLatin1String("");
             }
         } else if (feature == FeatureCapabilities) {
-            maybeCaps = qdbus_cast<RequestableChannelClassList>(attributes.value(
-                        TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_CAPABILITIES + QLatin1String("/capabilities")));
+            RequestableChannelClassList maybeCaps =
+                attrs.value<RequestableChannelClassList>(Attributes::Capabilities);
 
             if (!maybeCaps.isEmpty()) {
                 receiveCapabilities(maybeCaps);
             } else {
-                if (manager()->supportedFeatures().contains(FeatureCapabilities) &&
+                if (supportedFeatures.contains(FeatureCapabilities) &&
                     mPriv->requestedFeatures.contains(FeatureCapabilities)) {
                     // Capabilities being supported but not updated in the
                     // mapping indicates that the capabilities is not known -
@@ -1060,13 +1125,12 @@ void Contact::augment(const Features &requestedFeatures, const QVariantMap &attr
                 }
             }
         } else if (feature == FeatureInfo) {
-            maybeInfo = qdbus_cast<ContactInfoFieldList>(attributes.value(
-                        TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_INFO + QLatin1String("/info")));
+            ContactInfoFieldList maybeInfo = attrs.value<ContactInfoFieldList>(Attributes::Info);
 
             if (!maybeInfo.isEmpty()) {
                 receiveInfo(maybeInfo);
             } else {
-                if (manager()->supportedFeatures().contains(FeatureInfo) &&
+                if (supportedFeatures.contains(FeatureInfo) &&
                     mPriv->requestedFeatures.contains(FeatureInfo)) {
                     // Info being supported but not updated in the
                     // mapping indicates that the info is not known -
@@ -1075,13 +1139,12 @@ void Contact::augment(const Features &requestedFeatures, const QVariantMap &attr
                 }
             }
         } else if (feature == FeatureLocation) {
-            maybeLocation = qdbus_cast<QVariantMap>(attributes.value(
-                        TP_QT_IFACE_CONNECTION_INTERFACE_LOCATION + QLatin1String("/location")));
+            QVariantMap maybeLocation = attrs.value<QVariantMap>(Attributes::Location);
 
             if (!maybeLocation.isEmpty()) {
                 receiveLocation(maybeLocation);
             } else {
-                if (manager()->supportedFeatures().contains(FeatureLocation) &&
+                if (supportedFeatures.contains(FeatureLocation) &&
                     mPriv->requestedFeatures.contains(FeatureLocation)) {
                     // Location being supported but not updated in the
                     // mapping indicates that the location is not known -
@@ -1090,8 +1153,8 @@ void Contact::augment(const Features &requestedFeatures, const QVariantMap &attr
                 }
             }
         } else if (feature == FeatureSimplePresence) {
-            maybePresence = qdbus_cast<SimplePresence>(attributes.value(
-                        TP_QT_IFACE_CONNECTION_INTERFACE_SIMPLE_PRESENCE + QLatin1String("/presence")));
+            SimplePresence maybePresence =
+                attrs.value<SimplePresence>(Attributes::SimplePresence);
 
             if (!maybePresence.status.isEmpty()) {
                 receiveSimplePresence(maybePresence);
@@ -1100,23 +1163,17 @@ void Contact::augment(const Features &requestedFeatures, const QVariantMap &attr
                         QLatin1String("unknown"), QLatin1String(""));
             }
         } else if (feature == FeatureRosterGroups) {
-            QStringList groups = qdbus_cast<QStringList>(attributes.value(
-                        TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_GROUPS + QLatin1String("/groups")));
-            mPriv->groups = groups.toSet();
+            mPriv->groups = attrs.value<QStringList>(Attributes::Groups).toSet();
         } else if (feature == FeatureAddresses) {
-            VCardFieldAddressMap addresses = qdbus_cast<VCardFieldAddressMap>(attributes.value(
-                        TP_QT_IFACE_CONNECTION_INTERFACE_ADDRESSING + QLatin1String("/addresses")));
-            QStringList uris = qdbus_cast<QStringList>(attributes.value(
-                        TP_QT_IFACE_CONNECTION_INTERFACE_ADDRESSING + QLatin1String("/uris")));
-            receiveAddresses(addresses, uris);
+            receiveAddresses(attrs.value<VCardFieldAddressMap>(Attributes::Addresses),
+                    attrs.value<QStringList>(Attributes::Uris));
         } else if (feature == FeatureClientTypes) {
-            QStringList maybeClientTypes = qdbus_cast<QStringList>(attributes.value(
-                        TP_QT_IFACE_CONNECTION_INTERFACE_CLIENT_TYPES + QLatin1String("/client-types")));
+            QStringList maybeClientTypes = attrs.value<QStringList>(Attributes::ClientTypes);
 
             if (!maybeClientTypes.isEmpty()) {
                 receiveClientTypes(maybeClientTypes);
             } else {
-                if (manager()->supportedFeatures().contains(FeatureClientTypes) &&
+                if (supportedFeatures.contains(FeatureClientTypes) &&
                     mPriv->requestedFeatures.contains(FeatureClientTypes)) {
                     // ClientTypes being supported but not updated in the
                     // mapping indicates that the info is not known -
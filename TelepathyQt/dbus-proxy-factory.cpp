@@ -30,6 +30,7 @@
 
 #include <TelepathyQt/DBusProxy>
 #include <TelepathyQt/ReadyObject>
+#include <TelepathyQt/PendingProxies>
 #include <TelepathyQt/PendingReady>
 
 #include <QDBusConnection>
@@ -113,6 +114,33 @@ DBusProxyPtr DBusProxyFactory::cachedProxy(const QString &busName,
     return mPriv->cache->get(Cache::Key(finalName, objectPath));
 }
 
+/**
+ * Return the cached proxies with the given \a busName and each of \a objectPaths.
+ *
+ * This is equivalent to calling cachedProxy() for each of \a objectPaths, but \a busName is only
+ * passed through finalBusNameFrom() once, which for stateful proxies saves a blocking D-Bus call
+ * per object path when a well-known name is given.
+ *
+ * \param busName Bus name of the proxies to return.
+ * \param objectPaths Object paths of the proxies to return.
+ * \return A list with a pointer to the DBusProxy object for each of \a objectPaths, in the same
+ *         order, with a \c Null shared pointer for each object path with no valid cached proxy.
+ */
+QList<DBusProxyPtr> DBusProxyFactory::cachedProxies(const QString &busName,
+        const QStringList &objectPaths) const
+{
+    Cache::Key key(finalBusNameFrom(busName), QString());
+
+    QList<DBusProxyPtr> proxies;
+    proxies.reserve(objectPaths.size());
+    foreach (const QString &objectPath, objectPaths) {
+        key.second = objectPath;
+        proxies.append(mPriv->cache->get(key));
+    }
+
+    return proxies;
+}
+
 /**
  * Should be called by subclasses when they have a proxy, be it a newly-constructed one or one from
  * the cache.
@@ -143,6 +171,32 @@ PendingReady *DBusProxyFactory::nowHaveProxy(const DBusProxyPtr &proxy) const
            proxy, featuresFor(proxy));
 }
 
+/**
+ * Should be called by subclasses when they have a set of proxies to prepare at once.
+ *
+ * This does the same work as nowHaveProxy() for each of \a proxies, preparing all of them
+ * concurrently, but tracks them with a single operation. It is useful to warm up the factory with
+ * proxies for a set of object paths known in advance, so that later requests for them are served
+ * from the cache.
+ *
+ * Access to the proxy instances is allowed as soon as this method returns through
+ * PendingProxies::proxies().
+ *
+ * \param proxies The proxies which the factory should now make sure are prepared and made ready.
+ * \return A PendingProxies operation which will emit PendingProxies::finished
+ *         when all of the proxies are usable.
+ */
+PendingProxies *DBusProxyFactory::nowHaveProxies(const QList<DBusProxyPtr> &proxies) const
+{
+    QList<PendingReady*> readyOps;
+    readyOps.reserve(proxies.size());
+    foreach (const DBusProxyPtr &proxy, proxies) {
+        readyOps.append(nowHaveProxy(proxy));
+    }
+
+    return new PendingProxies(SharedPtr<DBusProxyFactory>((DBusProxyFactory*) this), readyOps);
+}
+
 /**
  * \fn QString DBusProxyFactory::finalBusNameFrom(const QString &uniqueOrWellKnown) const
  *
@@ -34,7 +34,9 @@
 // For Q_DISABLE_COPY
 #include <QtGlobal>
 
+#include <QList>
 #include <QString>
+#include <QStringList>
 
 class QDBusConnection;
 
@@ -44,6 +46,7 @@ namespace Tp
 class Features;
 class PendingReady;
 class PendingOperation;
+class PendingProxies;
 
 class TP_QT_EXPORT DBusProxyFactory : public QObject, public RefCounted
 {
@@ -59,8 +62,11 @@ protected:
     DBusProxyFactory(const QDBusConnection &bus);
 
     DBusProxyPtr cachedProxy(const QString &busName, const QString &objectPath) const;
+    QList<DBusProxyPtr> cachedProxies(const QString &busName,
+            const QStringList &objectPaths) const;
 
     PendingReady *nowHaveProxy(const DBusProxyPtr &proxy) const;
+    PendingProxies *nowHaveProxies(const QList<DBusProxyPtr> &proxies) const;
 
     // I don't want this to be non-pure virtual, because I want ALL subclasses to have to think
     // about whether or not they need to uniquefy the name or not. If a subclass doesn't implement
@@ -75,6 +75,38 @@ bool partContains(const MessagePartList &parts, uint index, const char *key)
     return parts.at(index).contains(QLatin1String(key));
 }
 
+MessagePartList textMessageParts(uint type, const QString &text, const QVariant &sent = QVariant())
+{
+    MessagePart header;
+    if (sent.isValid()) {
+        header.insert(QLatin1String("message-sent"), QDBusVariant(sent));
+    }
+    header.insert(QLatin1String("message-type"), QDBusVariant(type));
+
+    MessagePart body;
+    body.insert(QLatin1String("content-type"), QDBusVariant(QLatin1String("text/plain")));
+    body.insert(QLatin1String("content"), QDBusVariant(text));
+
+    return MessagePartList() << header << body;
+}
+
+MessagePartList receivedMessageParts(const MessagePartList &parts)
+{
+    if (parts.at(0).contains(QLatin1String("message-received"))) {
+        return parts;
+    }
+
+    MessagePartList ret = parts;
+    ret[0].insert(QLatin1String("message-received"),
+            QDBusVariant(static_cast<qlonglong>(
+#if QT_VERSION < QT_VERSION_CHECK(5, 8, 0)
+                    QDateTime::currentDateTime().toTime_t())));
+#else
+                    QDateTime::currentDateTime().toSecsSinceEpoch())));
+#endif
+    return ret;
+}
+
 }
 
 struct TP_QT_NO_EXPORT Message::Private : public QSharedData
@@ -87,8 +119,36 @@ struct TP_QT_NO_EXPORT Message::Private : public QSharedData
     uint pendingId() const;
     void clearSenderHandle();
 
+    // The fields the accessors expose, parsed from the parts whenever they change
+    struct View
+    {
+        uint sent;
+        uint received;
+        uint messageType;
+        uint senderHandle;
+        uint pendingId;
+        QString senderId;
+        QString messageToken;
+        QString dbusInterface;
+        QString senderNickname;
+        QString supersededToken;
+        bool scrollback;
+        bool rescued;
+        bool silent;
+        bool truncated;
+        bool nonText;
+        QString text;
+    };
+
+    void buildView();
+
     MessagePartList parts;
 
+    // Copied along with the parts when detaching, and rebuilt whenever the parts are modified.
+    // It is never modified by the const accessors, so that copies of a message can be read from
+    // several threads, as with any implicitly shared class.
+    View parsedView;
+
     // if the Text interface says "non-text" we still only have the text,
     // because the interface can't tell us anything else...
     bool forceNonText;
@@ -103,6 +163,7 @@ Message::Private::Private(const MessagePartList &parts)
       forceNonText(false),
       sender(nullptr)
 {
+    buildView();
 }
 
 Message::Private::~Private()
@@ -111,22 +172,114 @@ Message::Private::~Private()
 
 inline uint Message::Private::senderHandle() const
 {
-    return uintOrZeroFromPart(parts, 0, "message-sender");
+    return parsedView.senderHandle;
 }
 
 inline QString Message::Private::senderId() const
 {
-    return stringOrEmptyFromPart(parts, 0, "message-sender-id");
+    return parsedView.senderId;
 }
 
 inline uint Message::Private::pendingId() const
 {
-    return uintOrZeroFromPart(parts, 0, "pending-message-id");
+    return parsedView.pendingId;
 }
 
 void Message::Private::clearSenderHandle()
 {
     parts[0].remove(QLatin1String("message-sender"));
+    buildView();
+}
+
+void Message::Private::buildView()
+{
+    View &v = parsedView;
+
+    if (parts.isEmpty()) {
+        v.sent = v.received = v.messageType = v.senderHandle = v.pendingId = 0;
+        v.senderId = v.messageToken = v.dbusInterface = v.senderNickname = v.supersededToken =
+            v.text = QString();
+        v.scrollback = v.rescued = v.silent = v.truncated = false;
+        v.nonText = true;
+        return;
+    }
+
+    v.sent = valueFromPart(parts, 0, "message-sent").toUInt();
+    v.received = valueFromPart(parts, 0, "message-received").toUInt();
+    v.messageType = valueFromPart(parts, 0, "message-type").toUInt();
+    v.senderHandle = uintOrZeroFromPart(parts, 0, "message-sender");
+    v.pendingId = uintOrZeroFromPart(parts, 0, "pending-message-id");
+    v.senderId = stringOrEmptyFromPart(parts, 0, "message-sender-id");
+    v.messageToken = stringOrEmptyFromPart(parts, 0, "message-token");
+    v.dbusInterface = stringOrEmptyFromPart(parts, 0, "interface");
+    v.senderNickname = stringOrEmptyFromPart(parts, 0, "sender-nickname");
+    v.supersededToken = stringOrEmptyFromPart(parts, 0, "supersedes");
+    v.scrollback = booleanFromPart(parts, 0, "scrollback", false);
+    v.rescued = booleanFromPart(parts, 0, "rescued", false);
+    v.silent = booleanFromPart(parts, 0, "silent", false);
+
+    // Walk the body once, collecting what text(), isTruncated() and hasNonTextContent() need
+    v.truncated = false;
+    v.text = QString();
+
+    // Alternative-groups for which we've already emitted an alternative
+    QSet<QString> altGroupsUsed;
+    // Alternative-groups with a text/plain alternative, and those needing one
+    QSet<QString> texts;
+    QSet<QString> textNeeded;
+    bool unrepresentable = false;
+
+    for (int i = 1; i < parts.size(); i++) {
+        if (booleanFromPart(parts, i, "truncated", false)) {
+            v.truncated = true;
+        }
+
+        const QString altGroup = stringOrEmptyFromPart(parts, i, "alternative");
+        const QString contentType = stringOrEmptyFromPart(parts, i, "content-type");
+
+        if (contentType != QLatin1String("text/plain")) {
+            if (altGroup.isEmpty()) {
+                // we can't possibly rescue this part by using a text/plain
+                // alternative, because it's not in any alternative group
+                unrepresentable = true;
+            } else {
+                // maybe we'll find a text/plain alternative for this
+                textNeeded << altGroup;
+            }
+            continue;
+        }
+
+        if (!altGroup.isEmpty()) {
+            // we can use this as an alternative for a non-text part
+            // with the same altGroup
+            texts << altGroup;
+        }
+
+        const QString interface = valueFromPart(parts, i, "interface").toString();
+        if (!interface.isEmpty()) {
+            continue;
+        }
+
+        if (!altGroup.isEmpty()) {
+            if (altGroupsUsed.contains(altGroup)) {
+                continue;
+            } else {
+                altGroupsUsed << altGroup;
+            }
+        }
+
+        QVariant content = valueFromPart(parts, i, "content");
+        if (content.type() == QVariant::String) {
+            v.text += content.toString();
+        } else {
+            // O RLY?
+            debug() << "allegedly text/plain part wasn't";
+        }
+    }
+
+    textNeeded -= texts;
+    v.nonText = parts.size() <= 1 || !v.dbusInterface.isEmpty() || unrepresentable ||
+        !textNeeded.isEmpty();
 }
 
 /**
@@ -137,6 +290,9 @@ void Message::Private::clearSenderHandle()
  * \brief The Message class represents a Telepathy message in a TextChannel.
  *
  * This class is implicitly shared, like QString.
+ *
+ * The parts are parsed once, when the message is constructed, and the result is shared by all
+ * the copies of the message.
  */
 
 /**
@@ -167,16 +323,8 @@ Message::Message(const MessagePartList &parts)
  * \param text The message body.
  */
 Message::Message(uint timestamp, uint type, const QString &text)
-    : mPriv(new Private(MessagePartList() << MessagePart() << MessagePart()))
+    : mPriv(new Private(textMessageParts(type, text, static_cast<qlonglong>(timestamp))))
 {
-    mPriv->parts[0].insert(QLatin1String("message-sent"),
-            QDBusVariant(static_cast<qlonglong>(timestamp)));
-    mPriv->parts[0].insert(QLatin1String("message-type"),
-            QDBusVariant(type));
-
-    mPriv->parts[1].insert(QLatin1String("content-type"),
-            QDBusVariant(QLatin1String("text/plain")));
-    mPriv->parts[1].insert(QLatin1String("content"), QDBusVariant(text));
 }
 
 /**
@@ -186,14 +334,8 @@ Message::Message(uint timestamp, uint type, const QString &text)
  * \param text The message body.
  */
 Message::Message(ChannelTextMessageType type, const QString &text)
-    : mPriv(new Private(MessagePartList() << MessagePart() << MessagePart()))
+    : mPriv(new Private(textMessageParts(static_cast<uint>(type), text)))
 {
-    mPriv->parts[0].insert(QLatin1String("message-type"),
-            QDBusVariant(static_cast<uint>(type)));
-
-    mPriv->parts[1].insert(QLatin1String("content-type"),
-            QDBusVariant(QLatin1String("text/plain")));
-    mPriv->parts[1].insert(QLatin1String("content"), QDBusVariant(text));
 }
 
 /**
@@ -240,7 +382,7 @@ Message::~Message()
 QDateTime Message::sent() const
 {
     // FIXME See http://bugs.freedesktop.org/show_bug.cgi?id=21690
-    uint stamp = valueFromPart(mPriv->parts, 0, "message-sent").toUInt();
+    uint stamp = mPriv->parsedView.sent;
     if (stamp != 0) {
 #if QT_VERSION < QT_VERSION_CHECK(5, 8, 0)
         return QDateTime::fromTime_t(stamp);
@@ -260,7 +402,7 @@ QDateTime Message::sent() const
  */
 ChannelTextMessageType Message::messageType() const
 {
-    uint raw = valueFromPart(mPriv->parts, 0, "message-type").toUInt();
+    uint raw = mPriv->parsedView.messageType;
 
     if (raw < static_cast<uint>(NUM_CHANNEL_TEXT_MESSAGE_TYPES)) {
         return ChannelTextMessageType(raw);
@@ -276,12 +418,7 @@ ChannelTextMessageType Message::messageType() const
  */
 bool Message::isTruncated() const
 {
-    for (int i = 1; i < size(); i++) {
-        if (booleanFromPart(mPriv->parts, i, "truncated", false)) {
-            return true;
-        }
-    }
-    return false;
+    return mPriv->parsedView.truncated;
 }
 
 /**
@@ -293,38 +430,7 @@ bool Message::isTruncated() const
  */
 bool Message::hasNonTextContent() const
 {
-    if (mPriv->forceNonText || size() <= 1 || isSpecificToDBusInterface()) {
-        return true;
-    }
-
-    QSet<QString> texts;
-    QSet<QString> textNeeded;
-
-    for (int i = 1; i < size(); i++) {
-        QString altGroup = stringOrEmptyFromPart(mPriv->parts, i, "alternative");
-        QString contentType = stringOrEmptyFromPart(mPriv->parts, i, "content-type");
-
-        if (contentType == QLatin1String("text/plain")) {
-            if (!altGroup.isEmpty()) {
-                // we can use this as an alternative for a non-text part
-                // with the same altGroup
-                texts << altGroup;
-            }
-        } else {
-            QString alt = stringOrEmptyFromPart(mPriv->parts, i, "alternative");
-            if (altGroup.isEmpty()) {
-                // we can't possibly rescue this part by using a text/plain
-                // alternative, because it's not in any alternative group
-                return true;
-            } else {
-                // maybe we'll find a text/plain alternative for this
-                textNeeded << altGroup;
-            }
-        }
-    }
-
-    textNeeded -= texts;
-    return !textNeeded.isEmpty();
+    return mPriv->forceNonText || mPriv->parsedView.nonText;
 }
 
 /**
@@ -335,7 +441,7 @@ bool Message::hasNonTextContent() const
  */
 QString Message::messageToken() const
 {
-    return stringOrEmptyFromPart(mPriv->parts, 0, "message-token");
+    return mPriv->parsedView.messageToken;
 }
 
 /**
@@ -365,7 +471,7 @@ bool Message::isSpecificToDBusInterface() const
  */
 QString Message::dbusInterface() const
 {
-    return stringOrEmptyFromPart(mPriv->parts, 0, "interface");
+    return mPriv->parsedView.dbusInterface;
 }
 
 /**
@@ -375,38 +481,7 @@ QString Message::dbusInterface() const
  */
 QString Message::text() const
 {
-    // Alternative-groups for which we've already emitted an alternative
-    QSet<QString> altGroupsUsed;
-    QString text;
-
-    for (int i = 1; i < size(); i++) {
-        const QString contentType = stringOrEmptyFromPart(mPriv->parts, i, "content-type");
-
-        if (contentType == QLatin1String("text/plain")) {
-            const QString interface = valueFromPart(mPriv->parts, i, "interface").toString();
-            if (!interface.isEmpty()) {
-                continue;
-            }
-            const QString altGroup = stringOrEmptyFromPart(mPriv->parts, i, "alternative");
-            if (!altGroup.isEmpty()) {
-                if (altGroupsUsed.contains(altGroup)) {
-                    continue;
-                } else {
-                    altGroupsUsed << altGroup;
-                }
-            }
-
-            QVariant content = valueFromPart(mPriv->parts, i, "content");
-            if (content.type() == QVariant::String) {
-                text += content.toString();
-            } else {
-                // O RLY?
-                debug() << "allegedly text/plain part wasn't";
-            }
-        }
-    }
-
-    return text;
+    return mPriv->parsedView.text;
 }
 
 /**
@@ -728,17 +803,8 @@ ReceivedMessage::ReceivedMessage()
  */
 ReceivedMessage::ReceivedMessage(const MessagePartList &parts,
         const TextChannelPtr &channel)
-    : Message(parts)
+    : Message(receivedMessageParts(parts))
 {
-    if (!mPriv->parts[0].contains(QLatin1String("message-received"))) {
-        mPriv->parts[0].insert(QLatin1String("message-received"),
-                QDBusVariant(static_cast<qlonglong>(
-#if QT_VERSION < QT_VERSION_CHECK(5, 8, 0)
-                        QDateTime::currentDateTime().toTime_t())));
-#else
-                        QDateTime::currentDateTime().toSecsSinceEpoch())));
-#endif
-    }
     mPriv->textChannel = channel;
 }
 
@@ -777,7 +843,7 @@ ReceivedMessage::~ReceivedMessage()
 QDateTime ReceivedMessage::received() const
 {
     // FIXME See http://bugs.freedesktop.org/show_bug.cgi?id=21690
-    uint stamp = valueFromPart(mPriv->parts, 0, "message-received").toUInt();
+    uint stamp = mPriv->parsedView.received;
     if (stamp != 0) {
 #if QT_VERSION < QT_VERSION_CHECK(5, 8, 0)
         return QDateTime::fromTime_t(stamp);
@@ -809,7 +875,7 @@ ContactPtr ReceivedMessage::sender() const
  */
 QString ReceivedMessage::senderNickname() const
 {
-    QString ret = stringOrEmptyFromPart(mPriv->parts, 0, "sender-nickname");
+    QString ret = mPriv->parsedView.senderNickname;
     if (ret.isEmpty() && mPriv->sender) {
         ret = mPriv->sender->alias();
     }
@@ -827,7 +893,7 @@ QString ReceivedMessage::senderNickname() const
  */
 QString ReceivedMessage::supersededToken() const
 {
-    return stringOrEmptyFromPart(mPriv->parts, 0, "supersedes");
+    return mPriv->parsedView.supersededToken;
 }
 
 /**
@@ -842,7 +908,7 @@ QString ReceivedMessage::supersededToken() const
  */
 bool ReceivedMessage::isScrollback() const
 {
-    return booleanFromPart(mPriv->parts, 0, "scrollback", false);
+    return mPriv->parsedView.scrollback;
 }
 
 /**
@@ -856,7 +922,7 @@ bool ReceivedMessage::isScrollback() const
  */
 bool ReceivedMessage::isRescued() const
 {
-    return booleanFromPart(mPriv->parts, 0, "rescued", false);
+    return mPriv->parsedView.rescued;
 }
 
 /**
@@ -868,7 +934,7 @@ bool ReceivedMessage::isRescued() const
  */
 bool ReceivedMessage::isSilent() const
 {
-    return booleanFromPart(mPriv->parts, 0, "silent", false);
+    return mPriv->parsedView.silent;
 }
 
 /**
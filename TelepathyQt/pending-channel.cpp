@@ -30,6 +30,7 @@
 
 #include <TelepathyQt/Channel>
 #include <TelepathyQt/ChannelFactory>
+#include <TelepathyQt/ChannelRequest>
 #include <TelepathyQt/ClientRegistrar>
 #include <TelepathyQt/Connection>
 #include <TelepathyQt/ConnectionLowlevel>
@@ -43,8 +44,6 @@ namespace Tp
 
 struct TP_QT_NO_EXPORT PendingChannel::Private
 {
-    class FakeAccountFactory;
-
     ConnectionPtr connection;
     bool create;
     bool yours;
@@ -57,43 +56,6 @@ struct TP_QT_NO_EXPORT PendingChannel::Private
     ClientRegistrarPtr cr;
     SharedPtr<RequestTemporaryHandler> handler;
     HandledChannelNotifier *notifier;
-    static uint numHandlers;
-};
-
-uint PendingChannel::Private::numHandlers = 0;
-
-class TP_QT_NO_EXPORT PendingChannel::Private::FakeAccountFactory : public AccountFactory
-{
-public:
-    static AccountFactoryPtr create(const AccountPtr &account)
-    {
-        return AccountFactoryPtr(new FakeAccountFactory(account));
-    }
-
-    ~FakeAccountFactory() override { }
-
-    AccountPtr account() const { return mAccount; }
-
-protected:
-    AccountPtr construct(const QString &busName, const QString &objectPath,
-            const ConnectionFactoryConstPtr &connFactory,
-            const ChannelFactoryConstPtr &chanFactory,
-            const ContactFactoryConstPtr &contactFactory) const override
-    {
-        if (mAccount->objectPath() != objectPath) {
-            warning() << "Account received by the fake factory is different from original account";
-        }
-        return mAccount;
-    }
-
-private:
-    FakeAccountFactory(const AccountPtr &account)
-        : AccountFactory(account->dbusConnection(), Features()),
-          mAccount(account)
-    {
-    }
-
-    AccountPtr mAccount;
 };
 
 /**
@@ -181,22 +143,12 @@ PendingChannel::PendingChannel(const AccountPtr &account,
     mPriv->handleType = request.value(TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandleType")).toUInt();
     mPriv->handle = request.value(TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandle")).toUInt();
 
-    mPriv->cr = ClientRegistrar::create(
-            Private::FakeAccountFactory::create(account),
-            account->connectionFactory(),
-            account->channelFactory(),
-            account->contactFactory());
     mPriv->handler = RequestTemporaryHandler::create(account);
+    mPriv->cr = mPriv->handler->registrar();
     mPriv->notifier = nullptr;
     mPriv->create = create;
 
-    QString handlerName = QString(QLatin1String("TpQtRaH_%1_%2"))
-        .arg(account->dbusConnection().baseService()
-            .replace(QLatin1String(":"), QLatin1String("_"))
-            .replace(QLatin1String("."), QLatin1String("_")))
-        .arg(Private::numHandlers++);
-    if (!mPriv->cr->registerClient(mPriv->handler, handlerName, false)) {
-        warning() << "Unable to register handler" << handlerName;
+    if (!mPriv->handler->isRegistered()) {
         setFinishedWithError(TP_QT_ERROR_NOT_AVAILABLE,
                 QLatin1String("Unable to register handler"));
         return;
@@ -209,7 +161,9 @@ PendingChannel::PendingChannel(const AccountPtr &account,
             SIGNAL(channelReceived(Tp::ChannelPtr,QDateTime,Tp::ChannelRequestHints)),
             SLOT(onHandlerChannelReceived(Tp::ChannelPtr)));
 
-    handlerName = QString(QLatin1String("org.freedesktop.Telepathy.Client.%1")).arg(handlerName);
+    // All requests made through the account share one handler, which tells them apart by the
+    // channel request they satisfy
+    QString handlerName = mPriv->handler->handlerBusName();
 
     debug() << "Requesting channel through account using handler" << handlerName;
     PendingChannelRequest *pcr;
@@ -218,6 +172,13 @@ PendingChannel::PendingChannel(const AccountPtr &account,
     } else {
         pcr = account->ensureChannel(request, userActionTime, handlerName, ChannelRequestHints());
     }
+    if (pcr->channelRequest()) {
+        onChannelRequestCreated(pcr->channelRequest());
+    } else {
+        connect(pcr,
+                SIGNAL(channelRequestCreated(Tp::ChannelRequestPtr)),
+                SLOT(onChannelRequestCreated(Tp::ChannelRequestPtr)));
+    }
     connect(pcr,
             SIGNAL(finished(Tp::PendingOperation*)),
             SLOT(onAccountCreateChannelFinished(Tp::PendingOperation*)));
@@ -481,6 +442,11 @@ void PendingChannel::onChannelReady(PendingOperation *op)
     }
 }
 
+void PendingChannel::onChannelRequestCreated(const Tp::ChannelRequestPtr &channelRequest)
+{
+    mPriv->handler->setChannelRequest(channelRequest->objectPath());
+}
+
 void PendingChannel::onHandlerError(const QString &errorName, const QString &errorMessage)
 {
     if (isFinished()) {
@@ -72,6 +72,7 @@ private Q_SLOTS:
             QDBusPendingCallWatcher *watcher);
     TP_QT_NO_EXPORT void onChannelReady(Tp::PendingOperation *op);
 
+    TP_QT_NO_EXPORT void onChannelRequestCreated(const Tp::ChannelRequestPtr &channelRequest);
     TP_QT_NO_EXPORT void onHandlerError(const QString &errorName,
             const QString &errorMessage);
     TP_QT_NO_EXPORT void onHandlerChannelReceived(
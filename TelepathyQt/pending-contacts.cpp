@@ -36,6 +36,8 @@
 #include <TelepathyQt/PendingHandles>
 #include <TelepathyQt/ReferencedHandles>
 
+#include <QVector>
+
 // FIXME: Refactor PendingContacts code to make it more readable/maintainable and reuse common code
 //        when appropriate.
 
@@ -87,6 +89,20 @@ struct TP_QT_NO_EXPORT PendingContacts::Private
     {
     }
 
+    Private(PendingContacts *parent, const ContactManagerPtr &manager,
+            PendingContacts::RequestType type, const QString &vcardField,
+            const QStringList &list, const Features &features)
+        : parent(parent),
+          manager(manager),
+          features(features),
+          missingFeatures(features),
+          requestType(type),
+          addresses(list),
+          vcardField(vcardField),
+          nested(nullptr)
+    {
+    }
+
     Private(PendingContacts *parent,
             const ContactManagerPtr &manager, const QList<ContactPtr> &contactsToUpgrade,
             const Features &features)
@@ -129,6 +145,13 @@ struct TP_QT_NO_EXPORT PendingContacts::Private
     QStringList invalidAddresses;
 
     ReferencedHandles handlesToInspect;
+
+    // Attribute requests we're waiting for, possibly shared with other PendingContacts, and what
+    // they have brought in so far for the handles we asked for
+    QSet<uint> handlesToFetch;
+    QSet<PendingOperation *> attributesInFlight;
+    QHash<uint, ReferencedHandles> fetchedHandles;
+    QHash<uint, QVariantMap> fetchedAttributes;
 };
 
 void PendingContacts::Private::setFinished()
@@ -196,13 +219,18 @@ PendingContacts::PendingContacts(const ContactManagerPtr &manager,
     if (!otherContacts.isEmpty()) {
         ConnectionPtr conn = manager->connection();
         if (conn->interfaces().contains(TP_QT_IFACE_CONNECTION_INTERFACE_CONTACTS)) {
-            PendingContactAttributes *attributes =
-                conn->lowlevel()->contactAttributes(otherContacts.toList(),
-                        interfaces, true);
-
-            connect(attributes,
-                    SIGNAL(finished(Tp::PendingOperation*)),
-                    SLOT(onAttributesFinished(Tp::PendingOperation*)));
+            mPriv->handlesToFetch = otherContacts;
+
+            // The manager hands out requests other PendingContacts already have in flight where
+            // they cover what we need, and only requests the rest
+            QList<PendingContactAttributes *> attributesList =
+                manager->contactAttributes(otherContacts, interfaces.toSet());
+            foreach (PendingContactAttributes *attributes, attributesList) {
+                mPriv->attributesInFlight.insert(attributes);
+                connect(attributes,
+                        SIGNAL(finished(Tp::PendingOperation*)),
+                        SLOT(onAttributesFinished(Tp::PendingOperation*)));
+            }
         } else {
             // fallback to just create the contacts
             PendingHandles *handles = conn->lowlevel()->referenceHandles(HandleTypeContact,
@@ -305,6 +333,14 @@ PendingContacts::PendingContacts(const ContactManagerPtr &manager,
             SLOT(onNestedFinished(Tp::PendingOperation*)));
 }
 
+PendingContacts::PendingContacts(const ContactManagerPtr &manager,
+        RequestType requestType, const QString &vcardField, const QStringList &list,
+        const Features &features)
+    : PendingOperation(manager->connection()),
+      mPriv(new Private(this, manager, requestType, vcardField, list, features))
+{
+}
+
 /**
  * Class destructor.
  */
@@ -484,6 +520,13 @@ void PendingContacts::onAttributesFinished(PendingOperation *operation)
     PendingContactAttributes *pendingAttributes =
         qobject_cast<PendingContactAttributes *>(operation);
 
+    mPriv->attributesInFlight.remove(operation);
+
+    if (isFinished()) {
+        // Another request we were waiting for already failed
+        return;
+    }
+
     if (pendingAttributes->isError()) {
         debug() << "PendingAttrs error" << pendingAttributes->errorName()
                 << "message" << pendingAttributes->errorMessage();
@@ -491,22 +534,46 @@ void PendingContacts::onAttributesFinished(PendingOperation *operation)
         return;
     }
 
+    // The request may be shared with other PendingContacts and have been for more handles and/or
+    // fewer interfaces than ours, so only pick up our handles and merge what each request brings
     ReferencedHandles validHandles = pendingAttributes->validHandles();
     ContactAttributesMap attributes = pendingAttributes->attributes();
 
+    for (int i = 0; i < validHandles.size(); ++i) {
+        uint handle = validHandles.at(i);
+        if (!mPriv->handlesToFetch.contains(handle)) {
+            continue;
+        }
+
+        if (!mPriv->fetchedHandles.contains(handle)) {
+            mPriv->fetchedHandles.insert(handle, validHandles.mid(i, 1));
+        }
+
+        QVariantMap &handleAttributes = mPriv->fetchedAttributes[handle];
+        const QVariantMap newAttributes = attributes.value(handle);
+        for (QVariantMap::const_iterator j = newAttributes.constBegin();
+                j != newAttributes.constEnd(); ++j) {
+            handleAttributes.insert(j.key(), j.value());
+        }
+    }
+
+    if (!mPriv->attributesInFlight.isEmpty()) {
+        return;
+    }
+
     foreach (uint handle, mPriv->handles) {
         if (!mPriv->satisfyingContacts.contains(handle)) {
-            int indexInValid = validHandles.indexOf(handle);
-            if (indexInValid >= 0) {
-                ReferencedHandles referencedHandle = validHandles.mid(indexInValid, 1);
-                QVariantMap handleAttributes = attributes[handle];
-                mPriv->satisfyingContacts.insert(handle, manager()->ensureContact(referencedHandle,
-                            mPriv->missingFeatures, handleAttributes));
+            if (mPriv->fetchedHandles.contains(handle)) {
+                mPriv->satisfyingContacts.insert(handle, manager()->ensureContact(
+                            mPriv->fetchedHandles.value(handle),
+                            mPriv->missingFeatures, mPriv->fetchedAttributes.value(handle)));
             } else {
                 mPriv->invalidHandles.push_back(handle);
             }
         }
     }
+    mPriv->fetchedHandles.clear();
+    mPriv->fetchedAttributes.clear();
 
     allAttributesFetched();
 }
@@ -631,7 +698,7 @@ void PendingContacts::onInspectHandlesFinished(QDBusPendingCallWatcher *watcher)
     ConnectionPtr conn = mPriv->manager->connection();
     foreach (uint handle, mPriv->handlesToInspect) {
         QVariantMap handleAttributes;
-        handleAttributes.insert(TP_QT_IFACE_CONNECTION + QLatin1String("/contact-id"),
+        handleAttributes.insert(TP_QT_TOKEN_CONNECTION_CONTACT_ID,
                 names[i++]);
         ReferencedHandles referencedHandle(conn, HandleTypeContact,
                 UIntList() << handle);
@@ -655,6 +722,223 @@ void PendingContacts::allAttributesFetched()
     mPriv->setFinished();
 }
 
+struct TP_QT_NO_EXPORT PendingBatchedContacts::Private
+{
+    Private(int batchSize, int maxBatchesInFlight)
+        : batchSize(qMax(batchSize, 1)),
+          maxBatchesInFlight(qMax(maxBatchesInFlight, 1)),
+          batchCount(0),
+          nextBatch(0),
+          finishedBatches(0)
+    {
+    }
+
+    int batchSize;
+    int maxBatchesInFlight;
+
+    int batchCount;
+    int nextBatch;
+    int finishedBatches;
+    QHash<PendingOperation *, int> batchesInFlight;
+
+    // Per batch results, merged in request order once the last batch is in
+    QVector<QList<ContactPtr> > batchContacts;
+    QVector<QStringList> batchValid;
+    QVector<QStringList> batchInvalid;
+};
+
+/**
+ * \class PendingBatchedContacts
+ * \ingroup clientconn
+ * \headerfile TelepathyQt/pending-contacts.h <TelepathyQt/PendingBatchedContacts>
+ *
+ * \brief The PendingBatchedContacts class is a PendingContacts which splits a
+ * large request into batches.
+ *
+ * Instead of resolving all the identifiers or addresses in a single D-Bus call, which for
+ * very large requests can run into message size limits or connection manager timeouts, the
+ * request is split into batches of batchSize() elements, of which at most
+ * maxBatchesInFlight() are in progress at any time.
+ *
+ * The contacts of each batch are reported by contactsRetrieved() as soon as that batch is done.
+ * Once all batches are done, the accessors inherited from PendingContacts return the merged
+ * results of every batch, in the order of the original request. If any batch fails the whole
+ * operation fails with the same error and no further batches are started.
+ *
+ * Instances of this class cannot be constructed directly; the only way to get one is via
+ * ContactManager.
+ *
+ * See \ref async_model
+ */
+
+PendingBatchedContacts::PendingBatchedContacts(const ContactManagerPtr &manager,
+        RequestType requestType, const QString &vcardField, const QStringList &list,
+        const Features &features, int batchSize, int maxBatchesInFlight,
+        const QString &errorName, const QString &errorMessage)
+    : PendingContacts(manager, requestType, vcardField, list, features),
+      mPriv(new Private(batchSize, maxBatchesInFlight))
+{
+    if (!errorName.isEmpty()) {
+        setFinishedWithError(errorName, errorMessage);
+        return;
+    }
+
+    mPriv->batchCount = (list.size() + mPriv->batchSize - 1) / mPriv->batchSize;
+    mPriv->batchContacts.resize(mPriv->batchCount);
+    mPriv->batchValid.resize(mPriv->batchCount);
+    mPriv->batchInvalid.resize(mPriv->batchCount);
+
+    if (mPriv->batchCount == 0) {
+        setFinished();
+        return;
+    }
+
+    startBatches();
+}
+
+/**
+ * Class destructor.
+ */
+PendingBatchedContacts::~PendingBatchedContacts()
+{
+    delete mPriv;
+}
+
+/**
+ * Return the maximum number of elements requested in a single batch.
+ *
+ * \return The batch size.
+ */
+int PendingBatchedContacts::batchSize() const
+{
+    return mPriv->batchSize;
+}
+
+/**
+ * Return the maximum number of batches which are in progress at the same time.
+ *
+ * \return The maximum number of batches in flight.
+ */
+int PendingBatchedContacts::maxBatchesInFlight() const
+{
+    return mPriv->maxBatchesInFlight;
+}
+
+/**
+ * Return the number of batches the request has been split into.
+ *
+ * \return The number of batches.
+ */
+int PendingBatchedContacts::batchCount() const
+{
+    return mPriv->batchCount;
+}
+
+/**
+ * Return the number of batches which have been completed so far.
+ *
+ * \return The number of completed batches.
+ * \sa contactsRetrieved()
+ */
+int PendingBatchedContacts::finishedBatchCount() const
+{
+    return mPriv->finishedBatches;
+}
+
+/**
+ * \fn void PendingBatchedContacts::contactsRetrieved(const QList<Tp::ContactPtr> &contacts)
+ *
+ * Emitted whenever a batch has been completed, before finished() is emitted.
+ *
+ * \param contacts The contacts retrieved by the batch.
+ * \sa finishedBatchCount()
+ */
+
+void PendingBatchedContacts::startBatches()
+{
+    ContactManagerPtr manager = this->manager();
+    const QStringList &list = PendingContacts::mPriv->addresses;
+
+    while (mPriv->batchesInFlight.size() < mPriv->maxBatchesInFlight &&
+           mPriv->nextBatch < mPriv->batchCount) {
+        int batch = mPriv->nextBatch++;
+        QStringList batchList = list.mid(batch * mPriv->batchSize, mPriv->batchSize);
+
+        PendingContacts *pending;
+        if (isForIdentifiers()) {
+            pending = manager->contactsForIdentifiers(batchList, features());
+        } else if (isForVCardAddresses()) {
+            pending = manager->contactsForVCardAddresses(vcardField(), batchList, features());
+        } else {
+            Q_ASSERT(isForUris());
+            pending = manager->contactsForUris(batchList, features());
+        }
+
+        debug() << "Requesting batch" << batch + 1 << "of" << mPriv->batchCount <<
+            "with" << batchList.size() << "elements";
+
+        mPriv->batchesInFlight.insert(pending, batch);
+        connect(pending,
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(onBatchFinished(Tp::PendingOperation*)));
+    }
+}
+
+void PendingBatchedContacts::onBatchFinished(PendingOperation *operation)
+{
+    int batch = mPriv->batchesInFlight.take(operation);
+
+    if (isFinished()) {
+        // An earlier batch failed, the rest is of no interest anymore
+        return;
+    }
+
+    if (operation->isError()) {
+        debug() << "Batch" << batch + 1 << "of" << mPriv->batchCount << "failed with" <<
+            operation->errorName() << "message" << operation->errorMessage();
+        setFinishedWithError(operation->errorName(), operation->errorMessage());
+        return;
+    }
+
+    PendingContacts *pending = qobject_cast<PendingContacts *>(operation);
+    QList<ContactPtr> contacts = pending->contacts();
+    mPriv->batchContacts[batch] = contacts;
+
+    if (isForIdentifiers()) {
+        mPriv->batchValid[batch] = pending->validIdentifiers();
+        PendingContacts::mPriv->invalidIds.unite(pending->invalidIdentifiers());
+    } else if (isForVCardAddresses()) {
+        mPriv->batchValid[batch] = pending->validVCardAddresses();
+        mPriv->batchInvalid[batch] = pending->invalidVCardAddresses();
+    } else {
+        mPriv->batchValid[batch] = pending->validUris();
+        mPriv->batchInvalid[batch] = pending->invalidUris();
+    }
+
+    ++mPriv->finishedBatches;
+    emit contactsRetrieved(contacts);
+
+    if (mPriv->finishedBatches < mPriv->batchCount) {
+        startBatches();
+        return;
+    }
+
+    for (int i = 0; i < mPriv->batchCount; ++i) {
+        PendingContacts::mPriv->contacts.append(mPriv->batchContacts[i]);
+        if (isForIdentifiers()) {
+            PendingContacts::mPriv->validIds.append(mPriv->batchValid[i]);
+        } else {
+            PendingContacts::mPriv->validAddresses.append(mPriv->batchValid[i]);
+            PendingContacts::mPriv->invalidAddresses.append(mPriv->batchInvalid[i]);
+        }
+    }
+    mPriv->batchContacts.clear();
+    mPriv->batchValid.clear();
+    mPriv->batchInvalid.clear();
+
+    setFinished();
+}
+
 PendingAddressingGetContacts::PendingAddressingGetContacts(const ConnectionPtr &connection,
         const QString &vcardField, const QStringList &vcardAddresses,
         const QStringList &interfaces)
@@ -89,6 +89,7 @@ private Q_SLOTS:
 
 private:
     friend class ContactManager;
+    friend class PendingBatchedContacts;
 
     enum RequestType
     {
@@ -124,6 +125,10 @@ private:
             const Features &features,
             const QString &errorName = QString(),
             const QString &errorMessage = QString());
+    // Only records the request, for subclasses doing the actual work themselves
+    TP_QT_NO_EXPORT PendingContacts(const ContactManagerPtr &manager, RequestType requestType,
+            const QString &vcardField, const QStringList &list,
+            const Features &features);
 
     TP_QT_NO_EXPORT void allAttributesFetched();
 
@@ -132,6 +137,42 @@ private:
     Private *mPriv;
 };
 
+class TP_QT_EXPORT PendingBatchedContacts : public PendingContacts
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(PendingBatchedContacts);
+
+public:
+    ~PendingBatchedContacts() override;
+
+    int batchSize() const;
+    int maxBatchesInFlight() const;
+
+    int batchCount() const;
+    int finishedBatchCount() const;
+
+Q_SIGNALS:
+    void contactsRetrieved(const QList<Tp::ContactPtr> &contacts);
+
+private Q_SLOTS:
+    TP_QT_NO_EXPORT void onBatchFinished(Tp::PendingOperation *);
+
+private:
+    friend class ContactManager;
+
+    TP_QT_NO_EXPORT PendingBatchedContacts(const ContactManagerPtr &manager,
+            RequestType requestType, const QString &vcardField, const QStringList &list,
+            const Features &features, int batchSize, int maxBatchesInFlight,
+            const QString &errorName = QString(),
+            const QString &errorMessage = QString());
+
+    TP_QT_NO_EXPORT void startBatches();
+
+    struct Private;
+    friend struct Private;
+    Private *mPriv;
+};
+
 } // Tp
 
 #endif
@@ -31,8 +31,13 @@
 
 #include "TelepathyQt/debug-internal.h"
 
+#include <QCoreApplication>
 #include <QDBusPendingCall>
 #include <QDBusPendingCallWatcher>
+#include <QEvent>
+#include <QPointer>
+#include <QThread>
+#include <QThreadStorage>
 #include <QTimer>
 
 namespace Tp
@@ -42,16 +47,126 @@ struct TP_QT_NO_EXPORT PendingOperation::Private
 {
     Private(const SharedPtr<RefCounted> &object)
         : object(object),
-          finished(false)
+          finished(false),
+          finishedByFinisher(false)
     {
     }
 
+    static void finishLater(PendingOperation *operation);
+
     SharedPtr<RefCounted> object;
     QString errorName;
     QString errorMessage;
     bool finished;
+    bool finishedByFinisher;
+    QList<QPointer<PendingComposite> > composites;
+};
+
+/*
+ * Emits finished() for the operations of one thread, and deletes them afterwards.
+ *
+ * All the operations set finished before the event loop runs again are handled by a single posted
+ * event, instead of a queued call each. They are then deleted with a single DeferredDelete event,
+ * instead of a deleteLater() each, so their lifetime doesn't change.
+ */
+class TP_QT_NO_EXPORT PendingOperationFinisher : public QObject
+{
+public:
+    static void finishLater(PendingOperation *operation);
+
+protected:
+    bool event(QEvent *event) override;
+
+private:
+    static QEvent::Type finishEventType();
+
+    QList<QPointer<PendingOperation> > queue;
 };
 
+namespace
+{
+
+class FinishedOperations : public QObject
+{
+public:
+    ~FinishedOperations() override
+    {
+        foreach (const QPointer<PendingOperation> &operation, operations) {
+            delete operation.data();
+        }
+    }
+
+    QList<QPointer<PendingOperation> > operations;
+};
+
+QThreadStorage<PendingOperationFinisher *> finishers;
+
+}
+
+QEvent::Type PendingOperationFinisher::finishEventType()
+{
+    static const int type = QEvent::registerEventType();
+    return static_cast<QEvent::Type>(type);
+}
+
+void PendingOperationFinisher::finishLater(PendingOperation *operation)
+{
+    if (!finishers.hasLocalData()) {
+        finishers.setLocalData(new PendingOperationFinisher);
+    }
+
+    PendingOperationFinisher *finisher = finishers.localData();
+    if (finisher->queue.isEmpty()) {
+        QCoreApplication::postEvent(finisher, new QEvent(finishEventType()));
+    }
+    finisher->queue.append(QPointer<PendingOperation>(operation));
+}
+
+bool PendingOperationFinisher::event(QEvent *event)
+{
+    if (event->type() != finishEventType()) {
+        return QObject::event(event);
+    }
+
+    // Operations set finished by the finished() handlers go to the next event
+    QList<QPointer<PendingOperation> > batch;
+    batch.swap(queue);
+
+    // Each operation joins the batch to delete only once finished() has been emitted for it, so
+    // that flushing DeferredDelete events from a handler doesn't delete it earlier than
+    // deleteLater() would have
+    QPointer<FinishedOperations> finished;
+    foreach (const QPointer<PendingOperation> &operation, batch) {
+        if (!operation) {
+            continue;
+        }
+
+        operation->emitFinished();
+
+        if (!operation) {
+            continue;
+        }
+
+        if (!finished) {
+            finished = new FinishedOperations;
+            finished->deleteLater();
+        }
+        finished->operations.append(operation);
+    }
+
+    return true;
+}
+
+void PendingOperation::Private::finishLater(PendingOperation *operation)
+{
+    if (operation->thread() == QThread::currentThread()) {
+        operation->mPriv->finishedByFinisher = true;
+        PendingOperationFinisher::finishLater(operation);
+    } else {
+        QTimer::singleShot(0, operation, SLOT(emitFinished()));
+    }
+}
+
 /**
  * \class PendingOperation
  * \headerfile TelepathyQt/pending-operation.h <TelepathyQt/PendingOperation>
@@ -74,8 +189,8 @@ struct TP_QT_NO_EXPORT PendingOperation::Private
  * result to the library user.
  *
  * After finished() is emitted, the PendingOperation is automatically
- * deleted using deleteLater(), so library users must not explicitly
- * delete this object.
+ * deleted when control returns to the event loop, as with deleteLater(), so
+ * library users must not explicitly delete this object.
  *
  * The design is loosely based on KDE's KJob.
  *
@@ -121,7 +236,18 @@ void PendingOperation::emitFinished()
 {
     Q_ASSERT(mPriv->finished);
     emit finished(this);
-    deleteLater();
+
+    // PendingComposite doesn't connect to finished(), saving a connection per operation
+    QList<QPointer<PendingComposite> > composites = mPriv->composites;
+    foreach (const QPointer<PendingComposite> &composite, composites) {
+        if (composite) {
+            composite->onOperationFinished(this);
+        }
+    }
+
+    if (!mPriv->finishedByFinisher) {
+        deleteLater();
+    }
 }
 
 /**
@@ -143,7 +269,7 @@ void PendingOperation::setFinished()
 
     mPriv->finished = true;
     Q_ASSERT(isValid());
-    QTimer::singleShot(0, this, SLOT(emitFinished()));
+    Private::finishLater(this);
 }
 
 /**
@@ -178,7 +304,7 @@ void PendingOperation::setFinishedWithError(const QString &name,
     mPriv->errorMessage = message;
     mPriv->finished = true;
     Q_ASSERT(isError());
-    QTimer::singleShot(0, this, SLOT(emitFinished()));
+    Private::finishLater(this);
 }
 
 /**
@@ -364,9 +490,7 @@ PendingComposite::PendingComposite(const QList<PendingOperation*> &operations,
       mPriv(new Private(true, operations.size()))
 {
     foreach (PendingOperation *operation, operations) {
-        connect(operation,
-                SIGNAL(finished(Tp::PendingOperation*)),
-                SLOT(onOperationFinished(Tp::PendingOperation*)));
+        operation->mPriv->composites.append(QPointer<PendingComposite>(this));
     }
 }
 
@@ -376,9 +500,7 @@ PendingComposite::PendingComposite(const QList<PendingOperation*> &operations,
       mPriv(new Private(failOnFirstError, operations.size()))
 {
     foreach (PendingOperation *operation, operations) {
-        connect(operation,
-                SIGNAL(finished(Tp::PendingOperation*)),
-                SLOT(onOperationFinished(Tp::PendingOperation*)));
+        operation->mPriv->composites.append(QPointer<PendingComposite>(this));
     }
 }
 
@@ -75,6 +75,8 @@ private Q_SLOTS:
 
 private:
     friend class ContactManager;
+    friend class PendingComposite;
+    friend class PendingOperationFinisher;
     friend class ReadinessHelper;
 
     struct Private;
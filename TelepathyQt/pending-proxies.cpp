@@ -0,0 +1,134 @@
+/**
+ * This file is part of TelepathyQt
+ *
+ * @copyright Copyright (C) 2026 Collabora Ltd. <http://www.collabora.co.uk/>
+ * @license LGPL 2.1
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include <TelepathyQt/PendingProxies>
+
+#include "TelepathyQt/_gen/pending-proxies.moc.hpp"
+
+#include "TelepathyQt/debug-internal.h"
+
+#include <TelepathyQt/DBusProxy>
+#include <TelepathyQt/PendingReady>
+
+namespace Tp
+{
+
+struct TP_QT_NO_EXPORT PendingProxies::Private
+{
+    Private(int pending)
+        : pending(pending)
+    {
+    }
+
+    QList<DBusProxyPtr> proxies;
+    int pending;
+    QString errorName;
+    QString errorMessage;
+};
+
+/**
+ * \class PendingProxies
+ * \ingroup utils
+ * \headerfile TelepathyQt/pending-proxies.h <TelepathyQt/PendingProxies>
+ *
+ * \brief The PendingProxies class represents a set of proxies being prepared
+ * by a DBusProxyFactory.
+ *
+ * Instances of this class cannot be constructed directly; the only way to get
+ * one is via a DBusProxyFactory subclass, for example AccountFactory::proxies() or
+ * ChannelFactory::proxies().
+ *
+ * The proxies are all made ready concurrently. The operation finishes once every
+ * one of them has either been made ready or failed to become ready. If any of them
+ * failed, the operation finishes with the first error encountered, but the remaining
+ * proxies are ready nevertheless.
+ *
+ * See \ref async_model
+ */
+
+/**
+ * Construct a new PendingProxies object.
+ *
+ * \param factory The factory the proxies are from.
+ * \param readyOps The operations preparing each proxy.
+ */
+PendingProxies::PendingProxies(const SharedPtr<DBusProxyFactory> &factory,
+        const QList<PendingReady*> &readyOps)
+    : PendingOperation(factory),
+      mPriv(new Private(readyOps.size()))
+{
+    mPriv->proxies.reserve(readyOps.size());
+    foreach (PendingReady *readyOp, readyOps) {
+        mPriv->proxies.append(readyOp->proxy());
+        connect(readyOp,
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(onProxyReady(Tp::PendingOperation*)));
+    }
+
+    if (readyOps.isEmpty()) {
+        setFinished();
+    }
+}
+
+/**
+ * Class destructor.
+ */
+PendingProxies::~PendingProxies()
+{
+    delete mPriv;
+}
+
+/**
+ * Return the proxies being prepared.
+ *
+ * The proxies can be accessed immediately, before the operation finishes, if they are
+ * needed in a context where they are not required to be ready.
+ *
+ * \return A list of pointers to the DBusProxy objects, in the order they were
+ *         requested in.
+ */
+QList<DBusProxyPtr> PendingProxies::proxies() const
+{
+    return mPriv->proxies;
+}
+
+void PendingProxies::onProxyReady(Tp::PendingOperation *op)
+{
+    if (op->isError() && mPriv->errorName.isEmpty()) {
+        mPriv->errorName = op->errorName();
+        mPriv->errorMessage = op->errorMessage();
+    }
+
+    if (--mPriv->pending > 0) {
+        return;
+    }
+
+    if (mPriv->errorName.isEmpty()) {
+        setFinished();
+    } else {
+        warning() << "Not all of" << mPriv->proxies.size() << "proxies could be made ready:"
+            << mPriv->errorName << ":" << mPriv->errorMessage;
+        setFinishedWithError(mPriv->errorName, mPriv->errorMessage);
+    }
+}
+
+} // Tp
@@ -26,20 +26,23 @@
 
 #include "TelepathyQt/debug-internal.h"
 
+#include <TelepathyQt/AccountFactory>
 #include <TelepathyQt/ChannelClassSpecList>
+#include <TelepathyQt/ChannelRequest>
+#include <TelepathyQt/ChannelRequestHints>
 
 namespace Tp
 {
 
 SharedPtr<RequestTemporaryHandler> RequestTemporaryHandler::create(const AccountPtr &account)
 {
-    return SharedPtr<RequestTemporaryHandler>(new RequestTemporaryHandler(account));
+    SharedPtr<RequestTemporaryHandler> handler(new RequestTemporaryHandler(account));
+    handler->mHost = RequestTemporaryHandlerHost::ensure(account, &handler->mRegistrar);
+    return handler;
 }
 
 RequestTemporaryHandler::RequestTemporaryHandler(const AccountPtr &account)
-    : AbstractClient(),
-      QObject(),
-      AbstractClientHandler(ChannelClassSpecList(), AbstractClientHandler::Capabilities(), false),
+    : QObject(),
       mAccount(account),
       mQueueChannelReceived(true),
       dbusHandlerInvoked(false)
@@ -47,10 +50,170 @@ RequestTemporaryHandler::RequestTemporaryHandler(const AccountPtr &account)
 }
 
 RequestTemporaryHandler::~RequestTemporaryHandler()
+{
+    if (mHost) {
+        mHost->unregisterHandler(this);
+    }
+}
+
+QString RequestTemporaryHandler::handlerBusName() const
+{
+    return mHost ? mHost->busName() : QString();
+}
+
+void RequestTemporaryHandler::setChannelRequest(const QString &requestPath)
+{
+    Q_ASSERT(mRequestPath.isEmpty());
+
+    mRequestPath = requestPath;
+    if (mHost) {
+        mHost->registerRequest(requestPath, this);
+    }
+}
+
+void RequestTemporaryHandler::handleChannel(const ChannelPtr &channel,
+        const QDateTime &userActionTime, const ChannelRequestHints &requestHints)
+{
+    ChannelPtr oldChannel = this->channel();
+    if (!oldChannel) {
+        mChannel = WeakPtr<Channel>(channel);
+        emit channelReceived(channel, userActionTime, requestHints);
+    } else {
+        if (mQueueChannelReceived) {
+            mChannelReceivedQueue.enqueue(qMakePair(userActionTime, requestHints));
+        } else {
+            emit channelReceived(oldChannel, userActionTime, requestHints);
+        }
+    }
+}
+
+void RequestTemporaryHandler::setQueueChannelReceived(bool queue)
+{
+    mQueueChannelReceived = queue;
+    if (!queue) {
+        processChannelReceivedQueue();
+    }
+}
+
+void RequestTemporaryHandler::setDBusHandlerInvoked()
+{
+    dbusHandlerInvoked = true;
+}
+
+void RequestTemporaryHandler::setDBusHandlerErrored(const QString &errorName, const QString &errorMessage)
+{
+    Q_ASSERT(dbusHandlerInvoked);
+    if (!channel()) {
+        emit error(errorName, errorMessage);
+    }
+}
+
+void RequestTemporaryHandler::processChannelReceivedQueue()
+{
+    while (!mChannelReceivedQueue.isEmpty()) {
+        QPair<QDateTime, ChannelRequestHints> info = mChannelReceivedQueue.dequeue();
+        emit channelReceived(channel(), info.first, info.second);
+    }
+}
+
+class TP_QT_NO_EXPORT RequestTemporaryHandlerHost::FakeAccountFactory : public AccountFactory
+{
+public:
+    static AccountFactoryPtr create(const AccountPtr &account)
+    {
+        return AccountFactoryPtr(new FakeAccountFactory(account));
+    }
+
+    ~FakeAccountFactory() override { }
+
+    AccountPtr account() const { return mAccount; }
+
+protected:
+    AccountPtr construct(const QString &busName, const QString &objectPath,
+            const ConnectionFactoryConstPtr &connFactory,
+            const ChannelFactoryConstPtr &chanFactory,
+            const ContactFactoryConstPtr &contactFactory) const override
+    {
+        if (mAccount->objectPath() != objectPath) {
+            warning() << "Account received by the fake factory is different from original account";
+        }
+        return mAccount;
+    }
+
+private:
+    FakeAccountFactory(const AccountPtr &account)
+        : AccountFactory(account->dbusConnection(), Features()),
+          mAccount(account)
+    {
+    }
+
+    AccountPtr mAccount;
+};
+
+QHash<Account *, RequestTemporaryHandlerHost *> RequestTemporaryHandlerHost::hosts;
+uint RequestTemporaryHandlerHost::numHandlers = 0;
+
+/*
+ * Return the handler shared by all requests made through \a account, registering it on the bus
+ * if there is none yet.
+ *
+ * The host is kept alive by its registrar, which is returned in \a registrar and must be held
+ * for as long as the host is used. A null pointer is returned if the handler couldn't be
+ * registered.
+ */
+SharedPtr<RequestTemporaryHandlerHost> RequestTemporaryHandlerHost::ensure(
+        const AccountPtr &account, ClientRegistrarPtr *registrar)
+{
+    RequestTemporaryHandlerHost *existing = hosts.value(account.data());
+    if (existing) {
+        *registrar = ClientRegistrarPtr(existing->mRegistrar);
+        if (*registrar) {
+            return SharedPtr<RequestTemporaryHandlerHost>(existing);
+        }
+    }
+
+    ClientRegistrarPtr cr = ClientRegistrar::create(
+            FakeAccountFactory::create(account),
+            account->connectionFactory(),
+            account->channelFactory(),
+            account->contactFactory());
+    SharedPtr<RequestTemporaryHandlerHost> host(new RequestTemporaryHandlerHost(account));
+
+    QString handlerName = QString(QLatin1String("TpQtRaH_%1_%2"))
+        .arg(account->dbusConnection().baseService()
+            .replace(QLatin1String(":"), QLatin1String("_"))
+            .replace(QLatin1String("."), QLatin1String("_")))
+        .arg(numHandlers++);
+    if (!cr->registerClient(host, handlerName, false)) {
+        warning() << "Unable to register handler" << handlerName;
+        registrar->reset();
+        return SharedPtr<RequestTemporaryHandlerHost>();
+    }
+
+    host->mRegistrar = WeakPtr<ClientRegistrar>(cr);
+    host->mBusName = QString(QLatin1String("org.freedesktop.Telepathy.Client.%1")).arg(handlerName);
+    hosts.insert(account.data(), host.data());
+
+    *registrar = cr;
+    return host;
+}
+
+RequestTemporaryHandlerHost::RequestTemporaryHandlerHost(const AccountPtr &account)
+    : AbstractClient(),
+      QObject(),
+      AbstractClientHandler(ChannelClassSpecList(), AbstractClientHandler::Capabilities(), false),
+      mAccount(account)
 {
 }
 
-void RequestTemporaryHandler::handleChannels(
+RequestTemporaryHandlerHost::~RequestTemporaryHandlerHost()
+{
+    if (hosts.value(mAccount.data()) == this) {
+        hosts.remove(mAccount.data());
+    }
+}
+
+void RequestTemporaryHandlerHost::handleChannels(
         const MethodInvocationContextPtr<> &context,
         const AccountPtr &account,
         const ConnectionPtr &connection,
@@ -59,17 +222,25 @@ void RequestTemporaryHandler::handleChannels(
         const QDateTime &userActionTime,
         const HandlerInfo &handlerInfo)
 {
-    Q_ASSERT(dbusHandlerInvoked);
-
     QString errorMessage;
 
-    ChannelPtr oldChannel = channel();
+    RequestTemporaryHandler *handler = handlerFor(
+            channels.isEmpty() ? QString() : channels.first()->objectPath(),
+            requestsSatisfied.isEmpty() ? QString() : requestsSatisfied.first()->objectPath());
+    if (!requestsSatisfied.isEmpty()) {
+        mInvokedRequests.remove(requestsSatisfied.first()->objectPath());
+    }
+
+    ChannelPtr oldChannel = handler ? handler->channel() : ChannelPtr();
     if (channels.size() != 1 || requestsSatisfied.size() != 1) {
         errorMessage = QLatin1String("Only one channel and one channel request should be given "
                 "to HandleChannels");
     } else if (account != mAccount) {
         errorMessage = QLatin1String("Account received is not the same as the account which made "
                 "the request");
+    } else if (!handler) {
+        errorMessage = QLatin1String("Received a channel that was not requested through this "
+                "handler");
     } else if (oldChannel && oldChannel != channels.first()) {
         errorMessage = QLatin1String("Received a channel that is not the same as the first "
                 "one received");
@@ -80,56 +251,92 @@ void RequestTemporaryHandler::handleChannels(
             errorMessage;
 
         // Only emit error if we didn't receive any channel yet.
-        if (!oldChannel) {
-            emit error(TP_QT_ERROR_SERVICE_CONFUSED, errorMessage);
+        if (handler && !oldChannel) {
+            emit handler->error(TP_QT_ERROR_SERVICE_CONFUSED, errorMessage);
         }
         context->setFinishedWithError(TP_QT_ERROR_SERVICE_CONFUSED, errorMessage);
         return;
     }
 
-    ChannelRequestPtr channelRequest = requestsSatisfied.first();
-
     if (!oldChannel) {
-        mChannel = WeakPtr<Channel>(channels.first());
-        emit channelReceived(channel(), userActionTime, channelRequest->hints());
-    } else {
-        if (mQueueChannelReceived) {
-            mChannelReceivedQueue.enqueue(qMakePair(userActionTime, channelRequest->hints()));
-        } else {
-            emit channelReceived(oldChannel, userActionTime, channelRequest->hints());
-        }
+        mChannels.insert(channels.first()->objectPath(), handler);
     }
+    handler->handleChannel(channels.first(), userActionTime, requestsSatisfied.first()->hints());
 
     context->setFinished();
 }
 
-void RequestTemporaryHandler::setQueueChannelReceived(bool queue)
+/*
+ * Called by the adaptor as soon as HandleChannels is received, before the proxies are ready.
+ *
+ * The channel request path is registered when the dispatcher replies to CreateChannel or
+ * EnsureChannel, which normally happens before the handler is invoked, but the invocation is
+ * remembered in case the reply comes later.
+ */
+void RequestTemporaryHandlerHost::setDBusHandlerInvoked(const QStringList &channelPaths,
+        const ObjectPathList &requests)
 {
-    mQueueChannelReceived = queue;
-    if (!queue) {
-        processChannelReceivedQueue();
+    QString requestPath = requests.isEmpty() ? QString() : requests.first().path();
+    RequestTemporaryHandler *handler = handlerFor(
+            channelPaths.isEmpty() ? QString() : channelPaths.first(), requestPath);
+    if (handler) {
+        handler->setDBusHandlerInvoked();
+    } else if (!requestPath.isEmpty()) {
+        mInvokedRequests.insert(requestPath);
     }
 }
 
-void RequestTemporaryHandler::setDBusHandlerInvoked()
+void RequestTemporaryHandlerHost::setDBusHandlerErrored(const QStringList &channelPaths,
+        const ObjectPathList &requests, const QString &errorName, const QString &errorMessage)
 {
-    dbusHandlerInvoked = true;
+    QString requestPath = requests.isEmpty() ? QString() : requests.first().path();
+    mInvokedRequests.remove(requestPath);
+
+    RequestTemporaryHandler *handler = handlerFor(
+            channelPaths.isEmpty() ? QString() : channelPaths.first(), requestPath);
+    if (handler) {
+        handler->setDBusHandlerErrored(errorName, errorMessage);
+    }
 }
 
-void RequestTemporaryHandler::setDBusHandlerErrored(const QString &errorName, const QString &errorMessage)
+void RequestTemporaryHandlerHost::registerRequest(const QString &requestPath,
+        RequestTemporaryHandler *handler)
 {
-    Q_ASSERT(dbusHandlerInvoked);
-    if (!channel()) {
-        emit error(errorName, errorMessage);
+    mRequests.insert(requestPath, handler);
+    if (mInvokedRequests.remove(requestPath)) {
+        handler->setDBusHandlerInvoked();
     }
 }
 
-void RequestTemporaryHandler::processChannelReceivedQueue()
+void RequestTemporaryHandlerHost::unregisterHandler(RequestTemporaryHandler *handler)
 {
-    while (!mChannelReceivedQueue.isEmpty()) {
-        QPair<QDateTime, ChannelRequestHints> info = mChannelReceivedQueue.dequeue();
-        emit channelReceived(channel(), info.first, info.second);
+    if (mRequests.value(handler->mRequestPath) == handler) {
+        mRequests.remove(handler->mRequestPath);
+    }
+
+    QHash<QString, RequestTemporaryHandler *>::iterator i = mChannels.begin();
+    while (i != mChannels.end()) {
+        if (i.value() == handler) {
+            i = mChannels.erase(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+/*
+ * A channel we already handle is routed to the request which first received it, so that
+ * re-requests are reported through HandledChannelNotifier, as the dispatcher re-invokes the
+ * handler of the channel. Otherwise the channel goes to the request it satisfies.
+ */
+RequestTemporaryHandler *RequestTemporaryHandlerHost::handlerFor(const QString &channelPath,
+        const QString &requestPath) const
+{
+    RequestTemporaryHandler *handler = mChannels.value(channelPath);
+    if (!handler) {
+        handler = mRequests.value(requestPath);
     }
+    return handler;
 }
 
 } // Tp
@@ -26,13 +26,20 @@
 #include <TelepathyQt/AbstractClientHandler>
 #include <TelepathyQt/Account>
 #include <TelepathyQt/Channel>
+#include <TelepathyQt/ClientRegistrar>
+
+#include <QHash>
+#include <QSet>
 
 namespace Tp
 {
 
-class TP_QT_NO_EXPORT RequestTemporaryHandler : public QObject, public AbstractClientHandler
+class RequestTemporaryHandlerHost;
+
+class TP_QT_NO_EXPORT RequestTemporaryHandler : public QObject, public RefCounted
 {
     Q_OBJECT
+    Q_DISABLE_COPY(RequestTemporaryHandler)
 
 public:
     static SharedPtr<RequestTemporaryHandler> create(const AccountPtr &account);
@@ -42,6 +49,57 @@ public:
     AccountPtr account() const { return mAccount; }
     ChannelPtr channel() const { return ChannelPtr(mChannel); }
 
+    bool isRegistered() const { return !mHost.isNull(); }
+    ClientRegistrarPtr registrar() const { return mRegistrar; }
+    QString handlerBusName() const;
+
+    void setChannelRequest(const QString &requestPath);
+
+    void setQueueChannelReceived(bool queue);
+
+    bool isDBusHandlerInvoked() const { return dbusHandlerInvoked; }
+
+Q_SIGNALS:
+    void error(const QString &errorName, const QString &errorMessage);
+    void channelReceived(const Tp::ChannelPtr &channel, const QDateTime &userActionTime,
+            const Tp::ChannelRequestHints &requestHints);
+
+private:
+    friend class RequestTemporaryHandlerHost;
+
+    RequestTemporaryHandler(const AccountPtr &account);
+
+    void handleChannel(const ChannelPtr &channel, const QDateTime &userActionTime,
+            const ChannelRequestHints &requestHints);
+    void setDBusHandlerInvoked();
+    void setDBusHandlerErrored(const QString &errorName, const QString &errorMessage);
+
+    void processChannelReceivedQueue();
+
+    AccountPtr mAccount;
+    ClientRegistrarPtr mRegistrar;
+    SharedPtr<RequestTemporaryHandlerHost> mHost;
+    QString mRequestPath;
+    WeakPtr<Channel> mChannel;
+    bool mQueueChannelReceived;
+    QQueue<QPair<QDateTime, ChannelRequestHints> > mChannelReceivedQueue;
+    bool dbusHandlerInvoked;
+};
+
+class TP_QT_NO_EXPORT RequestTemporaryHandlerHost : public QObject, public AbstractClientHandler
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(RequestTemporaryHandlerHost)
+
+public:
+    static SharedPtr<RequestTemporaryHandlerHost> ensure(const AccountPtr &account,
+            ClientRegistrarPtr *registrar);
+
+    ~RequestTemporaryHandlerHost() override;
+
+    AccountPtr account() const { return mAccount; }
+    QString busName() const { return mBusName; }
+
     /**
      * Handlers we request ourselves never go through the approvers but this
      * handler shouldn't get any channels we didn't request - hence let's make
@@ -60,28 +118,32 @@ public:
             const QDateTime &userActionTime,
             const HandlerInfo &handlerInfo) override;
 
-    void setQueueChannelReceived(bool queue);
+    void setDBusHandlerInvoked(const QStringList &channelPaths, const ObjectPathList &requests);
+    void setDBusHandlerErrored(const QStringList &channelPaths, const ObjectPathList &requests,
+            const QString &errorName, const QString &errorMessage);
 
-    void setDBusHandlerInvoked();
-    void setDBusHandlerErrored(const QString &errorName, const QString &errorMessage);
+private:
+    friend class RequestTemporaryHandler;
 
-    bool isDBusHandlerInvoked() const { return dbusHandlerInvoked; }
+    class FakeAccountFactory;
 
-Q_SIGNALS:
-    void error(const QString &errorName, const QString &errorMessage);
-    void channelReceived(const Tp::ChannelPtr &channel, const QDateTime &userActionTime,
-            const Tp::ChannelRequestHints &requestHints);
+    RequestTemporaryHandlerHost(const AccountPtr &account);
 
-private:
-    RequestTemporaryHandler(const AccountPtr &account);
+    void registerRequest(const QString &requestPath, RequestTemporaryHandler *handler);
+    void unregisterHandler(RequestTemporaryHandler *handler);
+    RequestTemporaryHandler *handlerFor(const QString &channelPath,
+            const QString &requestPath) const;
 
-    void processChannelReceivedQueue();
+    static QHash<Account *, RequestTemporaryHandlerHost *> hosts;
+    static uint numHandlers;
 
     AccountPtr mAccount;
-    WeakPtr<Channel> mChannel;
-    bool mQueueChannelReceived;
-    QQueue<QPair<QDateTime, ChannelRequestHints> > mChannelReceivedQueue;
-    bool dbusHandlerInvoked;
+    WeakPtr<ClientRegistrar> mRegistrar;
+    QString mBusName;
+
+    QHash<QString, RequestTemporaryHandler *> mRequests;
+    QHash<QString, RequestTemporaryHandler *> mChannels;
+    QSet<QString> mInvokedRequests;
 };
 
 } // Tp
@@ -26,20 +26,52 @@
 #include "TelepathyQt/debug-internal.h"
 
 #include <TelepathyQt/Connection>
+#include <TelepathyQt/PendingVoid>
 
 namespace Tp
 {
 
 struct TP_QT_NO_EXPORT RoomListChannel::Private
 {
-    inline Private();
+    inline Private(RoomListChannel *parent, const QVariantMap &immutableProperties);
     inline ~Private();
+
+    void connectSignals();
+
+    // Public object
+    RoomListChannel *parent;
+
+    Client::ChannelTypeRoomListInterface *roomListInterface;
+    QString server;
+    bool listingRooms;
+    bool signalsConnected;
 };
 
-RoomListChannel::Private::Private()
+RoomListChannel::Private::Private(RoomListChannel *parent, const QVariantMap &immutableProperties)
+    : parent(parent),
+      roomListInterface(parent->interface<Client::ChannelTypeRoomListInterface>()),
+      server(qdbus_cast<QString>(immutableProperties.value(
+                      TP_QT_IFACE_CHANNEL_TYPE_ROOM_LIST + QLatin1String(".Server")))),
+      listingRooms(false),
+      signalsConnected(false)
 {
 }
 
+void RoomListChannel::Private::connectSignals()
+{
+    if (signalsConnected) {
+        return;
+    }
+
+    signalsConnected = true;
+    parent->connect(roomListInterface,
+            SIGNAL(GotRooms(Tp::RoomInfoList)),
+            SLOT(onGotRooms(Tp::RoomInfoList)));
+    parent->connect(roomListInterface,
+            SIGNAL(ListingRooms(bool)),
+            SLOT(onListingRooms(bool)));
+}
+
 RoomListChannel::Private::~Private()
 {
 }
@@ -51,8 +83,10 @@ RoomListChannel::Private::~Private()
  *
  * \brief The RoomListChannel class represents a Telepathy Channel of type RoomList.
  *
- * Note that this subclass of Channel will eventually provide a high-level API for the
- * RoomList interface. Until then, it's just a Channel.
+ * Call listRooms() to start listing the rooms on the server. The rooms are delivered
+ * incrementally by the gotRooms() signal, in the chunks the connection manager sends them,
+ * so a client which displays or filters the rooms as they arrive never needs to hold the
+ * complete list. listingRoomsChanged() is emitted when the listing starts and finishes.
  *
  * For more details, please refer to \telepathy_spec.
  *
@@ -91,7 +125,7 @@ RoomListChannel::RoomListChannel(const ConnectionPtr &connection,
         const QVariantMap &immutableProperties,
         const Feature &coreFeature)
     : Channel(connection, objectPath, immutableProperties, coreFeature),
-      mPriv(new Private())
+      mPriv(new Private(this, immutableProperties))
 {
 }
 
@@ -103,4 +137,85 @@ RoomListChannel::~RoomListChannel()
     delete mPriv;
 }
 
+/**
+ * Return the DNS name of the server whose rooms are listed by this channel.
+ *
+ * \return The server name, or an empty string for the default server of the connection.
+ */
+QString RoomListChannel::server() const
+{
+    return mPriv->server;
+}
+
+/**
+ * Return whether a listing started by listRooms() is in progress.
+ *
+ * Change notification is via the listingRoomsChanged() signal.
+ *
+ * \return \c true if rooms are being listed, \c false otherwise.
+ */
+bool RoomListChannel::isListingRooms() const
+{
+    return mPriv->listingRooms;
+}
+
+/**
+ * Request the list of rooms on the server.
+ *
+ * The rooms are signalled by gotRooms() as they arrive. The channel does not store them.
+ *
+ * \return A PendingOperation which will emit PendingOperation::finished
+ *         when the listing has been requested.
+ * \sa stopListing(), gotRooms()
+ */
+PendingOperation *RoomListChannel::listRooms()
+{
+    mPriv->connectSignals();
+    return new PendingVoid(mPriv->roomListInterface->ListRooms(), RoomListChannelPtr(this));
+}
+
+/**
+ * Stop the listing started by listRooms().
+ *
+ * \return A PendingOperation which will emit PendingOperation::finished
+ *         when the call has finished.
+ * \sa listRooms()
+ */
+PendingOperation *RoomListChannel::stopListing()
+{
+    return new PendingVoid(mPriv->roomListInterface->StopListing(), RoomListChannelPtr(this));
+}
+
+void RoomListChannel::onGotRooms(const Tp::RoomInfoList &rooms)
+{
+    emit gotRooms(rooms);
+}
+
+void RoomListChannel::onListingRooms(bool listing)
+{
+    if (mPriv->listingRooms == listing) {
+        return;
+    }
+
+    mPriv->listingRooms = listing;
+    emit listingRoomsChanged(listing);
+}
+
+/**
+ * \fn void RoomListChannel::gotRooms(const Tp::RoomInfoList &rooms)
+ *
+ * Emitted when the connection manager reports more rooms of the listing requested by
+ * listRooms().
+ *
+ * \param rooms The rooms found since the last emission.
+ */
+
+/**
+ * \fn void RoomListChannel::listingRoomsChanged(bool listing)
+ *
+ * Emitted when the value of isListingRooms() changes.
+ *
+ * \param listing Whether rooms are being listed.
+ */
+
 } // Tp
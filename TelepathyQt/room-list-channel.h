@@ -28,6 +28,7 @@
 #endif
 
 #include <TelepathyQt/Channel>
+#include <TelepathyQt/Types>
 
 namespace Tp
 {
@@ -43,11 +44,25 @@ public:
 
     ~RoomListChannel() override;
 
+    QString server() const;
+
+    bool isListingRooms() const;
+    PendingOperation *listRooms();
+    PendingOperation *stopListing();
+
+Q_SIGNALS:
+    void gotRooms(const Tp::RoomInfoList &rooms);
+    void listingRoomsChanged(bool listing);
+
 protected:
     RoomListChannel(const ConnectionPtr &connection, const QString &objectPath,
             const QVariantMap &immutableProperties,
             const Feature &coreFeature = Channel::FeatureCore);
 
+private Q_SLOTS:
+    TP_QT_NO_EXPORT void onGotRooms(const Tp::RoomInfoList &rooms);
+    TP_QT_NO_EXPORT void onListingRooms(bool listing);
+
 private:
     struct Private;
     friend struct Private;
@@ -71,6 +71,7 @@ class BaseConnectionContactsInterface;
 class BaseConnectionManager;
 class BaseConnectionRequestsInterface;
 class BaseConnectionSimplePresenceInterface;
+class BaseHandleRepository;
 class BaseProtocol;
 class BaseProtocolAddressingInterface;
 class BaseProtocolAvatarsInterface;
@@ -118,6 +119,7 @@ typedef SharedPtr<BaseConnectionContactsInterface> BaseConnectionContactsInterfa
 typedef SharedPtr<BaseConnectionManager> BaseConnectionManagerPtr;
 typedef SharedPtr<BaseConnectionRequestsInterface> BaseConnectionRequestsInterfacePtr;
 typedef SharedPtr<BaseConnectionSimplePresenceInterface> BaseConnectionSimplePresenceInterfacePtr;
+typedef SharedPtr<BaseHandleRepository> BaseHandleRepositoryPtr;
 typedef SharedPtr<BaseProtocol> BaseProtocolPtr;
 typedef SharedPtr<BaseProtocolAddressingInterface> BaseProtocolAddressingInterfacePtr;
 typedef SharedPtr<BaseProtocolAvatarsInterface> BaseProtocolAvatarsInterfacePtr;
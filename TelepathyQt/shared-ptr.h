@@ -32,6 +32,8 @@
 #include <QHash>
 #include <QObject>
 
+#include <utility>
+
 namespace Tp
 {
 
@@ -102,22 +104,25 @@ public:
     explicit inline SharedPtr(T *d) : d(d) { if (d) { d->ref(); } }
     template <typename Subclass>
         inline SharedPtr(const SharedPtr<Subclass> &o) : d(o.data()) { if (d) { d->ref(); } }
+    template <typename Subclass>
+        inline SharedPtr(SharedPtr<Subclass> &&o) noexcept : d(o.d) { o.d = nullptr; }
     inline SharedPtr(const SharedPtr<T> &o) : d(o.d) { if (d) { d->ref(); } }
+    // Moving transfers the reference, sparing the atomic increment and decrement of a copy
+    inline SharedPtr(SharedPtr<T> &&o) noexcept : d(o.d) { o.d = nullptr; }
     explicit inline SharedPtr(const WeakPtr<T> &o)
     {
         RefCounted::SharedCount *sc = o.sc;
         if (sc) {
             // increase the strongref, but never up from zero
             // or less (negative is used on untracked objects)
-            register int tmp = sc->strongref.fetchAndAddOrdered(0);
+            int tmp = sc->strongref.loadAcquire();
             while (tmp > 0) {
-                // try to increment from "tmp" to "tmp + 1"
-                if (sc->strongref.testAndSetRelaxed(tmp, tmp + 1)) {
+                // try to increment from "tmp" to "tmp + 1", a failed attempt
+                // stores the current value in "tmp"
+                if (sc->strongref.testAndSetAcquire(tmp, tmp + 1, tmp)) {
                     // succeeded
                     break;
                 }
-                // failed, try again
-                tmp = sc->strongref.fetchAndAddOrdered(0);
             }
 
             if (tmp > 0) {
@@ -165,6 +170,12 @@ public:
         return *this;
     }
 
+    inline SharedPtr<T> &operator=(SharedPtr<T> &&o) noexcept
+    {
+        SharedPtr<T>(std::move(o)).swap(*this);
+        return *this;
+    }
+
     inline void swap(SharedPtr<T> &o)
     {
         T *tmp = d;
@@ -197,6 +208,7 @@ public:
     }
 
 private:
+    template <class X> friend class SharedPtr;
     friend class WeakPtr<T>;
 
     T *d;
@@ -227,6 +239,7 @@ public:
         }
     }
     inline WeakPtr(const WeakPtr<T> &o) : sc(o.sc) { if (sc) { sc->weakref.ref(); } }
+    inline WeakPtr(WeakPtr<T> &&o) noexcept : sc(o.sc) { o.sc = nullptr; }
     inline WeakPtr(const SharedPtr<T> &o)
     {
         if (o.d) {
@@ -243,7 +256,7 @@ public:
         }
     }
 
-    inline bool isNull() const { return !sc || sc->strongref.fetchAndAddOrdered(0) <= 0; }
+    inline bool isNull() const { return !sc || sc->strongref.loadAcquire() <= 0; }
     inline bool operator!() const { return isNull(); }
     operator UnspecifiedBoolType() const { return !isNull() ? &WeakPtr<T>::operator! : nullptr; }
 
@@ -253,6 +266,12 @@ public:
         return *this;
     }
 
+    inline WeakPtr<T> &operator=(WeakPtr<T> &&o) noexcept
+    {
+        WeakPtr<T>(std::move(o)).swap(*this);
+        return *this;
+    }
+
     inline WeakPtr<T> &operator=(const SharedPtr<T> &o)
     {
         WeakPtr<T>(o).swap(*this);
@@ -102,6 +102,13 @@
 #       and optional argument a set of additional libraries the target will link to. Please remember that you need to
 #       set up the DBus environment by calling TPQT_SETUP_DBUS_TEST_ENVIRONMENT BEFORE you call this macro.
 #
+# macro TPQT_ADD_DBUS_BENCHMARK (fancyName name [libraries ...])
+#       This macro takes care of building a benchmark requiring DBus emulation, contained in a single source file
+#       named ${name}.cpp. Benchmarks are not added to the CTest suite; instead a check-benchmark-${fancyName}
+#       target runs the benchmark, printing the results and saving them as QTestLib XML to
+#       benchmark-${fancyName}.xml, and the check-benchmarks target runs all of them. As with
+#       TPQT_ADD_DBUS_UNIT_TEST, TPQT_SETUP_DBUS_TEST_ENVIRONMENT must be called BEFORE calling this macro.
+#
 # macro _TPQT_ADD_CHECK_TARGETS (fancyName name command [args])
 #       This is an internal macro which is meant to be used by TPQT_ADD_DBUS_UNIT_TEST and TPQT_ADD_GENERIC_UNIT_TEST.
 #       It takes care of generating a check target for each test method available (currently normal execution, valgrind and
@@ -430,6 +437,21 @@ macro(tpqt_add_dbus_unit_test _fancyName _name)
     _tpqt_add_check_targets(${_fancyName} ${_name} ${with_session_bus} ${CMAKE_CURRENT_BINARY_DIR}/test-${_name})
 endmacro()
 
+macro(tpqt_add_dbus_benchmark _fancyName _name)
+    tpqt_generate_moc_i(${_name}.cpp ${CMAKE_CURRENT_BINARY_DIR}/_gen/${_name}.cpp.moc.hpp)
+    add_executable(benchmark-${_name} ${_name}.cpp ${CMAKE_CURRENT_BINARY_DIR}/_gen/${_name}.cpp.moc.hpp)
+    target_link_libraries(benchmark-${_name} ${QT_QTCORE_LIBRARY} ${QT_QTDBUS_LIBRARY} ${QT_QTNETWORK_LIBRARY} ${QT_QTXML_LIBRARY} ${QT_QTTEST_LIBRARY} telepathy-qt${QT_VERSION_MAJOR} tp-qt-tests ${TP_QT_EXECUTABLE_LINKER_FLAGS} ${ARGN})
+
+    add_custom_target(check-benchmark-${_fancyName}
+        ${SH} ${CMAKE_CURRENT_BINARY_DIR}/runDbusTest.sh ${CMAKE_CURRENT_BINARY_DIR}/benchmark-${_name}
+            -o ${CMAKE_CURRENT_BINARY_DIR}/benchmark-${_fancyName}.xml,xml
+            -o -,txt
+        WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}
+        COMMENT "Running benchmark \"${_fancyName}\"")
+    add_dependencies(check-benchmark-${_fancyName} benchmark-${_name})
+    add_dependencies(check-benchmarks check-benchmark-${_fancyName})
+endmacro()
+
 macro(_tpqt_add_check_targets _fancyName _name _runnerScript)
     set_tests_properties(${_fancyName}
         PROPERTIES
@@ -0,0 +1,111 @@
+#include <tests/lib/test.h>
+
+#include <TelepathyQt/Account>
+#include <TelepathyQt/AccountFactory>
+#include <TelepathyQt/AccountManager>
+#include <TelepathyQt/PendingAccount>
+#include <TelepathyQt/PendingReady>
+
+using namespace Tp;
+
+class BenchmarkAccountManager : public Test
+{
+    Q_OBJECT
+
+public:
+    BenchmarkAccountManager(QObject *parent = nullptr)
+        : Test(parent)
+    { }
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+
+    void benchmarkStartup_data();
+    void benchmarkStartup();
+
+    void cleanup();
+    void cleanupTestCase();
+
+private:
+    void growAccounts(int size);
+
+    AccountManagerPtr mAM;
+};
+
+void BenchmarkAccountManager::growAccounts(int size)
+{
+    // The accounts are created through the fake account manager, which keeps them for the
+    // lifetime of the test, so each row only adds the accounts missing from the previous one
+    while (mAM->allAccounts().size() < size) {
+        QVariantMap parameters;
+        parameters[QLatin1String("account")] =
+            QString(QLatin1String("account%1@example.com")).arg(mAM->allAccounts().size());
+        PendingAccount *pacc = mAM->createAccount(QLatin1String("foo"),
+                QLatin1String("bar"), QLatin1String("foobar"), parameters);
+        QVERIFY(connect(pacc,
+                    SIGNAL(finished(Tp::PendingOperation*)),
+                    SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+        QCOMPARE(mLoop->exec(), 0);
+    }
+}
+
+void BenchmarkAccountManager::initTestCase()
+{
+    initTestCaseImpl();
+
+    mAM = AccountManager::create(AccountFactory::create(QDBusConnection::sessionBus(),
+                Account::FeatureCore));
+    QVERIFY(connect(mAM->becomeReady(),
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+}
+
+void BenchmarkAccountManager::init()
+{
+    initImpl();
+}
+
+void BenchmarkAccountManager::benchmarkStartup_data()
+{
+    QTest::addColumn<int>("accounts");
+
+    QTest::newRow("100") << 100;
+    QTest::newRow("1k") << 1000;
+}
+
+void BenchmarkAccountManager::benchmarkStartup()
+{
+    QFETCH(int, accounts);
+
+    growAccounts(accounts);
+    QCOMPARE(mAM->allAccounts().size(), accounts);
+
+    // Measure what a client pays on startup: introspecting the account manager and making
+    // every account ready with the core feature
+    QBENCHMARK {
+        AccountManagerPtr am = AccountManager::create(
+                AccountFactory::create(QDBusConnection::sessionBus(), Account::FeatureCore));
+        QVERIFY(connect(am->becomeReady(),
+                    SIGNAL(finished(Tp::PendingOperation*)),
+                    SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+        QCOMPARE(mLoop->exec(), 0);
+        QCOMPARE(am->allAccounts().size(), accounts);
+    }
+}
+
+void BenchmarkAccountManager::cleanup()
+{
+    cleanupImpl();
+}
+
+void BenchmarkAccountManager::cleanupTestCase()
+{
+    mAM.reset();
+
+    cleanupTestCaseImpl();
+}
+
+QTEST_MAIN(BenchmarkAccountManager)
+#include "_gen/account-manager.cpp.moc.hpp"
@@ -0,0 +1,243 @@
+#include <tests/lib/test.h>
+
+#include <tests/lib/glib-helpers/test-conn-helper.h>
+
+#include <tests/lib/glib/contacts-conn.h>
+#include <tests/lib/glib/echo/chan.h>
+
+#include <TelepathyQt/AbstractClientHandler>
+#include <TelepathyQt/Account>
+#include <TelepathyQt/AccountManager>
+#include <TelepathyQt/Channel>
+#include <TelepathyQt/ChannelClassSpec>
+#include <TelepathyQt/ClientHandlerInterface>
+#include <TelepathyQt/ClientRegistrar>
+#include <TelepathyQt/MethodInvocationContext>
+#include <TelepathyQt/PendingAccount>
+#include <TelepathyQt/PendingReady>
+
+#include <telepathy-glib/debug.h>
+
+using namespace Tp;
+
+class CountingHandler : public QObject, public AbstractClientHandler
+{
+    Q_OBJECT
+
+public:
+    static SharedPtr<CountingHandler> create()
+    {
+        return SharedPtr<CountingHandler>(new CountingHandler());
+    }
+
+    CountingHandler()
+        : AbstractClientHandler(ChannelClassSpecList() << ChannelClassSpec::textChat()),
+          mHandledChannels(0)
+    {
+    }
+
+    bool bypassApproval() const override
+    {
+        return false;
+    }
+
+    void handleChannels(const MethodInvocationContextPtr<> &context,
+            const AccountPtr &account,
+            const ConnectionPtr &connection,
+            const QList<ChannelPtr> &channels,
+            const QList<ChannelRequestPtr> &requestsSatisfied,
+            const QDateTime &userActionTime,
+            const AbstractClientHandler::HandlerInfo &handlerInfo) override
+    {
+        Q_UNUSED(account);
+        Q_UNUSED(connection);
+        Q_UNUSED(requestsSatisfied);
+        Q_UNUSED(userActionTime);
+        Q_UNUSED(handlerInfo);
+
+        // Don't keep the channels, so every burst pays for building the proxies again
+        mHandledChannels += channels.size();
+        context->setFinished();
+        Q_EMIT channelsHandled();
+    }
+
+    int mHandledChannels;
+
+Q_SIGNALS:
+    void channelsHandled();
+};
+
+class BenchmarkChannelDispatch : public Test
+{
+    Q_OBJECT
+
+public:
+    BenchmarkChannelDispatch(QObject *parent = nullptr)
+        : Test(parent), mConn(nullptr), mExpectedChannels(0)
+    { }
+
+protected Q_SLOTS:
+    void onChannelsHandled();
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+
+    void benchmarkHandleChannels_data();
+    void benchmarkHandleChannels();
+
+    void cleanup();
+    void cleanupTestCase();
+
+private:
+    void growChannels(int size);
+
+    AccountManagerPtr mAM;
+    AccountPtr mAccount;
+    TestConnHelper *mConn;
+    QList<ExampleEchoChannel*> mChanServices;
+    QStringList mChanPaths;
+
+    ClientRegistrarPtr mClientRegistrar;
+    SharedPtr<CountingHandler> mHandler;
+    ClientHandlerInterface *mHandlerIface;
+    int mExpectedChannels;
+};
+
+void BenchmarkChannelDispatch::onChannelsHandled()
+{
+    if (mHandler->mHandledChannels == mExpectedChannels) {
+        mLoop->exit(0);
+    }
+}
+
+void BenchmarkChannelDispatch::growChannels(int size)
+{
+    TpHandleRepoIface *contactRepo = tp_base_connection_get_handles(
+            TP_BASE_CONNECTION(mConn->service()), TP_HANDLE_TYPE_CONTACT);
+
+    // create the Channels by magic, rather than doing D-Bus round-trips for them
+    while (mChanServices.size() < size) {
+        int n = mChanServices.size();
+        QByteArray id = QString(QLatin1String("contact%1@example.com")).arg(n).toLatin1();
+        guint handle = tp_handle_ensure(contactRepo, id.constData(), nullptr, nullptr);
+
+        QString chanPath = mConn->objectPath() + QString(QLatin1String("/TextChannel%1")).arg(n);
+        QByteArray chanPathLatin1(chanPath.toLatin1());
+        mChanServices.append(EXAMPLE_ECHO_CHANNEL(g_object_new(
+                        EXAMPLE_TYPE_ECHO_CHANNEL,
+                        "connection", mConn->service(),
+                        "object-path", chanPathLatin1.data(),
+                        "handle", handle,
+                        NULL)));
+        mChanPaths.append(chanPath);
+    }
+}
+
+void BenchmarkChannelDispatch::initTestCase()
+{
+    initTestCaseImpl();
+
+    g_type_init();
+    g_set_prgname("benchmark-channel-dispatch");
+    tp_debug_set_flags("");
+    dbus_g_bus_get(DBUS_BUS_STARTER, nullptr);
+
+    mAM = AccountManager::create();
+    QVERIFY(connect(mAM->becomeReady(),
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+
+    QVariantMap parameters;
+    parameters[QLatin1String("account")] = QLatin1String("foobar");
+    PendingAccount *pacc = mAM->createAccount(QLatin1String("foo"),
+            QLatin1String("bar"), QLatin1String("foobar"), parameters);
+    QVERIFY(connect(pacc,
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+    QVERIFY(pacc->account());
+    mAccount = pacc->account();
+
+    mConn = new TestConnHelper(this,
+            TP_TESTS_TYPE_CONTACTS_CONNECTION,
+            "account", "me@example.com",
+            "protocol", "example",
+            NULL);
+    QCOMPARE(mConn->connect(), true);
+
+    mClientRegistrar = ClientRegistrar::create();
+    mHandler = CountingHandler::create();
+    QVERIFY(mClientRegistrar->registerClient(AbstractClientPtr::dynamicCast(mHandler),
+                QLatin1String("benchmark")));
+    QVERIFY(connect(mHandler.data(),
+                SIGNAL(channelsHandled()),
+                SLOT(onChannelsHandled())));
+
+    mHandlerIface = new ClientHandlerInterface(mClientRegistrar->dbusConnection(),
+            QLatin1String("org.freedesktop.Telepathy.Client.benchmark"),
+            QLatin1String("/org/freedesktop/Telepathy/Client/benchmark"), this);
+}
+
+void BenchmarkChannelDispatch::init()
+{
+    initImpl();
+}
+
+void BenchmarkChannelDispatch::benchmarkHandleChannels_data()
+{
+    QTest::addColumn<int>("channels");
+
+    QTest::newRow("100") << 100;
+    QTest::newRow("1k") << 1000;
+}
+
+void BenchmarkChannelDispatch::benchmarkHandleChannels()
+{
+    QFETCH(int, channels);
+
+    growChannels(channels);
+
+    // A burst of HandleChannels calls, one channel each, as the channel dispatcher would issue
+    // them when many channels arrive at once
+    QBENCHMARK {
+        mHandler->mHandledChannels = 0;
+        mExpectedChannels = channels;
+        for (int i = 0; i < channels; ++i) {
+            ChannelDetails details = { QDBusObjectPath(mChanPaths[i]), QVariantMap() };
+            mHandlerIface->HandleChannels(QDBusObjectPath(mAccount->objectPath()),
+                    QDBusObjectPath(mConn->objectPath()),
+                    ChannelDetailsList() << details,
+                    ObjectPathList(),
+                    0,
+                    QVariantMap());
+        }
+        QCOMPARE(mLoop->exec(), 0);
+    }
+}
+
+void BenchmarkChannelDispatch::cleanup()
+{
+    cleanupImpl();
+}
+
+void BenchmarkChannelDispatch::cleanupTestCase()
+{
+    mClientRegistrar->unregisterClient(AbstractClientPtr::dynamicCast(mHandler));
+    mHandler.reset();
+    mClientRegistrar.reset();
+
+    QCOMPARE(mConn->disconnect(), true);
+    delete mConn;
+
+    Q_FOREACH (ExampleEchoChannel *chanService, mChanServices) {
+        g_object_unref(chanService);
+    }
+    mChanServices.clear();
+
+    cleanupTestCaseImpl();
+}
+
+QTEST_MAIN(BenchmarkChannelDispatch)
+#include "_gen/channel-dispatch.cpp.moc.hpp"
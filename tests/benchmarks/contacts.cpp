@@ -0,0 +1,128 @@
+#include <tests/lib/test.h>
+
+#include <tests/lib/glib-helpers/test-conn-helper.h>
+
+#include <tests/lib/glib/contacts-conn.h>
+
+#include <TelepathyQt/Connection>
+#include <TelepathyQt/ContactManager>
+#include <TelepathyQt/PendingBatchedContacts>
+
+#include <telepathy-glib/debug.h>
+
+using namespace Tp;
+
+class BenchmarkContacts : public Test
+{
+    Q_OBJECT
+
+public:
+    BenchmarkContacts(QObject *parent = nullptr)
+        : Test(parent), mConn(nullptr)
+    { }
+
+protected Q_SLOTS:
+    void expectPendingContactsFinished(Tp::PendingOperation *op);
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+
+    void benchmarkForIdentifiersInBatches_data();
+    void benchmarkForIdentifiersInBatches();
+
+    void cleanup();
+    void cleanupTestCase();
+
+private:
+    TestConnHelper *mConn;
+    QList<ContactPtr> mContacts;
+};
+
+void BenchmarkContacts::expectPendingContactsFinished(PendingOperation *op)
+{
+    TEST_VERIFY_OP(op);
+
+    mContacts = qobject_cast<PendingContacts *>(op)->contacts();
+    mLoop->exit(0);
+}
+
+void BenchmarkContacts::initTestCase()
+{
+    initTestCaseImpl();
+
+    g_type_init();
+    g_set_prgname("benchmark-contacts");
+    tp_debug_set_flags("");
+    dbus_g_bus_get(DBUS_BUS_STARTER, nullptr);
+
+    mConn = new TestConnHelper(this,
+            TP_TESTS_TYPE_CONTACTS_CONNECTION,
+            "account", "me@example.com",
+            "protocol", "simple",
+            NULL);
+    QCOMPARE(mConn->connect(), true);
+}
+
+void BenchmarkContacts::init()
+{
+    initImpl();
+}
+
+void BenchmarkContacts::benchmarkForIdentifiersInBatches_data()
+{
+    QTest::addColumn<int>("identifiers");
+    QTest::addColumn<int>("batchSize");
+    QTest::addColumn<int>("maxBatchesInFlight");
+
+    QTest::newRow("5k, 250 x 4") << 5000 << 250 << 4;
+    QTest::newRow("5k, 1000 x 1") << 5000 << 1000 << 1;
+    QTest::newRow("20k, 250 x 4") << 20000 << 250 << 4;
+}
+
+void BenchmarkContacts::benchmarkForIdentifiersInBatches()
+{
+    QFETCH(int, identifiers);
+    QFETCH(int, batchSize);
+    QFETCH(int, maxBatchesInFlight);
+
+    QStringList ids;
+    for (int i = 0; i < identifiers; ++i) {
+        ids << QString(QLatin1String("bench%1")).arg(i);
+    }
+
+    // Only the first run resolves every identifier from scratch, later ones would hit the
+    // contact cache
+    QBENCHMARK_ONCE {
+        PendingContacts *pending = mConn->client()->contactManager()->
+            contactsForIdentifiersInBatches(ids, Features(), batchSize, maxBatchesInFlight);
+        QVERIFY(connect(pending,
+                    SIGNAL(finished(Tp::PendingOperation*)),
+                    SLOT(expectPendingContactsFinished(Tp::PendingOperation*))));
+        QCOMPARE(mLoop->exec(), 0);
+    }
+
+    QCOMPARE(mContacts.size(), ids.size());
+
+    mContacts.clear();
+    mLoop->processEvents();
+    processDBusQueue(mConn->client().data());
+}
+
+void BenchmarkContacts::cleanup()
+{
+    cleanupImpl();
+}
+
+void BenchmarkContacts::cleanupTestCase()
+{
+    mContacts.clear();
+
+    QCOMPARE(mConn->disconnect(), true);
+    delete mConn;
+
+    cleanupTestCaseImpl();
+}
+
+QTEST_MAIN(BenchmarkContacts)
+#include "_gen/contacts.cpp.moc.hpp"
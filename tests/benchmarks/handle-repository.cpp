@@ -0,0 +1,93 @@
+#include <tests/lib/test.h>
+
+#include <TelepathyQt/BaseHandleRepository>
+#include <TelepathyQt/DBusError>
+
+using namespace Tp;
+
+class BenchmarkHandleRepository : public Test
+{
+    Q_OBJECT
+
+public:
+    BenchmarkHandleRepository(QObject *parent = nullptr)
+        : Test(parent)
+    { }
+
+private:
+    QString normalizeContact(const QString &contactId, Tp::DBusError *error);
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+
+    void benchmarkEnsureHandles_data();
+    void benchmarkEnsureHandles();
+
+    void cleanup();
+    void cleanupTestCase();
+};
+
+QString BenchmarkHandleRepository::normalizeContact(const QString &contactId,
+        Tp::DBusError *error)
+{
+    Q_UNUSED(error)
+
+    return contactId.toLower();
+}
+
+void BenchmarkHandleRepository::initTestCase()
+{
+    initTestCaseImpl();
+}
+
+void BenchmarkHandleRepository::init()
+{
+    initImpl();
+}
+
+void BenchmarkHandleRepository::benchmarkEnsureHandles_data()
+{
+    QTest::addColumn<int>("identifiers");
+
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+}
+
+void BenchmarkHandleRepository::benchmarkEnsureHandles()
+{
+    QFETCH(int, identifiers);
+
+    QStringList ids;
+    ids.reserve(identifiers);
+    for (int i = 0; i < identifiers; ++i) {
+        ids << QString(QLatin1String("Contact%1@example.com")).arg(i);
+    }
+
+    // Each iteration starts from an empty repository: the first pass normalizes and interns every
+    // identifier, the second is served by the normalization cache
+    QBENCHMARK {
+        BaseHandleRepositoryPtr repository = BaseHandleRepository::create(HandleTypeContact);
+        repository->setNormalizeCallback(memFun(this, &BenchmarkHandleRepository::normalizeContact));
+        repository->setNormalizationCacheSize(identifiers);
+
+        DBusError error;
+        repository->ensureHandles(ids, &error);
+        Tp::UIntList handles = repository->ensureHandles(ids, &error);
+        repository->identifiers(handles, &error);
+        QVERIFY(!error.isValid());
+    }
+}
+
+void BenchmarkHandleRepository::cleanup()
+{
+    cleanupImpl();
+}
+
+void BenchmarkHandleRepository::cleanupTestCase()
+{
+    cleanupTestCaseImpl();
+}
+
+QTEST_MAIN(BenchmarkHandleRepository)
+#include "_gen/handle-repository.cpp.moc.hpp"
@@ -0,0 +1,171 @@
+#include <tests/lib/test.h>
+
+#include <tests/lib/glib-helpers/test-conn-helper.h>
+
+#include <tests/lib/glib/echo2/conn.h>
+
+#include <TelepathyQt/Account>
+#include <TelepathyQt/Channel>
+#include <TelepathyQt/ChannelFactory>
+#include <TelepathyQt/Connection>
+#include <TelepathyQt/ConnectionFactory>
+#include <TelepathyQt/PendingReady>
+
+#include <telepathy-glib/debug.h>
+
+using namespace Tp;
+
+// Just enough of an Account for Account::FeatureCore to be introspected
+class AccountAdaptor : public QDBusAbstractAdaptor
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.freedesktop.Telepathy.Account")
+    Q_CLASSINFO("D-Bus Introspection", ""
+"  <interface name=\"org.freedesktop.Telepathy.Account\" >\n"
+"    <property name=\"Interfaces\" type=\"as\" access=\"read\" />\n"
+"    <property name=\"Connection\" type=\"o\" access=\"read\" />\n"
+"    <signal name=\"AccountPropertyChanged\" >\n"
+"      <arg name=\"Properties\" type=\"a{sv}\" />\n"
+"    </signal>\n"
+"  </interface>\n"
+        "")
+
+    Q_PROPERTY(QDBusObjectPath Connection READ Connection)
+    Q_PROPERTY(QStringList Interfaces READ Interfaces)
+
+public:
+    AccountAdaptor(const QString &connection, QObject *parent)
+        : QDBusAbstractAdaptor(parent), mConnection(connection)
+    {
+    }
+
+public: // Properties
+    inline QDBusObjectPath Connection() const
+    {
+        return mConnection;
+    }
+
+    inline QStringList Interfaces() const
+    {
+        return QStringList();
+    }
+
+Q_SIGNALS: // Signals
+    void AccountPropertyChanged(const QVariantMap &properties);
+
+private:
+    QDBusObjectPath mConnection;
+};
+
+class BenchmarkReadyChain : public Test
+{
+    Q_OBJECT
+
+public:
+    BenchmarkReadyChain(QObject *parent = nullptr)
+        : Test(parent), mConn(nullptr), mAccountObject(nullptr)
+    { }
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+
+    void benchmarkReadyChain();
+
+    void cleanup();
+    void cleanupTestCase();
+
+private:
+    TestConnHelper *mConn;
+    QObject *mAccountObject;
+    QString mAccountBusName, mAccountPath;
+    ChannelPtr mChan;
+};
+
+void BenchmarkReadyChain::initTestCase()
+{
+    initTestCaseImpl();
+
+    g_type_init();
+    g_set_prgname("benchmark-ready-chain");
+    tp_debug_set_flags("");
+    dbus_g_bus_get(DBUS_BUS_STARTER, nullptr);
+
+    mConn = new TestConnHelper(this,
+            EXAMPLE_TYPE_ECHO_2_CONNECTION,
+            "account", "me@example.com",
+            "protocol", "contacts",
+            NULL);
+    QCOMPARE(mConn->connect(), true);
+
+    QList<ContactPtr> contacts = mConn->contacts(QStringList() << QLatin1String("alice"));
+    QCOMPARE(contacts.size(), 1);
+    mChan = mConn->createChannel(TP_QT_IFACE_CHANNEL_TYPE_TEXT, contacts.first());
+    QVERIFY(mChan);
+
+    mAccountBusName = TP_QT_IFACE_ACCOUNT_MANAGER;
+    mAccountPath = QLatin1String("/org/freedesktop/Telepathy/Account/simple/simple/account");
+
+    mAccountObject = new QObject(this);
+    new AccountAdaptor(mConn->objectPath(), mAccountObject);
+
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    QVERIFY(bus.registerService(mAccountBusName));
+    QVERIFY(bus.registerObject(mAccountPath, mAccountObject));
+}
+
+void BenchmarkReadyChain::init()
+{
+    initImpl();
+}
+
+// Measures the whole chain of pending operations it takes to get from a fresh Account proxy to a
+// ready Channel proxy on its connection
+void BenchmarkReadyChain::benchmarkReadyChain()
+{
+    QBENCHMARK {
+        AccountPtr account = Account::create(mAccountBusName, mAccountPath,
+                ConnectionFactory::create(QDBusConnection::sessionBus(),
+                    Connection::FeatureCore),
+                ChannelFactory::create(QDBusConnection::sessionBus()));
+
+        QVERIFY(connect(account->becomeReady(),
+                    SIGNAL(finished(Tp::PendingOperation*)),
+                    SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+        QCOMPARE(mLoop->exec(), 0);
+
+        ConnectionPtr conn = account->connection();
+        QVERIFY(!conn.isNull());
+        QVERIFY(conn->isReady(Connection::FeatureCore));
+
+        ChannelPtr channel = Channel::create(conn, mChan->objectPath(),
+                mChan->immutableProperties());
+        QVERIFY(connect(channel->becomeReady(),
+                    SIGNAL(finished(Tp::PendingOperation*)),
+                    SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+        QCOMPARE(mLoop->exec(), 0);
+        QVERIFY(channel->isReady());
+    }
+}
+
+void BenchmarkReadyChain::cleanup()
+{
+    cleanupImpl();
+}
+
+void BenchmarkReadyChain::cleanupTestCase()
+{
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    bus.unregisterObject(mAccountPath);
+    bus.unregisterService(mAccountBusName);
+
+    mChan.reset();
+
+    QCOMPARE(mConn->disconnect(), true);
+    delete mConn;
+
+    cleanupTestCaseImpl();
+}
+
+QTEST_MAIN(BenchmarkReadyChain)
+#include "_gen/ready-chain.cpp.moc.hpp"
@@ -0,0 +1,134 @@
+#include <tests/lib/test.h>
+
+#include <tests/lib/glib-helpers/test-conn-helper.h>
+
+#include <tests/lib/glib/contact-list-manager.h>
+#include <tests/lib/glib/contacts-conn.h>
+
+#include <TelepathyQt/ChannelFactory>
+#include <TelepathyQt/Connection>
+#include <TelepathyQt/Contact>
+#include <TelepathyQt/ContactFactory>
+#include <TelepathyQt/ContactManager>
+#include <TelepathyQt/PendingReady>
+
+#include <telepathy-glib/debug.h>
+
+#include <QVector>
+
+using namespace Tp;
+
+class BenchmarkRoster : public Test
+{
+    Q_OBJECT
+
+public:
+    BenchmarkRoster(QObject *parent = nullptr)
+        : Test(parent), mConn(nullptr), mRosterSize(0)
+    { }
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+
+    void benchmarkRosterLoad_data();
+    void benchmarkRosterLoad();
+
+    void cleanup();
+    void cleanupTestCase();
+
+private:
+    void growRoster(int size);
+
+    TestConnHelper *mConn;
+    int mRosterSize;
+};
+
+void BenchmarkRoster::growRoster(int size)
+{
+    TpHandleRepoIface *contactRepo = tp_base_connection_get_handles(
+            TP_BASE_CONNECTION(mConn->service()), TP_HANDLE_TYPE_CONTACT);
+    TestContactListManager *manager = tp_tests_contacts_connection_get_contact_list_manager(
+            TP_TESTS_CONTACTS_CONNECTION(mConn->service()));
+
+    QVector<TpHandle> handles;
+    handles.reserve(size - mRosterSize);
+    for (int i = mRosterSize; i < size; ++i) {
+        QByteArray id = QString(QLatin1String("contact%1@example.com")).arg(i).toLatin1();
+        handles.append(tp_handle_ensure(contactRepo, id.constData(), nullptr, nullptr));
+    }
+
+    // Requesting the subscription without "please" in the message leaves the contacts in the
+    // Ask state, so the roster doesn't change under the benchmark
+    test_contact_list_manager_request_subscription(manager, handles.size(), handles.data(), "");
+    mRosterSize = size;
+}
+
+void BenchmarkRoster::initTestCase()
+{
+    initTestCaseImpl();
+
+    g_type_init();
+    g_set_prgname("benchmark-roster");
+    tp_debug_set_flags("");
+    dbus_g_bus_get(DBUS_BUS_STARTER, nullptr);
+
+    mConn = new TestConnHelper(this,
+            TP_TESTS_TYPE_CONTACTS_CONNECTION,
+            "account", "me@example.com",
+            "protocol", "example",
+            NULL);
+    QCOMPARE(mConn->connect(), true);
+}
+
+void BenchmarkRoster::init()
+{
+    initImpl();
+}
+
+void BenchmarkRoster::benchmarkRosterLoad_data()
+{
+    QTest::addColumn<int>("contacts");
+
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("50k") << 50000;
+    QTest::newRow("100k") << 100000;
+}
+
+void BenchmarkRoster::benchmarkRosterLoad()
+{
+    QFETCH(int, contacts);
+
+    growRoster(contacts);
+
+    // Each iteration introspects the roster from scratch through a new proxy, building a Contact
+    // for every entry
+    QBENCHMARK {
+        ConnectionPtr conn = Connection::create(mConn->client()->busName(),
+                mConn->client()->objectPath(),
+                ChannelFactory::create(QDBusConnection::sessionBus()),
+                ContactFactory::create(Contact::FeatureAlias | Contact::FeatureSimplePresence));
+        QVERIFY(connect(conn->becomeReady(Features() << Connection::FeatureRoster),
+                    SIGNAL(finished(Tp::PendingOperation*)),
+                    SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+        QCOMPARE(mLoop->exec(), 0);
+        QCOMPARE(conn->contactManager()->state(), ContactListStateSuccess);
+        QCOMPARE(conn->contactManager()->allKnownContacts().size(), contacts);
+    }
+}
+
+void BenchmarkRoster::cleanup()
+{
+    cleanupImpl();
+}
+
+void BenchmarkRoster::cleanupTestCase()
+{
+    QCOMPARE(mConn->disconnect(), true);
+    delete mConn;
+
+    cleanupTestCaseImpl();
+}
+
+QTEST_MAIN(BenchmarkRoster)
+#include "_gen/roster.cpp.moc.hpp"
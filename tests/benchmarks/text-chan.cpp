@@ -0,0 +1,163 @@
+#include <tests/lib/test.h>
+
+#include <tests/lib/glib-helpers/test-conn-helper.h>
+
+#include <tests/lib/glib/contacts-conn.h>
+#include <tests/lib/glib/echo2/chan.h>
+
+#include <TelepathyQt/Connection>
+#include <TelepathyQt/PendingReady>
+#include <TelepathyQt/ReceivedMessage>
+#include <TelepathyQt/TextChannel>
+
+#include <telepathy-glib/debug.h>
+
+using namespace Tp;
+
+class BenchmarkTextChannel : public Test
+{
+    Q_OBJECT
+
+public:
+    BenchmarkTextChannel(QObject *parent = nullptr)
+        : Test(parent), mConn(nullptr), mChanService(nullptr),
+          mExpectedMessages(0), mReceivedMessages(0)
+    { }
+
+protected Q_SLOTS:
+    void onMessageReceived(const Tp::ReceivedMessage &message);
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+
+    void benchmarkMessageFlood_data();
+    void benchmarkMessageFlood();
+    void benchmarkChannelReady();
+
+    void cleanup();
+    void cleanupTestCase();
+
+private:
+    TestConnHelper *mConn;
+    ExampleEcho2Channel *mChanService;
+    QString mChanPath;
+    TextChannelPtr mChan;
+    int mExpectedMessages;
+    int mReceivedMessages;
+};
+
+void BenchmarkTextChannel::onMessageReceived(const Tp::ReceivedMessage &message)
+{
+    Q_UNUSED(message);
+
+    if (++mReceivedMessages == mExpectedMessages) {
+        mLoop->exit(0);
+    }
+}
+
+void BenchmarkTextChannel::initTestCase()
+{
+    initTestCaseImpl();
+
+    g_type_init();
+    g_set_prgname("benchmark-text-chan");
+    tp_debug_set_flags("");
+    dbus_g_bus_get(DBUS_BUS_STARTER, nullptr);
+
+    mConn = new TestConnHelper(this,
+            TP_TESTS_TYPE_CONTACTS_CONNECTION,
+            "account", "me@example.com",
+            "protocol", "example",
+            NULL);
+    QCOMPARE(mConn->connect(), true);
+
+    TpHandleRepoIface *contactRepo = tp_base_connection_get_handles(
+            TP_BASE_CONNECTION(mConn->service()), TP_HANDLE_TYPE_CONTACT);
+    guint handle = tp_handle_ensure(contactRepo, "someone@localhost", nullptr, nullptr);
+
+    // create a Channel by magic, rather than doing D-Bus round-trips for it
+    mChanPath = mConn->objectPath() + QLatin1String("/MessagesChannel");
+    QByteArray chanPath(mChanPath.toLatin1());
+    mChanService = EXAMPLE_ECHO_2_CHANNEL(g_object_new(
+                EXAMPLE_TYPE_ECHO_2_CHANNEL,
+                "connection", mConn->service(),
+                "object-path", chanPath.data(),
+                "handle", handle,
+                NULL));
+}
+
+void BenchmarkTextChannel::init()
+{
+    initImpl();
+
+    mChan = TextChannel::create(mConn->client(), mChanPath, QVariantMap());
+    QVERIFY(connect(mChan->becomeReady(TextChannel::FeatureMessageQueue),
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+    QVERIFY(connect(mChan.data(),
+                SIGNAL(messageReceived(Tp::ReceivedMessage)),
+                SLOT(onMessageReceived(Tp::ReceivedMessage))));
+}
+
+void BenchmarkTextChannel::benchmarkMessageFlood_data()
+{
+    QTest::addColumn<int>("messages");
+
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("10k") << 10000;
+}
+
+void BenchmarkTextChannel::benchmarkMessageFlood()
+{
+    QFETCH(int, messages);
+
+    // The echo channel answers every message, so each iteration sends a burst without waiting for
+    // the replies and then receives, queues and acknowledges the same number of messages
+    QBENCHMARK {
+        mExpectedMessages = messages;
+        mReceivedMessages = 0;
+        for (int i = 0; i < messages; ++i) {
+            mChan->send(QString(QLatin1String("Message %1")).arg(i));
+        }
+        QCOMPARE(mLoop->exec(), 0);
+        QCOMPARE(mChan->messageQueue().size(), messages);
+        mChan->acknowledge(mChan->messageQueue());
+    }
+}
+
+void BenchmarkTextChannel::benchmarkChannelReady()
+{
+    QBENCHMARK {
+        TextChannelPtr chan = TextChannel::create(mConn->client(), mChanPath, QVariantMap());
+        QVERIFY(connect(chan->becomeReady(TextChannel::FeatureMessageQueue |
+                        TextChannel::FeatureMessageCapabilities),
+                    SIGNAL(finished(Tp::PendingOperation*)),
+                    SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+        QCOMPARE(mLoop->exec(), 0);
+    }
+}
+
+void BenchmarkTextChannel::cleanup()
+{
+    mChan.reset();
+
+    cleanupImpl();
+}
+
+void BenchmarkTextChannel::cleanupTestCase()
+{
+    QCOMPARE(mConn->disconnect(), true);
+    delete mConn;
+
+    if (mChanService != nullptr) {
+        g_object_unref(mChanService);
+        mChanService = nullptr;
+    }
+
+    cleanupTestCaseImpl();
+}
+
+QTEST_MAIN(BenchmarkTextChannel)
+#include "_gen/text-chan.cpp.moc.hpp"
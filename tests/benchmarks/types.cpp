@@ -0,0 +1,133 @@
+#include <tests/lib/test.h>
+
+#include <TelepathyQt/Channel>
+#include <TelepathyQt/Types>
+
+using namespace Tp;
+
+/* Channel.Interface.Tube's Parameters property is a QVariantMap for which we already have the
+ * autogenerated interface, so use it to get large containers through the bus */
+class TubeAdaptor : public QDBusAbstractAdaptor
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.freedesktop.Telepathy.Channel.Interface.Tube")
+    Q_CLASSINFO("D-Bus Introspection", ""
+"  <interface name=\"org.freedesktop.Telepathy.Channel.Interface.Tube\" >\n"
+"    <property name=\"Parameters\" type=\"a{sv}\" access=\"read\" />\n"
+"  </interface>\n"
+        "")
+
+    Q_PROPERTY(QVariantMap Parameters READ Parameters)
+
+public:
+    TubeAdaptor(QObject *parent) : QDBusAbstractAdaptor(parent) {}
+    ~TubeAdaptor() override {}
+
+public: // Properties
+    inline QVariantMap Parameters() const
+    {
+        QVariantMap ret;
+
+        QList<uint> sizes = QList<uint>() << 1000 << 10000 << 100000;
+        Q_FOREACH (uint size, sizes) {
+            ContactAttributesMap attributes;
+            for (uint handle = 1; handle <= size; ++handle) {
+                QVariantMap contactAttributes;
+                contactAttributes.insert(TP_QT_IFACE_CONNECTION + QLatin1String("/contact-id"),
+                        QString(QLatin1String("contact%1@example.com")).arg(handle));
+                contactAttributes.insert(
+                        TP_QT_IFACE_CONNECTION_INTERFACE_ALIASING + QLatin1String("/alias"),
+                        QString(QLatin1String("Contact %1")).arg(handle));
+                attributes.insert(handle, contactAttributes);
+            }
+            ret.insert(QString::number(size), QVariant::fromValue(attributes));
+        }
+
+        return ret;
+    }
+};
+
+class BenchmarkTypes : public Test
+{
+    Q_OBJECT
+
+public:
+    BenchmarkTypes(QObject *parent = nullptr)
+        : Test(parent)
+    { }
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+
+    void benchmarkContactAttributes_data();
+    void benchmarkContactAttributes();
+
+    void cleanup();
+    void cleanupTestCase();
+
+private:
+    QVariantMap mParameters;
+};
+
+void BenchmarkTypes::initTestCase()
+{
+    initTestCaseImpl();
+
+    QDBusConnection bus = QDBusConnection::sessionBus();
+
+    QString tubeBusName = QLatin1String("org.freedesktop.Telepathy.Test.BenchmarkTypes");
+    QString tubePath = QLatin1String("/org/freedesktop/Telepathy/Test/BenchmarkTypes");
+
+    QObject *adaptorObject = new QObject(this);
+    (void) new TubeAdaptor(adaptorObject);
+    QVERIFY(bus.registerService(tubeBusName));
+    QVERIFY(bus.registerObject(tubePath, adaptorObject));
+
+    Client::ChannelInterfaceTubeInterface *tubeIface = new Client::ChannelInterfaceTubeInterface(
+            bus, tubeBusName, tubePath, this);
+    QVERIFY(waitForProperty(tubeIface->requestPropertyParameters(), &mParameters));
+}
+
+void BenchmarkTypes::init()
+{
+    initImpl();
+}
+
+void BenchmarkTypes::benchmarkContactAttributes_data()
+{
+    QTest::addColumn<int>("contacts");
+
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+}
+
+// Measures demarshalling a ContactAttributesMap as received from the bus
+void BenchmarkTypes::benchmarkContactAttributes()
+{
+    QFETCH(int, contacts);
+
+    QVariant value = mParameters.value(QString::number(contacts));
+    QVERIFY(value.isValid());
+
+    // The QDBusArgument in the value can only be read once
+    ContactAttributesMap attributes;
+    QBENCHMARK_ONCE {
+        attributes = qdbus_cast<ContactAttributesMap>(value);
+    }
+    QCOMPARE(attributes.size(), contacts);
+}
+
+void BenchmarkTypes::cleanup()
+{
+    cleanupImpl();
+}
+
+void BenchmarkTypes::cleanupTestCase()
+{
+    cleanupTestCaseImpl();
+}
+
+QTEST_MAIN(BenchmarkTypes)
+#include "_gen/types.cpp.moc.hpp"
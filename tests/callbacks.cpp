@@ -11,6 +11,8 @@ class TestCallbacks : public QObject
 private Q_SLOTS:
     void testMemFun();
     void testPtrFun();
+    void testCopy();
+    void benchmarkCopy();
 };
 
 struct MyCallbacks
@@ -256,6 +258,111 @@ void TestCallbacks::testPtrFun()
     reset();
 }
 
+namespace
+{
+    struct CountingFunctor
+    {
+        CountingFunctor(int *copies) : copies(copies) {}
+        CountingFunctor(const CountingFunctor &other) : copies(other.copies) { ++*copies; }
+
+        int operator()(int a1) const { return a1 * 2; }
+
+        int *copies;
+    };
+
+    struct StatefulFunctor
+    {
+        StatefulFunctor() : calls(0) {}
+
+        // Not const, the functor keeps track of its own calls
+        int operator()(int a1) { return a1 + ++calls; }
+
+        QString name;
+        int calls;
+    };
+}
+
+void TestCallbacks::testCopy()
+{
+    MyCallbacks cbs;
+
+    Callback1<void, int> cbVI1;
+    QVERIFY(!cbVI1.isValid());
+    cbVI1(1);
+
+    // Small functors are stored inline
+    cbVI1 = memFun(&cbs, &MyCallbacks::testVI1);
+    Callback1<void, int> copy(cbVI1);
+    QVERIFY(copy.isValid());
+    copy(1);
+    cbs.verifyCalled(false, true, false, false, false, false, false, false);
+    cbs.reset();
+
+    Callback1<void, int> moved(std::move(copy));
+    QVERIFY(!copy.isValid());
+    copy(1);
+    cbs.verifyCalled(false, false, false, false, false, false, false, false);
+    moved(1);
+    cbs.verifyCalled(false, true, false, false, false, false, false, false);
+    cbs.reset();
+
+    // Other functors are cloned with each copy, but not when moving
+    int copies = 0;
+    Callback1<int, int> cbII1 = CountingFunctor(&copies);
+    const int copiesAfterCreation = copies;
+    QVERIFY(copiesAfterCreation > 0);
+
+    Callback1<int, int> other = cbII1;
+    QCOMPARE(copies, copiesAfterCreation + 1);
+    Callback1<int, int> assigned;
+    assigned = other;
+    QCOMPARE(copies, copiesAfterCreation + 2);
+    Callback1<int, int> movedII1(std::move(other));
+    QCOMPARE(copies, copiesAfterCreation + 2);
+    other = movedII1;
+    QCOMPARE(cbII1(2), 4);
+    QCOMPARE(other(3), 6);
+    QCOMPARE(assigned(4), 8);
+
+    other = Callback1<int, int>();
+    QVERIFY(!other.isValid());
+    QCOMPARE(assigned(5), 10);
+
+    Callback0<void> lambda = [&cbs]() { cbs.testVV(); };
+    lambda();
+    cbs.verifyCalled(true, false, false, false, false, false, false, false);
+
+    // Functors with a non-const call operator keep their state, and each copy has its own
+    Callback1<int, int> stateful = StatefulFunctor();
+    QCOMPARE(stateful(10), 11);
+    QCOMPARE(stateful(10), 12);
+    Callback1<int, int> statefulCopy = stateful;
+    QCOMPARE(statefulCopy(10), 13);
+    QCOMPARE(stateful(10), 13);
+
+    int calls = 0;
+    Callback1<int, int> mutableLambda = [calls](int a1) mutable { return a1 + ++calls; };
+    QCOMPARE(mutableLambda(1), 2);
+    Callback1<int, int> mutableLambdaCopy = mutableLambda;
+    QCOMPARE(mutableLambdaCopy(1), 3);
+    QCOMPARE(mutableLambda(1), 3);
+}
+
+void TestCallbacks::benchmarkCopy()
+{
+    MyCallbacks cbs;
+    Callback1<void, int> cbVI1 = memFun(&cbs, &MyCallbacks::testVI1);
+
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i) {
+            Callback1<void, int> copy = cbVI1;
+            copy(1);
+        }
+    }
+
+    QVERIFY(cbs.mVI1Called);
+}
+
 QTEST_MAIN(TestCallbacks)
 
 #include "_gen/callbacks.cpp.moc.hpp"
@@ -21,6 +21,7 @@ public:
 private Q_SLOTS:
     void testConnCapabilities();
     void testContactCapabilities();
+    void benchmarkQueries();
 };
 
 TestCapabilities::TestCapabilities(QObject *parent)
@@ -378,6 +379,38 @@ void TestCapabilities::testContactCapabilities()
     QCOMPARE(stubeServices, expectedSTubeServices);
 }
 
+void TestCapabilities::benchmarkQueries()
+{
+    RequestableChannelClassSpecList rccSpecs;
+    rccSpecs.append(RequestableChannelClassSpec::textChatroom());
+    rccSpecs.append(RequestableChannelClassSpec::conferenceTextChatroom());
+    rccSpecs.append(RequestableChannelClassSpec::contactSearch());
+    rccSpecs.append(RequestableChannelClassSpec::streamTube(QLatin1String("service-foo")));
+    rccSpecs.append(RequestableChannelClassSpec::audioCall());
+    rccSpecs.append(RequestableChannelClassSpec::videoCall());
+    rccSpecs.append(RequestableChannelClassSpec::fileTransfer());
+    rccSpecs.append(RequestableChannelClassSpec::textChat());
+
+    // Filtering a large contact list queries the same capabilities over and over
+    QList<ContactCapabilities> contactCaps;
+    for (int i = 0; i < 1000; ++i) {
+        contactCaps.append(TestBackdoors::createContactCapabilities(rccSpecs, true));
+    }
+
+    int matching = 0;
+    QBENCHMARK {
+        matching = 0;
+        foreach (const ContactCapabilities &caps, contactCaps) {
+            if (caps.textChats() && caps.audioCalls() && !caps.videoCallsWithAudio() &&
+                caps.fileTransfers()) {
+                ++matching;
+            }
+        }
+    }
+
+    QCOMPARE(matching, contactCaps.size());
+}
+
 QTEST_MAIN(TestCapabilities)
 
 #include "_gen/capabilities.cpp.moc.hpp"
@@ -5,9 +5,13 @@
 #include <tests/lib/glib/echo2/conn.h>
 
 #include <TelepathyQt/Account>
+#include <TelepathyQt/AccountFactory>
 #include <TelepathyQt/AccountManager>
 #include <TelepathyQt/AccountSet>
+#include <TelepathyQt/ChannelFactory>
 #include <TelepathyQt/ConnectionCapabilities>
+#include <TelepathyQt/ConnectionFactory>
+#include <TelepathyQt/ContactFactory>
 #include <TelepathyQt/PendingAccount>
 #include <TelepathyQt/PendingOperation>
 #include <TelepathyQt/PendingReady>
@@ -17,8 +21,51 @@
 
 #include <telepathy-glib/debug.h>
 
+#include <QDBusVirtualObject>
+
 using namespace Tp;
 
+// Holds the calls made to the channel dispatcher until release() is called, which keeps accounts
+// from finishing FeatureCore in the meantime
+class HeldDispatcher : public QDBusVirtualObject
+{
+public:
+    HeldDispatcher(const QDBusConnection &bus)
+        : mBus(bus)
+    { }
+
+    QString introspect(const QString &path) const override
+    {
+        Q_UNUSED(path);
+        return QString();
+    }
+
+    bool handleMessage(const QDBusMessage &message, const QDBusConnection &connection) override
+    {
+        Q_UNUSED(connection);
+        mHeld.append(message);
+        return true;
+    }
+
+    int heldCount() const
+    {
+        return mHeld.size();
+    }
+
+    void release()
+    {
+        // Only Properties.Get(SupportsRequestHints) is expected
+        Q_FOREACH (const QDBusMessage &message, mHeld) {
+            mBus.send(message.createReply(QVariant::fromValue(QDBusVariant(false))));
+        }
+        mHeld.clear();
+    }
+
+private:
+    QDBusConnection mBus;
+    QList<QDBusMessage> mHeld;
+};
+
 class TestAccountBasics : public Test
 {
     Q_OBJECT
@@ -27,7 +74,8 @@ public:
     TestAccountBasics(QObject *parent = 0)
         : Test(parent),
           mConn(0),
-          mAccountsCount(0)
+          mAccountsCount(0),
+          mDispatcher(0)
     { }
 
 protected Q_SLOTS:
@@ -49,6 +97,7 @@ private Q_SLOTS:
     void init();
 
     void testBasics();
+    void testPrefetchedProperties();
 
     void cleanup();
     void cleanupTestCase();
@@ -63,6 +112,8 @@ private:
     bool mCreatingAccount;
 
     QHash<QString, QVariant> mProps;
+
+    HeldDispatcher *mDispatcher;
 };
 
 #define TEST_VERIFY_PROPERTY_CHANGE(acc, Type, PropertyName, propertyName, expectedValue) \
@@ -316,7 +367,12 @@ void TestAccountBasics::testBasics()
     QCOMPARE(acc->uniqueIdentifier(), QLatin1String("foo/bar/Account0"));
     QCOMPARE(acc->normalizedName(), QLatin1String("bob"));
 
+    QSignalSpy propertiesChangedSpy(acc.data(), SIGNAL(propertiesChanged(QStringList)));
     TEST_VERIFY_PROPERTY_CHANGE(acc, QString, DisplayName, displayName, QLatin1String("foo@bar"));
+    // Only the properties which really changed are reported, all in one go
+    QCOMPARE(propertiesChangedSpy.count(), 1);
+    QCOMPARE(propertiesChangedSpy.first().at(0).toStringList(),
+            QStringList() << QLatin1String("displayName"));
 
     TEST_VERIFY_PROPERTY_CHANGE(acc, QString, IconName, iconName, QLatin1String("im-foo"));
 
@@ -581,8 +637,71 @@ void TestAccountBasics::testBasics()
     processDBusQueue(mConn->client().data());
 }
 
+void TestAccountBasics::testPrefetchedProperties()
+{
+    QString accPath(QLatin1String("/org/freedesktop/Telepathy/Account/spurious/normal/Account0"));
+    AccountPtr acc = mAM->accountForObjectPath(accPath);
+    QVERIFY(!acc.isNull());
+
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    mDispatcher = new HeldDispatcher(bus);
+    QVERIFY(bus.registerService(TP_QT_CHANNEL_DISPATCHER_BUS_NAME));
+    QVERIFY(bus.registerVirtualObject(TP_QT_CHANNEL_DISPATCHER_OBJECT_PATH, mDispatcher));
+
+    // The channel dispatcher is only introspected once per bus connection, so use a new one
+    QDBusConnection otherBus = QDBusConnection::connectToBus(QDBusConnection::SessionBus,
+            QLatin1String("account-basics-prefetch"));
+    QVERIFY(otherBus.isConnected());
+
+    AccountFactoryPtr otherAccFactory = AccountFactory::create(otherBus, Account::FeatureCore);
+    AccountManagerPtr otherAM = AccountManager::create(otherBus, otherAccFactory,
+            ConnectionFactory::create(otherBus), ChannelFactory::create(otherBus),
+            ContactFactory::create());
+    QVERIFY(connect(otherAM->becomeReady(),
+                    SIGNAL(finished(Tp::PendingOperation *)),
+                    SLOT(expectSuccessfulCall(Tp::PendingOperation *))));
+
+    // The accounts have been added and are waiting for the channel dispatcher
+    QTRY_VERIFY(mDispatcher->heldCount() > 0);
+    AccountPtr otherAcc = AccountPtr::qObjectCast(otherAccFactory->proxy(otherAM->busName(),
+                accPath, otherAM->connectionFactory(), otherAM->channelFactory(),
+                otherAM->contactFactory())->proxy());
+    QVERIFY(!otherAcc.isNull());
+
+    // The prefetched properties are applied as soon as they arrive
+    QTRY_COMPARE(otherAcc->displayName(), acc->displayName());
+    QVERIFY(!otherAcc->isReady());
+
+    // A change signalled before FeatureCore finishes isn't overwritten by the prefetched properties
+    QString displayName(QLatin1String("Changed while prefetching"));
+    QVERIFY(connect(acc->setDisplayName(displayName),
+                    SIGNAL(finished(Tp::PendingOperation *)),
+                    SLOT(expectSuccessfulCall(Tp::PendingOperation *))));
+    QCOMPARE(mLoop->exec(), 0);
+    QTRY_COMPARE(otherAcc->displayName(), displayName);
+    QVERIFY(!otherAcc->isReady());
+
+    mDispatcher->release();
+    QCOMPARE(mLoop->exec(), 0);
+    QVERIFY(otherAM->isReady());
+    QVERIFY(otherAcc->isReady());
+    QCOMPARE(otherAcc->displayName(), displayName);
+}
+
 void TestAccountBasics::cleanup()
 {
+    // Take down the fake channel dispatcher even if testPrefetchedProperties failed halfway, so
+    // it can't answer for the real one in later tests
+    if (mDispatcher) {
+        QDBusConnection bus = QDBusConnection::sessionBus();
+        bus.unregisterObject(TP_QT_CHANNEL_DISPATCHER_OBJECT_PATH);
+        bus.unregisterService(TP_QT_CHANNEL_DISPATCHER_BUS_NAME);
+        delete mDispatcher;
+        mDispatcher = 0;
+
+        QDBusConnection::disconnectFromBus(QLatin1String("account-basics-prefetch"));
+    }
+
     cleanupImpl();
 }
 
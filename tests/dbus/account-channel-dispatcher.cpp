@@ -1144,6 +1144,7 @@ void TestAccountChannelDispatcher::testCreateAndHandleChannelHandledChannels()
 
     QVERIFY(!ourHandlers().isEmpty());
     QCOMPARE(ourHandlers().size(), 1);
+    QString firstHandler = mChannelDispatcherAdaptor->mCurPreferredHandler;
 
     mChanPath = mConn->objectPath() + QLatin1String("/channelother");
     mChanProps = ChannelClassSpec::textChat().allProperties();
@@ -1151,6 +1152,9 @@ void TestAccountChannelDispatcher::testCreateAndHandleChannelHandledChannels()
     ChannelPtr channel2;
     TEST_CREATE_ENSURE_AND_HANDLE_CHANNEL(createAndHandleChannel, false, false, true, "", &channel2, 0);
 
+    // requests made while the first channel is still handled reuse its handler
+    QCOMPARE(mChannelDispatcherAdaptor->mCurPreferredHandler, firstHandler);
+
     // check that the channel appears in the HandledChannels property of some handler
     QVERIFY(!ourHandledChannels().isEmpty());
     QCOMPARE(ourHandledChannels().size(), 2);
@@ -0,0 +1,495 @@
+#include <tests/lib/test.h>
+
+#include <TelepathyQt/BaseConnection>
+#include <TelepathyQt/BaseHandleRepository>
+#include <TelepathyQt/DBusError>
+
+using namespace Tp;
+
+class TestBaseContactAttributes : public Test
+{
+    Q_OBJECT
+public:
+    TestBaseContactAttributes(QObject *parent = nullptr)
+        : Test(parent), mGetAliasesCalls(0), mGetContactAttributesCalls(0),
+          mGetContactListAttributesCalls(0)
+    { }
+
+private:
+    Tp::AliasMap getAliases(const Tp::UIntList &contacts, Tp::DBusError *error);
+    Tp::AvatarTokenMap getKnownAvatarTokens(const Tp::UIntList &contacts, Tp::DBusError *error);
+    Tp::ContactClientTypes getClientTypes(const Tp::UIntList &contacts, Tp::DBusError *error);
+    Tp::ContactCapabilitiesMap getContactCapabilities(const Tp::UIntList &contacts,
+            Tp::DBusError *error);
+    Tp::ContactAttributesMap getContactAttributes(const Tp::UIntList &handles,
+            const QStringList &interfaces, Tp::DBusError *error);
+    Tp::ContactAttributesMap getContactListAttributes(const QStringList &interfaces, bool hold,
+            Tp::DBusError *error);
+
+    Tp::AliasMap mAliases;
+    int mGetAliasesCalls;
+    Tp::AvatarTokenMap mAvatarTokens;
+    Tp::ContactClientTypes mClientTypes;
+    Tp::ContactCapabilitiesMap mCapabilities;
+    Tp::ContactAttributesMap mContactList;
+    QStringList mGetContactAttributesInterfaces;
+    int mGetContactAttributesCalls;
+    int mGetContactListAttributesCalls;
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+
+    void testProviders();
+    void testGetterProviders();
+    void testContactListProviders();
+    void testCallback();
+
+    void cleanup();
+    void cleanupTestCase();
+};
+
+Tp::AliasMap TestBaseContactAttributes::getAliases(const Tp::UIntList &contacts,
+        Tp::DBusError *error)
+{
+    Q_UNUSED(error)
+
+    ++mGetAliasesCalls;
+
+    Tp::AliasMap aliases;
+    foreach (uint contact, contacts) {
+        aliases.insert(contact, mAliases.value(contact));
+    }
+    return aliases;
+}
+
+Tp::AvatarTokenMap TestBaseContactAttributes::getKnownAvatarTokens(const Tp::UIntList &contacts,
+        Tp::DBusError *error)
+{
+    Q_UNUSED(error)
+
+    Tp::AvatarTokenMap tokens;
+    foreach (uint contact, contacts) {
+        if (mAvatarTokens.contains(contact)) {
+            tokens.insert(contact, mAvatarTokens.value(contact));
+        }
+    }
+    return tokens;
+}
+
+Tp::ContactClientTypes TestBaseContactAttributes::getClientTypes(const Tp::UIntList &contacts,
+        Tp::DBusError *error)
+{
+    Q_UNUSED(error)
+
+    Tp::ContactClientTypes clientTypes;
+    foreach (uint contact, contacts) {
+        if (mClientTypes.contains(contact)) {
+            clientTypes.insert(contact, mClientTypes.value(contact));
+        }
+    }
+    return clientTypes;
+}
+
+Tp::ContactCapabilitiesMap TestBaseContactAttributes::getContactCapabilities(
+        const Tp::UIntList &contacts, Tp::DBusError *error)
+{
+    Q_UNUSED(error)
+
+    Tp::ContactCapabilitiesMap capabilities;
+    foreach (uint contact, contacts) {
+        if (mCapabilities.contains(contact)) {
+            capabilities.insert(contact, mCapabilities.value(contact));
+        }
+    }
+    return capabilities;
+}
+
+Tp::ContactAttributesMap TestBaseContactAttributes::getContactAttributes(
+        const Tp::UIntList &handles, const QStringList &interfaces, Tp::DBusError *error)
+{
+    Q_UNUSED(error)
+
+    ++mGetContactAttributesCalls;
+    mGetContactAttributesInterfaces = interfaces;
+
+    // Report every contact with its identifier and a presence of our own
+    Tp::SimplePresence away = { ConnectionPresenceTypeAway, QLatin1String("away"), QString() };
+    Tp::ContactAttributesMap attributes;
+    foreach (uint handle, handles) {
+        attributes[handle].insert(TP_QT_IFACE_CONNECTION + QLatin1String("/contact-id"),
+                QString(QLatin1String("contact%1")).arg(handle));
+        if (interfaces.contains(TP_QT_IFACE_CONNECTION_INTERFACE_SIMPLE_PRESENCE)) {
+            attributes[handle].insert(TP_QT_IFACE_CONNECTION_INTERFACE_SIMPLE_PRESENCE +
+                    QLatin1String("/presence"), QVariant::fromValue(away));
+        }
+    }
+    return attributes;
+}
+
+Tp::ContactAttributesMap TestBaseContactAttributes::getContactListAttributes(
+        const QStringList &interfaces, bool hold, Tp::DBusError *error)
+{
+    Q_UNUSED(interfaces)
+    Q_UNUSED(hold)
+    Q_UNUSED(error)
+
+    ++mGetContactListAttributesCalls;
+    return mContactList;
+}
+
+void TestBaseContactAttributes::initTestCase()
+{
+    initTestCaseImpl();
+}
+
+void TestBaseContactAttributes::init()
+{
+    initImpl();
+    mAliases.clear();
+    mGetAliasesCalls = 0;
+    mAvatarTokens.clear();
+    mClientTypes.clear();
+    mCapabilities.clear();
+    mContactList.clear();
+    mGetContactAttributesInterfaces.clear();
+    mGetContactAttributesCalls = 0;
+    mGetContactListAttributesCalls = 0;
+}
+
+void TestBaseContactAttributes::testProviders()
+{
+    BaseConnectionPtr conn = BaseConnection::create(QLatin1String("testcm"),
+            QLatin1String("example"), QVariantMap());
+
+    BaseHandleRepositoryPtr repository = BaseHandleRepository::create(HandleTypeContact);
+    conn->setHandleRepository(repository);
+
+    BaseConnectionContactsInterfacePtr contactsIface = BaseConnectionContactsInterface::create();
+    BaseConnectionSimplePresenceInterfacePtr presenceIface = BaseConnectionSimplePresenceInterface::create();
+    BaseConnectionAliasingInterfacePtr aliasingIface = BaseConnectionAliasingInterface::create();
+    aliasingIface->setGetAliasesCallback(memFun(this, &TestBaseContactAttributes::getAliases));
+    QVERIFY(conn->plugInterface(AbstractConnectionInterfacePtr::dynamicCast(contactsIface)));
+    QVERIFY(conn->plugInterface(AbstractConnectionInterfacePtr::dynamicCast(presenceIface)));
+    QVERIFY(conn->plugInterface(AbstractConnectionInterfacePtr::dynamicCast(aliasingIface)));
+
+    DBusError error;
+    Tp::UIntList handles = repository->ensureHandles(QStringList()
+            << QLatin1String("alice") << QLatin1String("bob"), &error);
+    QVERIFY(!error.isValid());
+    uint alice = handles[0];
+    uint bob = handles[1];
+
+    mAliases.insert(alice, QLatin1String("Alice"));
+    mAliases.insert(bob, QLatin1String("Bob"));
+    Tp::SimplePresence available = { ConnectionPresenceTypeAvailable,
+        QLatin1String("available"), QString() };
+    Tp::SimpleContactPresences presences;
+    presences.insert(alice, available);
+    presenceIface->setPresences(presences);
+
+    const QString idKey = TP_QT_IFACE_CONNECTION + QLatin1String("/contact-id");
+    const QString aliasKey = TP_QT_IFACE_CONNECTION_INTERFACE_ALIASING + QLatin1String("/alias");
+    const QString presenceKey = TP_QT_IFACE_CONNECTION_INTERFACE_SIMPLE_PRESENCE + QLatin1String("/presence");
+    const QStringList interfaces = QStringList()
+        << TP_QT_IFACE_CONNECTION_INTERFACE_ALIASING
+        << TP_QT_IFACE_CONNECTION_INTERFACE_SIMPLE_PRESENCE;
+
+    // Without a GetContactAttributes callback, everything comes from the plugged interfaces
+    Tp::ContactAttributesMap attributes = contactsIface->getContactAttributes(handles,
+            interfaces, &error);
+    QVERIFY(!error.isValid());
+    QCOMPARE(attributes.size(), 2);
+    QCOMPARE(attributes[alice].value(idKey).toString(), QString(QLatin1String("alice")));
+    QCOMPARE(attributes[alice].value(aliasKey).toString(), QString(QLatin1String("Alice")));
+    QCOMPARE(qdbus_cast<Tp::SimplePresence>(attributes[alice].value(presenceKey)).status,
+            QString(QLatin1String("available")));
+    QCOMPARE(qdbus_cast<Tp::SimplePresence>(attributes[bob].value(presenceKey)).type,
+            static_cast<uint>(ConnectionPresenceTypeUnknown));
+    QCOMPARE(mGetAliasesCalls, 1);
+
+    // Cached attributes are reused until the interfaces report changes
+    attributes = contactsIface->getContactAttributes(handles, interfaces, &error);
+    QVERIFY(!error.isValid());
+    QCOMPARE(mGetAliasesCalls, 1);
+
+    mAliases.insert(bob, QLatin1String("Robert"));
+    Tp::AliasPair pair = { bob, QLatin1String("Robert") };
+    aliasingIface->aliasesChanged(Tp::AliasPairList() << pair);
+    presences.clear();
+    presences.insert(bob, available);
+    presenceIface->setPresences(presences);
+
+    attributes = contactsIface->getContactAttributes(handles, interfaces, &error);
+    QVERIFY(!error.isValid());
+    QCOMPARE(mGetAliasesCalls, 2);
+    QCOMPARE(attributes[bob].value(aliasKey).toString(), QString(QLatin1String("Robert")));
+    QCOMPARE(qdbus_cast<Tp::SimplePresence>(attributes[bob].value(presenceKey)).status,
+            QString(QLatin1String("available")));
+
+    // Invalid handles fail the request
+    contactsIface->getContactAttributes(Tp::UIntList() << alice << 12345, interfaces, &error);
+    QCOMPARE(error.name(), TP_QT_ERROR_INVALID_HANDLE);
+}
+
+void TestBaseContactAttributes::testGetterProviders()
+{
+    BaseConnectionPtr conn = BaseConnection::create(QLatin1String("testcm"),
+            QLatin1String("example"), QVariantMap());
+
+    BaseHandleRepositoryPtr repository = BaseHandleRepository::create(HandleTypeContact);
+    conn->setHandleRepository(repository);
+
+    BaseConnectionContactsInterfacePtr contactsIface = BaseConnectionContactsInterface::create();
+    BaseConnectionAvatarsInterfacePtr avatarsIface = BaseConnectionAvatarsInterface::create();
+    BaseConnectionClientTypesInterfacePtr clientTypesIface = BaseConnectionClientTypesInterface::create();
+    BaseConnectionContactCapabilitiesInterfacePtr capsIface =
+        BaseConnectionContactCapabilitiesInterface::create();
+    QVERIFY(conn->plugInterface(AbstractConnectionInterfacePtr::dynamicCast(contactsIface)));
+    QVERIFY(conn->plugInterface(AbstractConnectionInterfacePtr::dynamicCast(avatarsIface)));
+    QVERIFY(conn->plugInterface(AbstractConnectionInterfacePtr::dynamicCast(clientTypesIface)));
+    QVERIFY(conn->plugInterface(AbstractConnectionInterfacePtr::dynamicCast(capsIface)));
+
+    // Interfaces without getter callbacks provide nothing
+    QVERIFY(!avatarsIface->providesContactAttributes());
+    QVERIFY(!clientTypesIface->providesContactAttributes());
+    QVERIFY(!capsIface->providesContactAttributes());
+
+    avatarsIface->setGetKnownAvatarTokensCallback(
+            memFun(this, &TestBaseContactAttributes::getKnownAvatarTokens));
+    clientTypesIface->setGetClientTypesCallback(
+            memFun(this, &TestBaseContactAttributes::getClientTypes));
+    capsIface->setGetContactCapabilitiesCallback(
+            memFun(this, &TestBaseContactAttributes::getContactCapabilities));
+    QVERIFY(avatarsIface->providesContactAttributes());
+    QVERIFY(clientTypesIface->providesContactAttributes());
+    QVERIFY(capsIface->providesContactAttributes());
+
+    DBusError error;
+    Tp::UIntList handles = repository->ensureHandles(QStringList()
+            << QLatin1String("alice") << QLatin1String("bob"), &error);
+    QVERIFY(!error.isValid());
+    uint alice = handles[0];
+    uint bob = handles[1];
+
+    mAvatarTokens.insert(alice, QLatin1String("alice-token"));
+    mClientTypes.insert(bob, QStringList() << QLatin1String("phone"));
+    Tp::RequestableChannelClass textClass;
+    textClass.fixedProperties.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType"),
+            TP_QT_IFACE_CHANNEL_TYPE_TEXT);
+    mCapabilities.insert(alice, Tp::RequestableChannelClassList() << textClass);
+
+    const QString tokenKey = TP_QT_IFACE_CONNECTION_INTERFACE_AVATARS + QLatin1String("/token");
+    const QString clientTypesKey = TP_QT_IFACE_CONNECTION_INTERFACE_CLIENT_TYPES +
+        QLatin1String("/client-types");
+    const QString capsKey = TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_CAPABILITIES +
+        QLatin1String("/capabilities");
+    const QStringList interfaces = QStringList()
+        << TP_QT_IFACE_CONNECTION_INTERFACE_AVATARS
+        << TP_QT_IFACE_CONNECTION_INTERFACE_CLIENT_TYPES
+        << TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_CAPABILITIES;
+
+    Tp::ContactAttributesMap attributes = contactsIface->getContactAttributes(handles,
+            interfaces, &error);
+    QVERIFY(!error.isValid());
+    QCOMPARE(attributes.size(), 2);
+    QCOMPARE(attributes[alice].value(tokenKey).toString(), QString(QLatin1String("alice-token")));
+    QVERIFY(!attributes[bob].contains(tokenKey));
+    QVERIFY(!attributes[alice].contains(clientTypesKey));
+    QCOMPARE(attributes[bob].value(clientTypesKey).toStringList(),
+            QStringList() << QLatin1String("phone"));
+    QCOMPARE(qdbus_cast<Tp::RequestableChannelClassList>(attributes[alice].value(capsKey)).size(), 1);
+    QVERIFY(!attributes[bob].contains(capsKey));
+
+    // Cached values stay until the interface reports a change
+    mAvatarTokens.insert(bob, QLatin1String("bob-token"));
+    mClientTypes.insert(alice, QStringList() << QLatin1String("pc"));
+    mCapabilities.insert(bob, Tp::RequestableChannelClassList() << textClass);
+    attributes = contactsIface->getContactAttributes(handles, interfaces, &error);
+    QVERIFY(!error.isValid());
+    QVERIFY(!attributes[bob].contains(tokenKey));
+    QVERIFY(!attributes[alice].contains(clientTypesKey));
+    QVERIFY(!attributes[bob].contains(capsKey));
+
+    avatarsIface->avatarUpdated(bob, QLatin1String("bob-token"));
+    clientTypesIface->clientTypesUpdated(alice, QStringList() << QLatin1String("pc"));
+    Tp::ContactCapabilitiesMap changedCaps;
+    changedCaps.insert(bob, mCapabilities.value(bob));
+    capsIface->contactCapabilitiesChanged(changedCaps);
+
+    attributes = contactsIface->getContactAttributes(handles, interfaces, &error);
+    QVERIFY(!error.isValid());
+    QCOMPARE(attributes[bob].value(tokenKey).toString(), QString(QLatin1String("bob-token")));
+    QCOMPARE(attributes[alice].value(clientTypesKey).toStringList(),
+            QStringList() << QLatin1String("pc"));
+    QCOMPARE(qdbus_cast<Tp::RequestableChannelClassList>(attributes[bob].value(capsKey)).size(), 1);
+
+    // Dropping the getter callback stops the interface providing attributes
+    avatarsIface->setGetKnownAvatarTokensCallback(
+            BaseConnectionAvatarsInterface::GetKnownAvatarTokensCallback());
+    QVERIFY(!avatarsIface->providesContactAttributes());
+    contactsIface->getContactAttributes(handles, interfaces, &error);
+    QCOMPARE(error.name(), TP_QT_ERROR_NOT_IMPLEMENTED);
+}
+
+void TestBaseContactAttributes::testContactListProviders()
+{
+    BaseConnectionPtr conn = BaseConnection::create(QLatin1String("testcm"),
+            QLatin1String("example"), QVariantMap());
+
+    BaseHandleRepositoryPtr repository = BaseHandleRepository::create(HandleTypeContact);
+    conn->setHandleRepository(repository);
+
+    BaseConnectionContactsInterfacePtr contactsIface = BaseConnectionContactsInterface::create();
+    BaseConnectionContactListInterfacePtr listIface = BaseConnectionContactListInterface::create();
+    BaseConnectionContactGroupsInterfacePtr groupsIface = BaseConnectionContactGroupsInterface::create();
+    QVERIFY(conn->plugInterface(AbstractConnectionInterfacePtr::dynamicCast(contactsIface)));
+    QVERIFY(conn->plugInterface(AbstractConnectionInterfacePtr::dynamicCast(listIface)));
+    QVERIFY(conn->plugInterface(AbstractConnectionInterfacePtr::dynamicCast(groupsIface)));
+    QVERIFY(!listIface->providesContactAttributes());
+
+    listIface->setGetContactListAttributesCallback(
+            memFun(this, &TestBaseContactAttributes::getContactListAttributes));
+    QVERIFY(listIface->providesContactAttributes());
+    QVERIFY(groupsIface->providesContactAttributes());
+
+    DBusError error;
+    Tp::UIntList handles = repository->ensureHandles(QStringList()
+            << QLatin1String("alice") << QLatin1String("bob"), &error);
+    QVERIFY(!error.isValid());
+    uint alice = handles[0];
+    uint bob = handles[1];
+
+    const QString subscribeKey = TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_LIST +
+        QLatin1String("/subscribe");
+    const QString groupsKey = TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_GROUPS +
+        QLatin1String("/groups");
+    mContactList[alice].insert(subscribeKey, static_cast<uint>(SubscriptionStateYes));
+    mContactList[alice].insert(groupsKey, QStringList() << QLatin1String("Friends"));
+    mContactList[bob].insert(subscribeKey, static_cast<uint>(SubscriptionStateAsk));
+    mContactList[bob].insert(groupsKey, QStringList() << QLatin1String("Work"));
+
+    const QStringList interfaces = QStringList()
+        << TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_LIST
+        << TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_GROUPS;
+
+    // Each interface caches the whole list in one go, and only keeps its own attributes
+    Tp::ContactAttributesMap attributes = contactsIface->getContactAttributes(handles,
+            interfaces, &error);
+    QVERIFY(!error.isValid());
+    QCOMPARE(mGetContactListAttributesCalls, 2);
+    QCOMPARE(attributes[alice].value(subscribeKey).toUInt(), static_cast<uint>(SubscriptionStateYes));
+    QCOMPARE(attributes[alice].value(groupsKey).toStringList(),
+            QStringList() << QLatin1String("Friends"));
+    QCOMPARE(attributes[bob].value(subscribeKey).toUInt(), static_cast<uint>(SubscriptionStateAsk));
+    QCOMPARE(attributes[bob].value(groupsKey).toStringList(),
+            QStringList() << QLatin1String("Work"));
+
+    Tp::ContactAttributesMap listOnly = contactsIface->getContactAttributes(handles,
+            QStringList() << TP_QT_IFACE_CONNECTION_INTERFACE_CONTACT_LIST, &error);
+    QVERIFY(!error.isValid());
+    QVERIFY(!listOnly[alice].contains(groupsKey));
+    QCOMPARE(mGetContactListAttributesCalls, 2);
+
+    // Group changes only refresh the groups
+    mContactList[alice].insert(groupsKey, QStringList() << QLatin1String("Family"));
+    groupsIface->groupsChanged(Tp::UIntList() << alice, QStringList() << QLatin1String("Family"),
+            QStringList() << QLatin1String("Friends"));
+    attributes = contactsIface->getContactAttributes(handles, interfaces, &error);
+    QVERIFY(!error.isValid());
+    QCOMPARE(mGetContactListAttributesCalls, 3);
+    QCOMPARE(attributes[alice].value(groupsKey).toStringList(),
+            QStringList() << QLatin1String("Family"));
+
+    // Removing a contact from the list drops its cached groups too
+    mContactList.remove(bob);
+    Tp::HandleIdentifierMap removals;
+    removals.insert(bob, QLatin1String("bob"));
+    listIface->contactsChangedWithID(Tp::ContactSubscriptionMap(), Tp::HandleIdentifierMap(),
+            removals);
+    attributes = contactsIface->getContactAttributes(handles, interfaces, &error);
+    QVERIFY(!error.isValid());
+    QCOMPARE(mGetContactListAttributesCalls, 5);
+    QVERIFY(!attributes[bob].contains(subscribeKey));
+    QVERIFY(!attributes[bob].contains(groupsKey));
+    QCOMPARE(attributes[alice].value(groupsKey).toStringList(),
+            QStringList() << QLatin1String("Family"));
+}
+
+void TestBaseContactAttributes::testCallback()
+{
+    BaseConnectionPtr conn = BaseConnection::create(QLatin1String("testcm"),
+            QLatin1String("example"), QVariantMap());
+
+    BaseHandleRepositoryPtr repository = BaseHandleRepository::create(HandleTypeContact);
+    conn->setHandleRepository(repository);
+
+    BaseConnectionContactsInterfacePtr contactsIface = BaseConnectionContactsInterface::create();
+    contactsIface->setGetContactAttributesCallback(
+            memFun(this, &TestBaseContactAttributes::getContactAttributes));
+    BaseConnectionAliasingInterfacePtr aliasingIface = BaseConnectionAliasingInterface::create();
+    QVERIFY(conn->plugInterface(AbstractConnectionInterfacePtr::dynamicCast(contactsIface)));
+    QVERIFY(conn->plugInterface(AbstractConnectionInterfacePtr::dynamicCast(aliasingIface)));
+
+    uint alice = 1;
+    mAliases.insert(alice, QLatin1String("Alice"));
+    Tp::SimplePresence available = { ConnectionPresenceTypeAvailable,
+        QLatin1String("available"), QString() };
+
+    const QString aliasKey = TP_QT_IFACE_CONNECTION_INTERFACE_ALIASING + QLatin1String("/alias");
+    const QString presenceKey = TP_QT_IFACE_CONNECTION_INTERFACE_SIMPLE_PRESENCE + QLatin1String("/presence");
+    const QStringList interfaces = QStringList()
+        << TP_QT_IFACE_CONNECTION_INTERFACE_ALIASING
+        << TP_QT_IFACE_CONNECTION_INTERFACE_SIMPLE_PRESENCE;
+
+    // Nothing provides presences yet, so the callback is asked for them
+    DBusError error;
+    Tp::ContactAttributesMap attributes = contactsIface->getContactAttributes(
+            Tp::UIntList() << alice, interfaces, &error);
+    QVERIFY(!error.isValid());
+    QCOMPARE(mGetContactAttributesCalls, 1);
+    QCOMPARE(mGetContactAttributesInterfaces, interfaces);
+    QCOMPARE(qdbus_cast<Tp::SimplePresence>(attributes[alice].value(presenceKey)).status,
+            QString(QLatin1String("away")));
+
+    // Once SimplePresence is plugged, its attributes come from its cache and not from the callback
+    BaseConnectionSimplePresenceInterfacePtr presenceIface = BaseConnectionSimplePresenceInterface::create();
+    QVERIFY(conn->plugInterface(AbstractConnectionInterfacePtr::dynamicCast(presenceIface)));
+    Tp::SimpleContactPresences presences;
+    presences.insert(alice, available);
+    presenceIface->setPresences(presences);
+
+    attributes = contactsIface->getContactAttributes(Tp::UIntList() << alice, interfaces, &error);
+    QVERIFY(!error.isValid());
+    QCOMPARE(mGetContactAttributesCalls, 2);
+    QCOMPARE(mGetContactAttributesInterfaces,
+            QStringList() << TP_QT_IFACE_CONNECTION_INTERFACE_ALIASING);
+    QCOMPARE(attributes.size(), 1);
+    QCOMPARE(attributes[alice].value(TP_QT_IFACE_CONNECTION + QLatin1String("/contact-id")).toString(),
+            QString(QLatin1String("contact1")));
+    QCOMPARE(qdbus_cast<Tp::SimplePresence>(attributes[alice].value(presenceKey)).status,
+            QString(QLatin1String("available")));
+    QVERIFY(!attributes[alice].contains(aliasKey));
+
+    // The same goes for Aliasing once it has a getter
+    aliasingIface->setGetAliasesCallback(memFun(this, &TestBaseContactAttributes::getAliases));
+    attributes = contactsIface->getContactAttributes(Tp::UIntList() << alice, interfaces, &error);
+    QVERIFY(!error.isValid());
+    QCOMPARE(mGetContactAttributesCalls, 3);
+    QCOMPARE(mGetContactAttributesInterfaces, QStringList());
+    QCOMPARE(attributes[alice].value(aliasKey).toString(), QString(QLatin1String("Alice")));
+    QCOMPARE(mGetAliasesCalls, 1);
+}
+
+void TestBaseContactAttributes::cleanup()
+{
+    cleanupImpl();
+}
+
+void TestBaseContactAttributes::cleanupTestCase()
+{
+    cleanupTestCaseImpl();
+}
+
+QTEST_MAIN(TestBaseContactAttributes)
+#include "_gen/base-contact-attributes.cpp.moc.hpp"
@@ -373,10 +373,15 @@ private Q_SLOTS:
 
     void testConnectionCapability();
     void testContactCapability();
+    void testChannelsDetails();
     void testSendFile();
     void testSendFile_data();
     void testReceiveFile();
     void testReceiveFile_data();
+    void testReceiveFileThrottled();
+    void testReceiveFileThrottled_data();
+    void testReceiveLargeFile();
+    void testReceiveLargeFile_data();
 
     void cleanup();
     void cleanupTestCase();
@@ -388,6 +393,17 @@ private:
         return Tp::BaseConnection::create<Connection>(mConnectionManager->name(), mProtocol->name(), parameters);
     }
 
+    bool hasSvcChannel(const Tp::BaseChannelPtr &svcChannel)
+    {
+        Q_FOREACH (const Tp::ChannelDetails &details, svcChannel->connection()->channelsDetails()) {
+            if (details.channel.path() == svcChannel->objectPath()) {
+                return details.properties.value(TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType"))
+                    == svcChannel->channelType();
+            }
+        }
+        return false;
+    }
+
     int requestCloseCliChannel(Tp::ChannelPtr cliChannel)
     {
         Tp::PendingOperation *pendingChannelClose = cliChannel->requestClose();
@@ -482,6 +498,40 @@ void TestBaseFileTranfserChannel::testContactCapability()
     mCliContact = contacts.first();
 }
 
+void TestBaseFileTranfserChannel::testChannelsDetails()
+{
+    QVERIFY(!g_connection.isNull());
+    const int initialCount = g_connection->channelsDetails().count();
+
+    // Registered channels are listed while they are open
+    Tp::BaseChannelPtr svcChannel = Tp::BaseChannel::create(g_connection.data(),
+            TP_QT_IFACE_CHANNEL_TYPE_TEXT);
+    Tp::DBusError err;
+    QVERIFY(svcChannel->registerObject(&err));
+    g_connection->addChannel(svcChannel);
+    QCOMPARE(g_connection->channelsDetails().count(), initialCount + 1);
+    QVERIFY(hasSvcChannel(svcChannel));
+
+    svcChannel->close();
+    QCOMPARE(g_connection->channelsDetails().count(), initialCount);
+    QVERIFY(!hasSvcChannel(svcChannel));
+
+    // A channel added before being registered is listed with its object path once registered,
+    // and is still removed when it closes
+    svcChannel = Tp::BaseChannel::create(g_connection.data(), TP_QT_IFACE_CHANNEL_TYPE_TEXT);
+    g_connection->addChannel(svcChannel);
+    QCOMPARE(g_connection->channelsDetails().count(), initialCount + 1);
+
+    QVERIFY(svcChannel->registerObject(&err));
+    QVERIFY(!svcChannel->objectPath().isEmpty());
+    QVERIFY(hasSvcChannel(svcChannel));
+    QCOMPARE(g_connection->channelsDetails().count(), initialCount + 1);
+
+    svcChannel->close();
+    QCOMPARE(g_connection->channelsDetails().count(), initialCount);
+    QVERIFY(!hasSvcChannel(svcChannel));
+}
+
 void TestBaseFileTranfserChannel::testSendFile()
 {
     QFETCH(int, fileSize);
@@ -524,6 +574,7 @@ void TestBaseFileTranfserChannel::testSendFile()
 
     QCOMPARE(g_channel->channelType(), TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER);
     QVERIFY(g_channel->requested());
+    QVERIFY(hasSvcChannel(g_channel));
 
     Tp::BaseChannelFileTransferTypePtr svcTransferChannel = Tp::BaseChannelFileTransferTypePtr::dynamicCast(g_channel->interface(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER));
     QVERIFY(!svcTransferChannel.isNull());
@@ -536,6 +587,7 @@ void TestBaseFileTranfserChannel::testSendFile()
 
     if (cancelCondition == CancelBeforeAccept) {
         QCOMPARE(requestCloseCliChannel(cliTransferChannel), 0);
+        QVERIFY(!hasSvcChannel(g_channel));
 
         if (spySvcState.isEmpty()) {
             spySvcState.wait();
@@ -902,6 +954,173 @@ void TestBaseFileTranfserChannel::testReceiveFile_data()
     QTest::newRow("Cancel in the middle of the data") << 2048 << 0 << int(CancelBeforeComplete)<< true << false;
 }
 
+void TestBaseFileTranfserChannel::testReceiveFileThrottled()
+{
+    QFETCH(int, interval);
+    QFETCH(int, threshold);
+
+    static const int fileSize = 4096;
+    static const int chunkSize = 256;
+
+    QCOMPARE(mCliConnection->status(), Tp::ConnectionStatusConnected);
+    QVERIFY(!mCliContact.isNull());
+
+    const QByteArray fileContent = generateFileContent(fileSize);
+
+    Tp::FileTransferChannelCreationProperties fileTransferProperties(QLatin1String("file-transfer-test-throttled.txt"), c_fileContentType, fileContent.size());
+    Tp::BaseChannelPtr svcTransferBaseChannel = g_connection->receiveFile(fileTransferProperties, mCliContact->handle().first());
+    QVERIFY(!svcTransferBaseChannel.isNull());
+
+    Tp::IncomingFileTransferChannelPtr cliTransferChannel = Tp::IncomingFileTransferChannel::create(mCliConnection, svcTransferBaseChannel->objectPath(), svcTransferBaseChannel->immutableProperties());
+    Tp::PendingReady *pendingChannelReady = cliTransferChannel->becomeReady(Tp::IncomingFileTransferChannel::FeatureCore);
+    connect(pendingChannelReady, SIGNAL(finished(Tp::PendingOperation*)),
+            SLOT(expectSuccessfulCall(Tp::PendingOperation*)));
+    QCOMPARE(mLoop->exec(), 0);
+
+    Tp::BaseChannelFileTransferTypePtr svcTransferChannel = Tp::BaseChannelFileTransferTypePtr::dynamicCast(svcTransferBaseChannel->interface(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER));
+    QVERIFY(!svcTransferChannel.isNull());
+
+    QCOMPARE(svcTransferChannel->transferredBytesChangedInterval(), 0);
+    QCOMPARE(svcTransferChannel->transferredBytesChangedThreshold(), qulonglong(0));
+    svcTransferChannel->setTransferredBytesChangedInterval(interval);
+    svcTransferChannel->setTransferredBytesChangedThreshold(threshold);
+    QCOMPARE(svcTransferChannel->transferredBytesChangedInterval(), interval);
+    QCOMPARE(svcTransferChannel->transferredBytesChangedThreshold(), qulonglong(threshold));
+
+    Tp::IODevice cliInputDevice;
+    cliInputDevice.open(QIODevice::ReadWrite);
+
+    QSignalSpy spySvcState(svcTransferChannel.data(), SIGNAL(stateChanged(uint,uint)));
+
+    Tp::PendingOperation *acceptFileOperation = cliTransferChannel->acceptFile(0, &cliInputDevice);
+    connect(acceptFileOperation, SIGNAL(finished(Tp::PendingOperation*)),
+            SLOT(expectSuccessfulCall(Tp::PendingOperation*)));
+    QCOMPARE(mLoop->exec(), 0);
+
+    QTRY_COMPARE_WITH_TIMEOUT(uint(svcTransferChannel->state()), uint(Tp::FileTransferStateAccepted), c_defaultTimeout);
+
+    QSignalSpy spyClientTransferredBytes(cliTransferChannel.data(), SIGNAL(transferredBytesChanged(qulonglong)));
+
+    Tp::IODevice svcOutputDevice;
+    svcOutputDevice.open(QIODevice::ReadWrite);
+    svcTransferChannel->remoteProvideFile(&svcOutputDevice);
+
+    QTRY_COMPARE_WITH_TIMEOUT(uint(svcTransferChannel->state()), uint(Tp::FileTransferStateOpen), c_defaultTimeout);
+
+    // Feed the data in small chunks, each one reaching the client before the next is written
+    int writtenBytes = 0;
+    while (writtenBytes < fileSize) {
+        writtenBytes += svcOutputDevice.write(fileContent.mid(writtenBytes, chunkSize));
+        QTRY_COMPARE_WITH_TIMEOUT(int(svcTransferChannel->transferredBytes()), writtenBytes, c_defaultTimeout);
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(uint(cliTransferChannel->state()), uint(Tp::FileTransferStateCompleted), c_defaultTimeout);
+    QTRY_VERIFY_WITH_TIMEOUT(!spyClientTransferredBytes.isEmpty(), c_defaultTimeout);
+    QTRY_COMPARE_WITH_TIMEOUT(spyClientTransferredBytes.last().at(0).toInt(), fileSize, c_defaultTimeout);
+
+    // The final value is always signalled, the changes before it are coalesced
+    QVERIFY(spyClientTransferredBytes.count() < fileSize / chunkSize);
+    int previous = 0;
+    for (int i = 0; i < spyClientTransferredBytes.count(); ++i) {
+        int value = spyClientTransferredBytes.at(i).at(0).toInt();
+        QVERIFY(value > previous);
+        if (threshold && i > 0 && value != fileSize) {
+            QVERIFY(value - previous >= threshold);
+        }
+        previous = value;
+    }
+
+    if (interval) {
+        // Only the first change and the completed transfer fit in a long interval
+        QCOMPARE(spyClientTransferredBytes.count(), 2);
+        QCOMPARE(spyClientTransferredBytes.first().at(0).toInt(), chunkSize);
+    }
+
+    QCOMPARE(cliInputDevice.readAll(), fileContent);
+}
+
+void TestBaseFileTranfserChannel::testReceiveFileThrottled_data()
+{
+    QTest::addColumn<int>("interval");
+    QTest::addColumn<int>("threshold");
+
+    QTest::newRow("Interval")  << 60000 << 0;
+    QTest::newRow("Threshold") << 0     << 1024;
+}
+
+void TestBaseFileTranfserChannel::testReceiveLargeFile()
+{
+    QFETCH(bool, useRegularFile);
+
+    // Larger than the biggest transfer block and than the data allowed to be pending on the socket
+    static const int fileSize = 3 * 1024 * 1024 + 123;
+    static const int timeout = 10000;
+
+    QCOMPARE(mCliConnection->status(), Tp::ConnectionStatusConnected);
+    QVERIFY(!mCliContact.isNull());
+
+    const QByteArray fileContent = generateFileContent(fileSize);
+
+    Tp::FileTransferChannelCreationProperties fileTransferProperties(QLatin1String("file-transfer-test-large.txt"), c_fileContentType, fileContent.size());
+    Tp::BaseChannelPtr svcTransferBaseChannel = g_connection->receiveFile(fileTransferProperties, mCliContact->handle().first());
+    QVERIFY(!svcTransferBaseChannel.isNull());
+
+    Tp::IncomingFileTransferChannelPtr cliTransferChannel = Tp::IncomingFileTransferChannel::create(mCliConnection, svcTransferBaseChannel->objectPath(), svcTransferBaseChannel->immutableProperties());
+    Tp::PendingReady *pendingChannelReady = cliTransferChannel->becomeReady(Tp::IncomingFileTransferChannel::FeatureCore);
+    connect(pendingChannelReady, SIGNAL(finished(Tp::PendingOperation*)),
+            SLOT(expectSuccessfulCall(Tp::PendingOperation*)));
+    QCOMPARE(mLoop->exec(), 0);
+
+    Tp::BaseChannelFileTransferTypePtr svcTransferChannel = Tp::BaseChannelFileTransferTypePtr::dynamicCast(svcTransferBaseChannel->interface(TP_QT_IFACE_CHANNEL_TYPE_FILE_TRANSFER));
+    QVERIFY(!svcTransferChannel.isNull());
+
+    Tp::IODevice cliInputDevice;
+    cliInputDevice.open(QIODevice::ReadWrite);
+
+    Tp::PendingOperation *acceptFileOperation = cliTransferChannel->acceptFile(0, &cliInputDevice);
+    connect(acceptFileOperation, SIGNAL(finished(Tp::PendingOperation*)),
+            SLOT(expectSuccessfulCall(Tp::PendingOperation*)));
+    QCOMPARE(mLoop->exec(), 0);
+
+    QTRY_COMPARE_WITH_TIMEOUT(uint(svcTransferChannel->state()), uint(Tp::FileTransferStateAccepted), c_defaultTimeout);
+
+    QSignalSpy spyClientTransferredBytes(cliTransferChannel.data(), SIGNAL(transferredBytesChanged(qulonglong)));
+
+    // A regular file takes the sendfile() path where available, a buffer the adaptive buffer
+    QTemporaryFile svcOutputFile;
+    QBuffer svcOutputBuffer;
+    if (useRegularFile) {
+        svcOutputFile.setFileTemplate(QLatin1String("file-transfer-test-XXXXXX.txt"));
+        QVERIFY2(svcOutputFile.open(), "Unable to create a file for the test");
+        QCOMPARE(svcOutputFile.write(fileContent), qint64(fileSize));
+        QVERIFY(svcOutputFile.flush());
+        QVERIFY(svcOutputFile.seek(0));
+        svcTransferChannel->remoteProvideFile(&svcOutputFile);
+    } else {
+        svcOutputBuffer.setData(fileContent);
+        svcTransferChannel->remoteProvideFile(&svcOutputBuffer);
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(uint(svcTransferChannel->state()), uint(Tp::FileTransferStateCompleted), timeout);
+    QCOMPARE(int(svcTransferChannel->transferredBytes()), fileSize);
+
+    QTRY_COMPARE_WITH_TIMEOUT(uint(cliTransferChannel->state()), uint(Tp::FileTransferStateCompleted), timeout);
+    QTRY_VERIFY_WITH_TIMEOUT(!spyClientTransferredBytes.isEmpty(), timeout);
+    QTRY_COMPARE_WITH_TIMEOUT(spyClientTransferredBytes.last().at(0).toInt(), fileSize, timeout);
+
+    QByteArray cliData = cliInputDevice.readAll();
+    QCOMPARE(cliData.size(), fileSize);
+    QVERIFY(cliData == fileContent);
+}
+
+void TestBaseFileTranfserChannel::testReceiveLargeFile_data()
+{
+    QTest::addColumn<bool>("useRegularFile");
+
+    QTest::newRow("Regular file") << true;
+    QTest::newRow("Buffer")       << false;
+}
+
 void TestBaseFileTranfserChannel::cleanup()
 {
     cleanupImpl();
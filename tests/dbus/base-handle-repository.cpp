@@ -0,0 +1,179 @@
+#include <tests/lib/test.h>
+
+#include <TelepathyQt/BaseConnection>
+#include <TelepathyQt/BaseHandleRepository>
+#include <TelepathyQt/DBusError>
+
+using namespace Tp;
+
+class TestBaseHandleRepository : public Test
+{
+    Q_OBJECT
+public:
+    TestBaseHandleRepository(QObject *parent = nullptr)
+        : Test(parent), mNormalizeCalls(0)
+    { }
+
+private:
+    QString normalizeContact(const QString &contactId, Tp::DBusError *error);
+
+    int mNormalizeCalls;
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+
+    void testHandles();
+    void testConnection();
+    void testNormalizationCache();
+
+    void cleanup();
+    void cleanupTestCase();
+};
+
+QString TestBaseHandleRepository::normalizeContact(const QString &contactId,
+        Tp::DBusError *error)
+{
+    ++mNormalizeCalls;
+
+    if (contactId.contains(QLatin1Char(' '))) {
+        error->set(TP_QT_ERROR_INVALID_HANDLE, QLatin1String("Spaces are not allowed"));
+        return QString();
+    }
+
+    return contactId.toLower();
+}
+
+void TestBaseHandleRepository::initTestCase()
+{
+    initTestCaseImpl();
+}
+
+void TestBaseHandleRepository::init()
+{
+    initImpl();
+    mNormalizeCalls = 0;
+}
+
+void TestBaseHandleRepository::testHandles()
+{
+    BaseHandleRepositoryPtr repository = BaseHandleRepository::create(HandleTypeContact);
+    repository->setNormalizeCallback(memFun(this, &TestBaseHandleRepository::normalizeContact));
+    QCOMPARE(repository->handleType(), static_cast<uint>(HandleTypeContact));
+    QCOMPARE(repository->count(), 0);
+
+    DBusError error;
+    uint alice = repository->ensureHandle(QLatin1String("Alice"), &error);
+    QVERIFY(!error.isValid());
+    QVERIFY(alice != 0);
+    QVERIFY(repository->isValid(alice));
+    QCOMPARE(repository->identifier(alice), QString(QLatin1String("alice")));
+    QCOMPARE(repository->handle(QLatin1String("alice")), alice);
+    QCOMPARE(repository->handle(QLatin1String("Alice")), 0U);
+
+    // Identifiers which normalize to the same string share the handle, and repeated identifiers
+    // are not normalized again
+    Tp::UIntList handles = repository->ensureHandles(QStringList()
+            << QLatin1String("ALICE") << QLatin1String("Bob") << QLatin1String("Alice"), &error);
+    QVERIFY(!error.isValid());
+    QCOMPARE(handles.size(), 3);
+    QCOMPARE(handles[0], alice);
+    QCOMPARE(handles[2], alice);
+    QVERIFY(handles[1] != alice);
+    QCOMPARE(repository->count(), 2);
+    QCOMPARE(mNormalizeCalls, 3);
+
+    QStringList identifiers = repository->identifiers(handles, &error);
+    QVERIFY(!error.isValid());
+    QCOMPARE(identifiers, QStringList() << QLatin1String("alice") << QLatin1String("bob")
+            << QLatin1String("alice"));
+
+    // Invalid input fails the whole batch
+    handles = repository->ensureHandles(QStringList()
+            << QLatin1String("Carol") << QLatin1String("not valid"), &error);
+    QVERIFY(error.isValid());
+    QCOMPARE(error.name(), TP_QT_ERROR_INVALID_HANDLE);
+    QVERIFY(handles.isEmpty());
+
+    DBusError inspectError;
+    identifiers = repository->identifiers(Tp::UIntList() << alice << 12345, &inspectError);
+    QVERIFY(inspectError.isValid());
+    QCOMPARE(inspectError.name(), TP_QT_ERROR_INVALID_HANDLE);
+    QVERIFY(identifiers.isEmpty());
+    QVERIFY(!repository->isValid(0));
+}
+
+void TestBaseHandleRepository::testConnection()
+{
+    BaseConnectionPtr conn = BaseConnection::create(QLatin1String("testcm"),
+            QLatin1String("example"), QVariantMap());
+    QVERIFY(conn->handleRepository(HandleTypeContact).isNull());
+
+    // Without callbacks or repositories, handles can't be resolved
+    DBusError error;
+    conn->requestHandles(HandleTypeContact, QStringList() << QLatin1String("alice"), &error);
+    QCOMPARE(error.name(), TP_QT_ERROR_NOT_IMPLEMENTED);
+
+    BaseHandleRepositoryPtr repository = BaseHandleRepository::create(HandleTypeContact);
+    repository->setNormalizeCallback(memFun(this, &TestBaseHandleRepository::normalizeContact));
+    conn->setHandleRepository(repository);
+    QCOMPARE(conn->handleRepository(HandleTypeContact), repository);
+    QVERIFY(conn->handleRepository(HandleTypeRoom).isNull());
+
+    DBusError requestError;
+    Tp::UIntList handles = conn->requestHandles(HandleTypeContact,
+            QStringList() << QLatin1String("Alice") << QLatin1String("bob"), &requestError);
+    QVERIFY(!requestError.isValid());
+    QCOMPARE(handles.size(), 2);
+    QCOMPARE(handles[0], repository->handle(QLatin1String("alice")));
+
+    DBusError inspectError;
+    QCOMPARE(conn->inspectHandles(HandleTypeContact, handles, &inspectError),
+            QStringList() << QLatin1String("alice") << QLatin1String("bob"));
+    QVERIFY(!inspectError.isValid());
+
+    // Other handle types still go through the callbacks
+    DBusError roomError;
+    conn->inspectHandles(HandleTypeRoom, handles, &roomError);
+    QCOMPARE(roomError.name(), TP_QT_ERROR_NOT_IMPLEMENTED);
+}
+
+void TestBaseHandleRepository::testNormalizationCache()
+{
+    const int count = 100;
+    QStringList identifiers;
+    for (int i = 0; i < count; ++i) {
+        identifiers << QString(QLatin1String("Contact%1@example.com")).arg(i);
+    }
+
+    BaseHandleRepositoryPtr repository = BaseHandleRepository::create(HandleTypeContact);
+    repository->setNormalizeCallback(memFun(this, &TestBaseHandleRepository::normalizeContact));
+    repository->setNormalizationCacheSize(count);
+
+    // The second pass is served by the cache
+    DBusError error;
+    Tp::UIntList first = repository->ensureHandles(identifiers, &error);
+    QVERIFY(!error.isValid());
+    Tp::UIntList second = repository->ensureHandles(identifiers, &error);
+    QVERIFY(!error.isValid());
+    QCOMPARE(second, first);
+    QCOMPARE(repository->count(), count);
+    QCOMPARE(mNormalizeCalls, count);
+
+    QStringList inspected = repository->identifiers(second, &error);
+    QVERIFY(!error.isValid());
+    QCOMPARE(inspected.last(), identifiers.last().toLower());
+}
+
+void TestBaseHandleRepository::cleanup()
+{
+    cleanupImpl();
+}
+
+void TestBaseHandleRepository::cleanupTestCase()
+{
+    cleanupTestCaseImpl();
+}
+
+QTEST_MAIN(TestBaseHandleRepository)
+#include "_gen/base-handle-repository.cpp.moc.hpp"
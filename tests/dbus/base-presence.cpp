@@ -0,0 +1,262 @@
+#include <tests/lib/test.h>
+
+#include <TelepathyQt/BaseConnection>
+#include <TelepathyQt/Connection>
+#include <TelepathyQt/DBusError>
+
+using namespace Tp;
+
+class TestBasePresence : public Test
+{
+    Q_OBJECT
+public:
+    TestBasePresence(QObject *parent = nullptr)
+        : Test(parent), mServiceBus(QLatin1String("base-presence-service")),
+          mPresenceClient(nullptr), mChangesAtReply(-1)
+    { }
+
+protected Q_SLOTS:
+    void onPresencesChanged(const Tp::SimpleContactPresences &presences);
+    void onSetPresenceFinished(QDBusPendingCallWatcher *watcher);
+
+private:
+    uint setPresence(const QString &status, const QString &message, Tp::DBusError *error);
+    static Tp::SimplePresence presence(ConnectionPresenceType type, const QString &status);
+
+    QDBusConnection mServiceBus;
+    BaseConnectionPtr mConn;
+    BaseConnectionSimplePresenceInterfacePtr mPresenceIface;
+    Client::ConnectionInterfaceSimplePresenceInterface *mPresenceClient;
+    QList<Tp::SimpleContactPresences> mChanges;
+    int mChangesAtReply;
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+
+    void testChanges();
+    void testBatchSize();
+    void testLatency();
+    void testFlush();
+    void testSetPresence();
+
+    void cleanup();
+    void cleanupTestCase();
+};
+
+void TestBasePresence::onPresencesChanged(const Tp::SimpleContactPresences &presences)
+{
+    mChanges.append(presences);
+}
+
+void TestBasePresence::onSetPresenceFinished(QDBusPendingCallWatcher *watcher)
+{
+    QVERIFY(!watcher->isError());
+    mChangesAtReply = mChanges.size();
+    watcher->deleteLater();
+    mLoop->exit(0);
+}
+
+uint TestBasePresence::setPresence(const QString &status, const QString &message,
+        Tp::DBusError *error)
+{
+    Q_UNUSED(status)
+    Q_UNUSED(message)
+    Q_UNUSED(error)
+
+    return 1;
+}
+
+Tp::SimplePresence TestBasePresence::presence(ConnectionPresenceType type, const QString &status)
+{
+    Tp::SimplePresence presence = { static_cast<uint>(type), status, QString() };
+    return presence;
+}
+
+void TestBasePresence::initTestCase()
+{
+    initTestCaseImpl();
+
+    // Use a connection of its own for the service, so that its signals and method replies reach
+    // the client through the bus, in the order they are sent
+    mServiceBus = QDBusConnection::connectToBus(QDBusConnection::SessionBus,
+            QLatin1String("base-presence-service"));
+    QVERIFY(mServiceBus.isConnected());
+}
+
+void TestBasePresence::init()
+{
+    initImpl();
+
+    mConn = BaseConnection::create(QLatin1String("testcm"), QLatin1String("example"),
+            QVariantMap(), mServiceBus);
+
+    mPresenceIface = BaseConnectionSimplePresenceInterface::create();
+    Tp::SimpleStatusSpec available = { ConnectionPresenceTypeAvailable, true, true };
+    Tp::SimpleStatusSpec away = { ConnectionPresenceTypeAway, true, true };
+    Tp::SimpleStatusSpecMap statuses;
+    statuses.insert(QLatin1String("available"), available);
+    statuses.insert(QLatin1String("away"), away);
+    mPresenceIface->setStatuses(statuses);
+    mPresenceIface->setSetPresenceCallback(memFun(this, &TestBasePresence::setPresence));
+    QVERIFY(mConn->plugInterface(AbstractConnectionInterfacePtr::dynamicCast(mPresenceIface)));
+
+    DBusError error;
+    QVERIFY(mConn->registerObject(&error));
+    QVERIFY(!error.isValid());
+
+    mPresenceClient = new Client::ConnectionInterfaceSimplePresenceInterface(mConn->busName(),
+            mConn->objectPath(), this);
+    QVERIFY(connect(mPresenceClient,
+                SIGNAL(PresencesChanged(Tp::SimpleContactPresences)),
+                SLOT(onPresencesChanged(Tp::SimpleContactPresences))));
+
+    mChanges.clear();
+    mChangesAtReply = -1;
+}
+
+void TestBasePresence::testChanges()
+{
+    Tp::SimpleContactPresences presences;
+    presences.insert(2, presence(ConnectionPresenceTypeAvailable, QLatin1String("available")));
+    presences.insert(3, presence(ConnectionPresenceTypeAway, QLatin1String("away")));
+    mPresenceIface->setPresences(presences);
+    QTRY_COMPARE(mChanges.size(), 1);
+    QCOMPARE(mChanges[0], presences);
+
+    // Only contacts whose presence changed are signalled
+    presences[3] = presence(ConnectionPresenceTypeAvailable, QLatin1String("available"));
+    mPresenceIface->setPresences(presences);
+    QTRY_COMPARE(mChanges.size(), 2);
+    QCOMPARE(mChanges[1].keys(), Tp::UIntList() << 3);
+    QCOMPARE(mChanges[1].value(3).status, QString(QLatin1String("available")));
+
+    // Setting the same presences again doesn't signal anything
+    mPresenceIface->setPresences(presences);
+    QTest::qWait(100);
+    QCOMPARE(mChanges.size(), 2);
+
+    Tp::SimpleContactPresences current = mPresenceIface->getPresences(Tp::UIntList() << 2 << 3 << 4);
+    QCOMPARE(current.value(2).status, QString(QLatin1String("available")));
+    QCOMPARE(current.value(3).status, QString(QLatin1String("available")));
+    QCOMPARE(current.value(4).type, static_cast<uint>(ConnectionPresenceTypeUnknown));
+}
+
+void TestBasePresence::testBatchSize()
+{
+    mPresenceIface->setPresencesChangedBatchSize(2);
+    QCOMPARE(mPresenceIface->presencesChangedBatchSize(), 2);
+
+    Tp::SimpleContactPresences presences;
+    for (uint contact = 2; contact <= 6; ++contact) {
+        presences.insert(contact, presence(ConnectionPresenceTypeAvailable, QLatin1String("available")));
+    }
+    mPresenceIface->setPresences(presences);
+
+    QTRY_COMPARE(mChanges.size(), 3);
+    QCOMPARE(mChanges[0].keys(), Tp::UIntList() << 2 << 3);
+    QCOMPARE(mChanges[1].keys(), Tp::UIntList() << 4 << 5);
+    QCOMPARE(mChanges[2].keys(), Tp::UIntList() << 6);
+}
+
+void TestBasePresence::testLatency()
+{
+    mPresenceIface->setPresencesChangedLatency(200);
+    QCOMPARE(mPresenceIface->presencesChangedLatency(), 200);
+
+    // Changes in quick succession are merged, keeping the latest presence of each contact
+    Tp::SimpleContactPresences presences;
+    presences.insert(2, presence(ConnectionPresenceTypeAvailable, QLatin1String("available")));
+    mPresenceIface->setPresences(presences);
+    presences.clear();
+    presences.insert(2, presence(ConnectionPresenceTypeAway, QLatin1String("away")));
+    presences.insert(3, presence(ConnectionPresenceTypeAvailable, QLatin1String("available")));
+    mPresenceIface->setPresences(presences);
+    QCOMPARE(mChanges.size(), 0);
+
+    QTRY_COMPARE(mChanges.size(), 1);
+    QCOMPARE(mChanges[0], presences);
+
+    // A full batch doesn't wait for the latency to expire
+    mPresenceIface->setPresencesChangedLatency(10000);
+    mPresenceIface->setPresencesChangedBatchSize(2);
+    presences.clear();
+    presences.insert(4, presence(ConnectionPresenceTypeAvailable, QLatin1String("available")));
+    mPresenceIface->setPresences(presences);
+    QTest::qWait(100);
+    QCOMPARE(mChanges.size(), 1);
+
+    presences.clear();
+    presences.insert(5, presence(ConnectionPresenceTypeAvailable, QLatin1String("available")));
+    mPresenceIface->setPresences(presences);
+    QTRY_COMPARE(mChanges.size(), 2);
+    QCOMPARE(mChanges[1].keys(), Tp::UIntList() << 4 << 5);
+}
+
+void TestBasePresence::testFlush()
+{
+    mPresenceIface->setPresencesChangedLatency(10000);
+
+    Tp::SimpleContactPresences presences;
+    presences.insert(2, presence(ConnectionPresenceTypeAvailable, QLatin1String("available")));
+    mPresenceIface->setPresences(presences);
+    QTest::qWait(100);
+    QCOMPARE(mChanges.size(), 0);
+
+    mPresenceIface->flushPresencesChanged();
+    QTRY_COMPARE(mChanges.size(), 1);
+    QCOMPARE(mChanges[0], presences);
+
+    // Nothing left to flush
+    mPresenceIface->flushPresencesChanged();
+
+    // Going back to no latency signals what is pending right away
+    presences[2] = presence(ConnectionPresenceTypeAway, QLatin1String("away"));
+    mPresenceIface->setPresences(presences);
+    mPresenceIface->setPresencesChangedLatency(0);
+    QTRY_COMPARE(mChanges.size(), 2);
+    QCOMPARE(mChanges[1], presences);
+
+    QTest::qWait(100);
+    QCOMPARE(mChanges.size(), 2);
+}
+
+void TestBasePresence::testSetPresence()
+{
+    // The self presence change fills a whole batch, but must still only be signalled after
+    // SetPresence has returned
+    mPresenceIface->setPresencesChangedLatency(10000);
+    mPresenceIface->setPresencesChangedBatchSize(1);
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(
+            mPresenceClient->SetPresence(QLatin1String("away"), QString()), this);
+    connect(watcher,
+            SIGNAL(finished(QDBusPendingCallWatcher*)),
+            SLOT(onSetPresenceFinished(QDBusPendingCallWatcher*)));
+    QCOMPARE(mLoop->exec(), 0);
+    QCOMPARE(mChangesAtReply, 0);
+
+    QTRY_COMPARE(mChanges.size(), 1);
+    QCOMPARE(mChanges[0].keys(), Tp::UIntList() << 1);
+    QCOMPARE(mChanges[0].value(1).status, QString(QLatin1String("away")));
+}
+
+void TestBasePresence::cleanup()
+{
+    delete mPresenceClient;
+    mPresenceClient = nullptr;
+    mPresenceIface.reset();
+    mConn.reset();
+
+    cleanupImpl();
+}
+
+void TestBasePresence::cleanupTestCase()
+{
+    QDBusConnection::disconnectFromBus(QLatin1String("base-presence-service"));
+
+    cleanupTestCaseImpl();
+}
+
+QTEST_MAIN(TestBasePresence)
+#include "_gen/base-presence.cpp.moc.hpp"
@@ -0,0 +1,394 @@
+#include <tests/lib/test.h>
+
+#define TP_QT_ENABLE_LOWLEVEL_API
+
+#include <TelepathyQt/BaseConnectionManager>
+#include <TelepathyQt/BaseProtocol>
+#include <TelepathyQt/BaseConnection>
+#include <TelepathyQt/BaseChannel>
+
+#include <TelepathyQt/Connection>
+#include <TelepathyQt/ConnectionLowlevel>
+#include <TelepathyQt/ConnectionManager>
+#include <TelepathyQt/ConnectionManagerLowlevel>
+#include <TelepathyQt/DBusError>
+#include <TelepathyQt/PendingChannel>
+#include <TelepathyQt/PendingConnection>
+#include <TelepathyQt/PendingReady>
+#include <TelepathyQt/RoomListChannel>
+
+static const QString c_server(QLatin1String("conference.example.com"));
+
+Tp::RequestableChannelClass createRequestableChannelClassRoomList()
+{
+    Tp::RequestableChannelClass roomList;
+    roomList.fixedProperties[TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType")] = TP_QT_IFACE_CHANNEL_TYPE_ROOM_LIST;
+    roomList.fixedProperties[TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandleType")] = Tp::HandleTypeNone;
+    roomList.allowedProperties.append(TP_QT_IFACE_CHANNEL_TYPE_ROOM_LIST + QLatin1String(".Server"));
+    return roomList;
+}
+
+static const Tp::RequestableChannelClass c_requestableChannelClassRoomList = createRequestableChannelClassRoomList();
+
+static Tp::BaseChannelRoomListTypePtr g_roomList;
+static int g_stopListingCalls = 0;
+
+namespace TestRoomListCM // The namespace is needed to avoid class name collisions with other tests and examples
+{
+
+class Connection : public Tp::BaseConnection
+{
+    Q_OBJECT
+public:
+    Connection(const QDBusConnection &dbusConnection,
+            const QString &cmName, const QString &protocolName,
+            const QVariantMap &parameters) :
+        Tp::BaseConnection(dbusConnection, cmName, protocolName, parameters)
+    {
+        /* Connection.Interface.Contacts */
+        m_contactsIface = Tp::BaseConnectionContactsInterface::create();
+        m_contactsIface->setGetContactAttributesCallback(Tp::memFun(this, &Connection::getContactAttributes));
+        m_contactsIface->setContactAttributeInterfaces(QStringList() << TP_QT_IFACE_CONNECTION);
+        plugInterface(Tp::AbstractConnectionInterfacePtr::dynamicCast(m_contactsIface));
+
+        /* Connection.Interface.Requests */
+        m_requestsIface = Tp::BaseConnectionRequestsInterface::create(this);
+        m_requestsIface->requestableChannelClasses << c_requestableChannelClassRoomList;
+        plugInterface(Tp::AbstractConnectionInterfacePtr::dynamicCast(m_requestsIface));
+
+        setConnectCallback(Tp::memFun(this, &Connection::connectCB));
+        setCreateChannelCallback(Tp::memFun(this, &Connection::createChannelCB));
+        setInspectHandlesCallback(Tp::memFun(this, &Connection::inspectHandles));
+
+        setSelfContact(1, QLatin1String("selfContact"));
+    }
+    ~Connection() override { }
+
+protected:
+    void connectCB(Tp::DBusError *error)
+    {
+        Q_UNUSED(error)
+        setStatus(Tp::ConnectionStatusConnected, Tp::ConnectionStatusReasonRequested);
+    }
+
+    Tp::BaseChannelPtr createChannelCB(const QVariantMap &request, Tp::DBusError *error)
+    {
+        const QString channelType = request.value(TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType")).toString();
+        if (channelType != TP_QT_IFACE_CHANNEL_TYPE_ROOM_LIST) {
+            error->set(TP_QT_ERROR_INVALID_ARGUMENT, QLatin1String("Unexpected channel type"));
+            return Tp::BaseChannelPtr();
+        }
+
+        const QString server = request.value(TP_QT_IFACE_CHANNEL_TYPE_ROOM_LIST + QLatin1String(".Server")).toString();
+
+        Tp::BaseChannelPtr baseChannel = Tp::BaseChannel::create(this, channelType, Tp::HandleTypeNone, 0);
+        Tp::BaseChannelRoomListTypePtr roomListChannel = Tp::BaseChannelRoomListType::create(server);
+        roomListChannel->setListRoomsCallback(Tp::memFun(this, &Connection::listRooms));
+        roomListChannel->setStopListingCallback(Tp::memFun(this, &Connection::stopListing));
+        baseChannel->plugInterface(Tp::AbstractChannelInterfacePtr::dynamicCast(roomListChannel));
+
+        g_roomList = roomListChannel;
+
+        return baseChannel;
+    }
+
+    void listRooms(Tp::DBusError *error)
+    {
+        Q_UNUSED(error)
+        g_roomList->setListingRooms(true);
+    }
+
+    void stopListing(Tp::DBusError *error)
+    {
+        Q_UNUSED(error)
+        ++g_stopListingCalls;
+        g_roomList->setListingRooms(false);
+    }
+
+    QStringList inspectHandles(uint handleType, const Tp::UIntList &handles, Tp::DBusError *error)
+    {
+        if (handleType != Tp::HandleTypeContact || handles != (Tp::UIntList() << 1)) {
+            error->set(TP_QT_ERROR_INVALID_HANDLE, QLatin1String("Unknown handle"));
+            return QStringList();
+        }
+
+        return QStringList() << QLatin1String("selfContact");
+    }
+
+    Tp::ContactAttributesMap getContactAttributes(const Tp::UIntList &handles, const QStringList &interfaces, Tp::DBusError *error)
+    {
+        Q_UNUSED(interfaces)
+
+        Tp::ContactAttributesMap contactAttributes;
+        const QStringList identifiers = inspectHandles(Tp::HandleTypeContact, handles, error);
+        for (int i = 0; i < identifiers.size(); ++i) {
+            contactAttributes[handles[i]][TP_QT_IFACE_CONNECTION + QLatin1String("/contact-id")] = identifiers[i];
+        }
+
+        return contactAttributes;
+    }
+
+    Tp::BaseConnectionContactsInterfacePtr m_contactsIface;
+    Tp::BaseConnectionRequestsInterfacePtr m_requestsIface;
+};
+
+} // namespace TestRoomListCM
+
+using namespace TestRoomListCM;
+
+class TestBaseRoomList : public Test
+{
+    Q_OBJECT
+public:
+    TestBaseRoomList(QObject *parent = nullptr)
+        : Test(parent)
+    { }
+
+protected Q_SLOTS:
+    void onGotRooms(const Tp::RoomInfoList &rooms);
+    void onListingRoomsChanged(bool listing);
+
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+
+    void testConnect();
+    void testListRooms();
+
+    void cleanup();
+    void cleanupTestCase();
+
+private:
+    Tp::BaseConnectionPtr createConnectionCb(const QVariantMap &parameters, Tp::DBusError *error)
+    {
+        Q_UNUSED(error)
+        return Tp::BaseConnection::create<Connection>(mConnectionManager->name(), mProtocol->name(), parameters);
+    }
+
+    static Tp::RoomInfoList rooms(uint first, uint count);
+    Tp::UIntList gotRoomsSizes() const;
+
+    Tp::BaseProtocolPtr mProtocol;
+    Tp::BaseConnectionManagerPtr mConnectionManager;
+
+    Tp::ConnectionPtr mCliConnection;
+
+    QList<Tp::RoomInfoList> mGotRooms;
+    QList<bool> mListingRoomsChanges;
+};
+
+void TestBaseRoomList::onGotRooms(const Tp::RoomInfoList &rooms)
+{
+    mGotRooms.append(rooms);
+}
+
+void TestBaseRoomList::onListingRoomsChanged(bool listing)
+{
+    mListingRoomsChanges.append(listing);
+}
+
+Tp::RoomInfoList TestBaseRoomList::rooms(uint first, uint count)
+{
+    Tp::RoomInfoList rooms;
+    for (uint handle = first; handle < first + count; ++handle) {
+        Tp::RoomInfo room;
+        room.handle = handle;
+        room.channelType = TP_QT_IFACE_CHANNEL_TYPE_TEXT;
+        room.info.insert(QLatin1String("handle-name"), QString(QLatin1String("room%1")).arg(handle));
+        rooms.append(room);
+    }
+    return rooms;
+}
+
+Tp::UIntList TestBaseRoomList::gotRoomsSizes() const
+{
+    Tp::UIntList sizes;
+    foreach (const Tp::RoomInfoList &rooms, mGotRooms) {
+        sizes.append(rooms.size());
+    }
+    return sizes;
+}
+
+void TestBaseRoomList::initTestCase()
+{
+    initTestCaseImpl();
+
+    mProtocol = Tp::BaseProtocol::create(QLatin1String("AlphaProtocol"));
+    mProtocol->setRequestableChannelClasses(Tp::RequestableChannelClassSpecList() << c_requestableChannelClassRoomList);
+    mProtocol->setCreateConnectionCallback(Tp::memFun(this, &TestBaseRoomList::createConnectionCb));
+
+    mConnectionManager = Tp::BaseConnectionManager::create(QLatin1String("RoomListCM"));
+    mConnectionManager->addProtocol(mProtocol);
+
+    Tp::DBusError err;
+    QVERIFY(mConnectionManager->registerObject(&err));
+    QVERIFY(!err.isValid());
+    QVERIFY(mConnectionManager->isRegistered());
+}
+
+void TestBaseRoomList::init()
+{
+    initImpl();
+
+    mGotRooms.clear();
+    mListingRoomsChanges.clear();
+    g_stopListingCalls = 0;
+}
+
+void TestBaseRoomList::testConnect()
+{
+    Tp::ConnectionManagerPtr cliCM = Tp::ConnectionManager::create(mConnectionManager->name());
+    Tp::PendingReady *pr = cliCM->becomeReady(Tp::ConnectionManager::FeatureCore);
+    connect(pr, SIGNAL(finished(Tp::PendingOperation*)),
+            SLOT(expectSuccessfulCall(Tp::PendingOperation*)));
+    QCOMPARE(mLoop->exec(), 0);
+
+    Tp::PendingConnection *pendingConnection = cliCM->lowlevel()->requestConnection(mProtocol->name(), QVariantMap());
+    connect(pendingConnection, SIGNAL(finished(Tp::PendingOperation*)),
+            SLOT(expectSuccessfulCall(Tp::PendingOperation*)));
+    QCOMPARE(mLoop->exec(), 0);
+
+    mCliConnection = pendingConnection->connection();
+
+    Tp::PendingReady *pendingConnectionReady = mCliConnection->lowlevel()->requestConnect();
+    connect(pendingConnectionReady, SIGNAL(finished(Tp::PendingOperation*)),
+            SLOT(expectSuccessfulCall(Tp::PendingOperation*)));
+    QCOMPARE(mLoop->exec(), 0);
+
+    QCOMPARE(mCliConnection->status(), Tp::ConnectionStatusConnected);
+}
+
+void TestBaseRoomList::testListRooms()
+{
+    QCOMPARE(mCliConnection->status(), Tp::ConnectionStatusConnected);
+
+    QVariantMap request;
+    request[TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType")] = TP_QT_IFACE_CHANNEL_TYPE_ROOM_LIST;
+    request[TP_QT_IFACE_CHANNEL + QLatin1String(".TargetHandleType")] = uint(Tp::HandleTypeNone);
+    request[TP_QT_IFACE_CHANNEL_TYPE_ROOM_LIST + QLatin1String(".Server")] = c_server;
+
+    Tp::PendingChannel *pendingChannel = mCliConnection->lowlevel()->createChannel(request);
+    connect(pendingChannel, SIGNAL(finished(Tp::PendingOperation*)),
+            SLOT(expectSuccessfulCall(Tp::PendingOperation*)));
+    QCOMPARE(mLoop->exec(), 0);
+
+    Tp::RoomListChannelPtr cliChannel = Tp::RoomListChannelPtr::qObjectCast(pendingChannel->channel());
+    QVERIFY(cliChannel);
+    QVERIFY(!g_roomList.isNull());
+
+    Tp::PendingReady *pendingChannelReady = cliChannel->becomeReady(Tp::Channel::FeatureCore);
+    connect(pendingChannelReady, SIGNAL(finished(Tp::PendingOperation*)),
+            SLOT(expectSuccessfulCall(Tp::PendingOperation*)));
+    QCOMPARE(mLoop->exec(), 0);
+
+    QCOMPARE(cliChannel->server(), c_server);
+    QVERIFY(!cliChannel->isListingRooms());
+
+    QVERIFY(connect(cliChannel.data(),
+                SIGNAL(gotRooms(Tp::RoomInfoList)),
+                SLOT(onGotRooms(Tp::RoomInfoList))));
+    QVERIFY(connect(cliChannel.data(),
+                SIGNAL(listingRoomsChanged(bool)),
+                SLOT(onListingRoomsChanged(bool))));
+
+    QCOMPARE(g_roomList->gotRoomsChunkSize(), 256);
+    QCOMPARE(g_roomList->gotRoomsInterval(), 0);
+    g_roomList->setGotRoomsChunkSize(3);
+    g_roomList->setGotRoomsInterval(60000);
+    QCOMPARE(g_roomList->gotRoomsChunkSize(), 3);
+    QCOMPARE(g_roomList->gotRoomsInterval(), 60000);
+
+    connect(cliChannel->listRooms(), SIGNAL(finished(Tp::PendingOperation*)),
+            SLOT(expectSuccessfulCall(Tp::PendingOperation*)));
+    QCOMPARE(mLoop->exec(), 0);
+    QTRY_VERIFY(cliChannel->isListingRooms());
+    QCOMPARE(mListingRoomsChanges, QList<bool>() << true);
+
+    // Rooms which don't fill a chunk are held back
+    g_roomList->appendRooms(rooms(1, 2));
+    QTest::qWait(100);
+    QCOMPARE(mGotRooms.size(), 0);
+
+    // The pending chunk is completed first, then full chunks go out as soon as they are complete
+    g_roomList->appendRooms(rooms(3, 5));
+    QTRY_COMPARE(mGotRooms.size(), 2);
+    QCOMPARE(gotRoomsSizes(), Tp::UIntList() << 3 << 3);
+
+    // Finishing emits the remainder and ends the listing
+    g_roomList->finishRooms();
+    QTRY_COMPARE(mGotRooms.size(), 3);
+    QCOMPARE(gotRoomsSizes(), Tp::UIntList() << 3 << 3 << 1);
+    QTRY_VERIFY(!cliChannel->isListingRooms());
+    QCOMPARE(mListingRoomsChanges, QList<bool>() << true << false);
+
+    Tp::UIntList handles;
+    foreach (const Tp::RoomInfoList &chunk, mGotRooms) {
+        foreach (const Tp::RoomInfo &room, chunk) {
+            handles.append(room.handle);
+        }
+    }
+    QCOMPARE(handles, Tp::UIntList() << 1 << 2 << 3 << 4 << 5 << 6 << 7);
+    QCOMPARE(mGotRooms[0][0].info.value(QLatin1String("handle-name")).toString(),
+            QString(QLatin1String("room1")));
+
+    // Nothing left to emit
+    g_roomList->finishRooms();
+    QTest::qWait(100);
+    QCOMPARE(mGotRooms.size(), 3);
+    mGotRooms.clear();
+
+    // Held back rooms are emitted once the interval expires
+    g_roomList->setGotRoomsInterval(0);
+    g_roomList->appendRooms(rooms(8, 1));
+    QTRY_COMPARE(mGotRooms.size(), 1);
+    QCOMPARE(gotRoomsSizes(), Tp::UIntList() << 1);
+    mGotRooms.clear();
+
+    // Shrinking the chunk size emits the chunks it completes
+    g_roomList->setGotRoomsInterval(60000);
+    g_roomList->setGotRoomsChunkSize(10);
+    g_roomList->appendRooms(rooms(9, 5));
+    QTest::qWait(100);
+    QCOMPARE(mGotRooms.size(), 0);
+    g_roomList->setGotRoomsChunkSize(2);
+    QTRY_COMPARE(mGotRooms.size(), 2);
+    QCOMPARE(gotRoomsSizes(), Tp::UIntList() << 2 << 2);
+    g_roomList->finishRooms();
+    QTRY_COMPARE(mGotRooms.size(), 3);
+    QCOMPARE(gotRoomsSizes(), Tp::UIntList() << 2 << 2 << 1);
+    mGotRooms.clear();
+
+    // gotRooms() emits what it is given as it is
+    g_roomList->gotRooms(rooms(20, 5));
+    QTRY_COMPARE(mGotRooms.size(), 1);
+    QCOMPARE(gotRoomsSizes(), Tp::UIntList() << 5);
+
+    // Stopping a listing goes to the connection manager
+    connect(cliChannel->listRooms(), SIGNAL(finished(Tp::PendingOperation*)),
+            SLOT(expectSuccessfulCall(Tp::PendingOperation*)));
+    QCOMPARE(mLoop->exec(), 0);
+    QTRY_VERIFY(cliChannel->isListingRooms());
+
+    connect(cliChannel->stopListing(), SIGNAL(finished(Tp::PendingOperation*)),
+            SLOT(expectSuccessfulCall(Tp::PendingOperation*)));
+    QCOMPARE(mLoop->exec(), 0);
+    QCOMPARE(g_stopListingCalls, 1);
+    QTRY_VERIFY(!cliChannel->isListingRooms());
+    QCOMPARE(mListingRoomsChanges, QList<bool>() << true << false << true << false);
+}
+
+void TestBaseRoomList::cleanup()
+{
+    cleanupImpl();
+}
+
+void TestBaseRoomList::cleanupTestCase()
+{
+    g_roomList.reset();
+    mCliConnection.reset();
+
+    cleanupTestCaseImpl();
+}
+
+QTEST_MAIN(TestBaseRoomList)
+#include "_gen/base-roomlist.cpp.moc.hpp"
@@ -13,6 +13,26 @@
 
 using namespace Tp;
 
+class InvalidatableChannel : public Channel
+{
+public:
+    static SharedPtr<InvalidatableChannel> create(const ConnectionPtr &connection,
+            const QString &objectPath, const QVariantMap &immutableProperties)
+    {
+        return SharedPtr<InvalidatableChannel>(new InvalidatableChannel(connection, objectPath,
+                    immutableProperties));
+    }
+
+    using Channel::invalidate;
+
+private:
+    InvalidatableChannel(const ConnectionPtr &connection, const QString &objectPath,
+            const QVariantMap &immutableProperties)
+        : Channel(connection, objectPath, immutableProperties, Channel::FeatureCore)
+    {
+    }
+};
+
 class TestConferenceChan : public Test
 {
     Q_OBJECT
@@ -34,6 +54,8 @@ private Q_SLOTS:
     void init();
 
     void testConference();
+    void testPrefetchedProperties();
+    void testPrefetchedPropertiesInvalidated();
 
     void cleanup();
     void cleanupTestCase();
@@ -252,6 +274,66 @@ void TestConferenceChan::testConference()
     mChannelMerged.reset();
 }
 
+void TestConferenceChan::testPrefetchedProperties()
+{
+    // Listing the interfaces up front makes the Group and Conference properties get fetched
+    // while the connection is still being made ready
+    QVariantMap immutableProperties;
+    immutableProperties.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".Interfaces"),
+            QStringList() << TP_QT_IFACE_CHANNEL_INTERFACE_GROUP
+                          << TP_QT_IFACE_CHANNEL_INTERFACE_CONFERENCE);
+    mChan = Channel::create(mConn->client(), mConferenceChanPath, immutableProperties);
+
+    QVERIFY(connect(mChan->becomeReady(),
+                    SIGNAL(finished(Tp::PendingOperation*)),
+                    SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+    QCOMPARE(mChan->isReady(), true);
+    QCOMPARE(mChan->isConference(), true);
+    QVERIFY(!mChan->groupSelfContact().isNull());
+
+    QSet<QString> expectedObjectPaths;
+    expectedObjectPaths << mTextChan1Path << mTextChan2Path;
+    QSet<QString> objectPaths;
+    Q_FOREACH (const ChannelPtr &channel, mChan->conferenceChannels()) {
+        objectPaths << channel->objectPath();
+    }
+    QCOMPARE(expectedObjectPaths, objectPaths);
+
+    // The replies are freed once they have been used
+    QTRY_VERIFY(mChan->findChildren<QDBusPendingCallWatcher*>().isEmpty());
+
+    mChan.reset();
+}
+
+void TestConferenceChan::testPrefetchedPropertiesInvalidated()
+{
+    QVariantMap immutableProperties;
+    immutableProperties.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".Interfaces"),
+            QStringList() << TP_QT_IFACE_CHANNEL_INTERFACE_GROUP
+                          << TP_QT_IFACE_CHANNEL_INTERFACE_CONFERENCE);
+    SharedPtr<InvalidatableChannel> chan = InvalidatableChannel::create(mConn->client(),
+            mConferenceChanPath, immutableProperties);
+
+    PendingOperation *op = chan->becomeReady();
+    while (chan->findChildren<QDBusPendingCallWatcher*>().isEmpty()) {
+        mLoop->processEvents();
+    }
+
+    // Fail introspection while the prefetched replies are still outstanding
+    chan->invalidate(TP_QT_ERROR_CANCELLED, QLatin1String("Invalidated mid-introspection"));
+
+    QVERIFY(connect(op,
+                    SIGNAL(finished(Tp::PendingOperation*)),
+                    SLOT(expectFailure(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+    QCOMPARE(mLastError, TP_QT_ERROR_CANCELLED);
+    QVERIFY(!chan->isReady());
+
+    // None of the replies are kept around until the channel goes away
+    QTRY_VERIFY(chan->findChildren<QDBusPendingCallWatcher*>().isEmpty());
+}
+
 void TestConferenceChan::cleanup()
 {
     cleanupImpl();
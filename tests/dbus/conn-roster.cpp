@@ -10,6 +10,7 @@
 #include <TelepathyQt/ContactFactory>
 #include <TelepathyQt/ContactManager>
 #include <TelepathyQt/PendingContacts>
+#include <TelepathyQt/PendingReady>
 
 #include <telepathy-glib/debug.h>
 
@@ -41,6 +42,7 @@ private Q_SLOTS:
     void init();
 
     void testRoster();
+    void testRosterLoad();
 
     void cleanup();
     void cleanupTestCase();
@@ -479,6 +481,43 @@ void TestConnRoster::testRoster()
     }
 }
 
+void TestConnRoster::testRosterLoad()
+{
+    ContactManagerPtr contactManager = mConn->client()->contactManager();
+    QCOMPARE(contactManager->state(), ContactListStateSuccess);
+
+    // Introspect the roster from scratch through a new proxy and check the contact attributes
+    // decode to the same state the first proxy tracked
+    ConnectionPtr conn = Connection::create(mConn->client()->busName(),
+            mConn->client()->objectPath(),
+            ChannelFactory::create(QDBusConnection::sessionBus()),
+            ContactFactory::create(Contact::FeatureAlias));
+    QVERIFY(connect(conn->becomeReady(Features() << Connection::FeatureRoster),
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+    QCOMPARE(conn->contactManager()->state(), ContactListStateSuccess);
+
+    QHash<QString, ContactPtr> known;
+    Q_FOREACH (const ContactPtr &contact, contactManager->allKnownContacts()) {
+        known.insert(contact->id(), contact);
+    }
+
+    Contacts loaded = conn->contactManager()->allKnownContacts();
+    QCOMPARE(loaded.size(), known.size());
+    Q_FOREACH (const ContactPtr &contact, loaded) {
+        QVERIFY(known.contains(contact->id()));
+        ContactPtr expected = known.value(contact->id());
+        QVERIFY(contact->actualFeatures().contains(Contact::FeatureAlias));
+        QCOMPARE(contact->alias(), expected->alias());
+        QCOMPARE(static_cast<uint>(contact->subscriptionState()),
+                 static_cast<uint>(expected->subscriptionState()));
+        QCOMPARE(static_cast<uint>(contact->publishState()),
+                 static_cast<uint>(expected->publishState()));
+        QCOMPARE(contact->isBlocked(), expected->isBlocked());
+    }
+}
+
 void TestConnRoster::cleanup()
 {
     cleanupImpl();
@@ -13,6 +13,8 @@
 #include <TelepathyQt/Contact>
 #include <TelepathyQt/ContactFactory>
 #include <TelepathyQt/ContactManager>
+#include <TelepathyQt/PendingBatchedContacts>
+#include <TelepathyQt/PendingComposite>
 #include <TelepathyQt/PendingContacts>
 #include <TelepathyQt/PendingVoid>
 #include <TelepathyQt/PendingReady>
@@ -51,7 +53,10 @@ private Q_SLOTS:
     void testSupport();
     void testSelfContact();
     void testForHandles();
+    void testForHandlesSharedInFlight();
+    void testContactCache();
     void testForIdentifiers();
+    void testForIdentifiersInBatches();
     void testFeatures();
     void testFeaturesNotRequested();
     void testUpgrade();
@@ -335,6 +340,108 @@ void TestContacts::testForHandles()
     processDBusQueue(mConn.data());
 }
 
+void TestContacts::testForHandlesSharedInFlight()
+{
+    Tp::UIntList handles;
+    TpHandleRepoIface *serviceRepo =
+        tp_base_connection_get_handles(TP_BASE_CONNECTION(mConnService), TP_HANDLE_TYPE_CONTACT);
+
+    handles << tp_handle_ensure(serviceRepo, "dora", nullptr, nullptr);
+    handles << tp_handle_ensure(serviceRepo, "eve", nullptr, nullptr);
+    handles << tp_handle_ensure(serviceRepo, "frank", nullptr, nullptr);
+
+    ContactManagerPtr manager = mConn->contactManager();
+    uint hits = manager->inFlightAttributesHits();
+    uint misses = manager->inFlightAttributesMisses();
+
+    // The second request overlaps the first one before it has replied, so it should be served by
+    // the same GetContactAttributes call
+    PendingContacts *first = manager->contactsForHandles(handles);
+    PendingContacts *second = manager->contactsForHandles(handles.mid(1));
+    QCOMPARE(manager->inFlightAttributesMisses() - misses, 3U);
+    QCOMPARE(manager->inFlightAttributesHits() - hits, 2U);
+
+    QVERIFY(connect(new PendingComposite(QList<PendingOperation*>() << first << second, mConn),
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+
+    // Once the call has landed, nothing is shared anymore
+    hits = manager->inFlightAttributesHits();
+    QVERIFY(connect(manager->contactsForHandles(handles, Contact::FeatureAlias),
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectPendingContactsFinished(Tp::PendingOperation*))));
+    QCOMPARE(manager->inFlightAttributesHits(), hits);
+    QCOMPARE(mLoop->exec(), 0);
+    QCOMPARE(mContacts.size(), 3);
+    QCOMPARE(mContacts[0]->id(), QString(QLatin1String("dora")));
+
+    mContacts.clear();
+    mLoop->processEvents();
+    processDBusQueue(mConn.data());
+}
+
+void TestContacts::testContactCache()
+{
+    Tp::UIntList handles;
+    TpHandleRepoIface *serviceRepo =
+        tp_base_connection_get_handles(TP_BASE_CONNECTION(mConnService), TP_HANDLE_TYPE_CONTACT);
+
+    handles << tp_handle_ensure(serviceRepo, "gina", nullptr, nullptr);
+    handles << tp_handle_ensure(serviceRepo, "harry", nullptr, nullptr);
+    handles << tp_handle_ensure(serviceRepo, "irene", nullptr, nullptr);
+
+    ContactManagerPtr manager = mConn->contactManager();
+    QCOMPARE(manager->contactCacheSize(), 0);
+    manager->setContactCacheSize(2);
+
+    QVERIFY(connect(manager->contactsForHandles(handles, Contact::FeatureAlias),
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectPendingContactsFinished(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+    QCOMPARE(mContacts.size(), 3);
+
+    // Pin the first contact, then drop all our references; only the two most recently used
+    // unpinned contacts fit in the cache, and the pinned one survives regardless
+    WeakPtr<Contact> gina(mContacts[0]);
+    WeakPtr<Contact> harry(mContacts[1]);
+    WeakPtr<Contact> irene(mContacts[2]);
+    manager->pinContacts(QList<ContactPtr>() << mContacts[0]);
+    mContacts.clear();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    QVERIFY(!ContactPtr(gina).isNull());
+    QVERIFY(!ContactPtr(harry).isNull());
+    QVERIFY(!ContactPtr(irene).isNull());
+
+    // Requesting them again is served from the cache without any D-Bus call
+    uint hits = manager->contactCacheHits();
+    uint misses = manager->contactCacheMisses();
+    QVERIFY(connect(manager->contactsForHandles(handles, Contact::FeatureAlias),
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectPendingContactsFinished(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+    QCOMPARE(manager->contactCacheHits() - hits, 3U);
+    QCOMPARE(manager->contactCacheMisses(), misses);
+    QCOMPARE(mContacts[1]->id(), QString(QLatin1String("harry")));
+    mContacts.clear();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+
+    // Shrinking the cache evicts the least recently used contact, and unpinning puts the
+    // pinned contact back under the cache policy as the most recently used one
+    manager->setContactCacheSize(1);
+    QVERIFY(ContactPtr(harry).isNull());
+    QVERIFY(!ContactPtr(irene).isNull());
+    manager->unpinContacts(QList<ContactPtr>() << ContactPtr(gina));
+    QVERIFY(!ContactPtr(gina).isNull());
+    QVERIFY(ContactPtr(irene).isNull());
+
+    manager->setContactCacheSize(0);
+    QVERIFY(ContactPtr(gina).isNull());
+
+    mLoop->processEvents();
+    processDBusQueue(mConn.data());
+}
+
 void TestContacts::testForIdentifiers()
 {
     QStringList validIDs = QStringList() << QLatin1String("Alice")
@@ -413,6 +520,58 @@ void TestContacts::testForIdentifiers()
     processDBusQueue(mConn.data());
 }
 
+void TestContacts::testForIdentifiersInBatches()
+{
+    QStringList validIDs = QStringList() << QLatin1String("Alice")
+        << QLatin1String("Bob") << QLatin1String("Chris") << QLatin1String("Dora")
+        << QLatin1String("Eve");
+    QStringList invalidIDs = QStringList() << QLatin1String("Not valid")
+        << QLatin1String("Not valid either");
+
+    // 7 identifiers in batches of 2, with at most 2 batches in flight
+    PendingBatchedContacts *pending = mConn->contactManager()->contactsForIdentifiersInBatches(
+            validIDs.mid(0, 2) + invalidIDs + validIDs.mid(2), Features(), 2, 2);
+    QSignalSpy spy(pending, SIGNAL(contactsRetrieved(QList<Tp::ContactPtr>)));
+
+    QVERIFY(pending->isForIdentifiers());
+    QCOMPARE(pending->batchSize(), 2);
+    QCOMPARE(pending->maxBatchesInFlight(), 2);
+    QCOMPARE(pending->batchCount(), 4);
+
+    QVERIFY(connect(pending,
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectPendingContactsFinished(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+
+    QCOMPARE(spy.count(), 4);
+    QCOMPARE(pending->finishedBatchCount(), 4);
+
+    // Results are merged back in request order
+    QCOMPARE(pending->validIdentifiers(), validIDs);
+    QStringList toCheck = pending->invalidIdentifiers().keys();
+    toCheck.sort();
+    invalidIDs.sort();
+    QCOMPARE(toCheck, invalidIDs);
+
+    QCOMPARE(mContacts.size(), 5);
+    for (int i = 0; i < mContacts.size(); i++) {
+        QCOMPARE(mContacts[i]->id(), validIDs[i].toLower());
+    }
+
+    // An empty request succeeds right away, without any batch
+    pending = mConn->contactManager()->contactsForIdentifiersInBatches(QStringList());
+    QCOMPARE(pending->batchCount(), 0);
+    QVERIFY(connect(pending,
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectPendingContactsFinished(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+    QVERIFY(mContacts.isEmpty());
+
+    mContacts.clear();
+    mLoop->processEvents();
+    processDBusQueue(mConn.data());
+}
+
 void TestContacts::testFeatures()
 {
     QStringList ids = QStringList() << QLatin1String("alice")
@@ -8,11 +8,15 @@
 #include <QString>
 #include <QVariantMap>
 
+#include <TelepathyQt/Account>
+#include <TelepathyQt/AccountFactory>
 #include <TelepathyQt/Connection>
 #include <TelepathyQt/ConnectionFactory>
 #include <TelepathyQt/ContactFactory>
+#include <TelepathyQt/Channel>
 #include <TelepathyQt/ChannelFactory>
 #include <TelepathyQt/Debug>
+#include <TelepathyQt/PendingProxies>
 #include <TelepathyQt/PendingReady>
 #include <TelepathyQt/Types>
 
@@ -24,10 +28,55 @@
 #include <dbus/dbus-glib.h>
 
 #include <tests/lib/glib/contacts-conn.h>
+#include <tests/lib/glib/echo/chan.h>
+#include <tests/lib/glib-helpers/test-conn-helper.h>
 #include <tests/lib/test.h>
 
 using namespace Tp;
 
+// A minimal Account implementation, with just enough for Account::FeatureCore to become ready
+class AccountAdaptor : public QDBusAbstractAdaptor
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.freedesktop.Telepathy.Account")
+    Q_CLASSINFO("D-Bus Introspection", ""
+"  <interface name=\"org.freedesktop.Telepathy.Account\" >\n"
+"    <property name=\"Interfaces\" type=\"as\" access=\"read\" />\n"
+"    <property name=\"Connection\" type=\"o\" access=\"read\" />\n"
+"    <signal name=\"AccountPropertyChanged\" >\n"
+"      <arg name=\"Properties\" type=\"a{sv}\" />\n"
+"    </signal>\n"
+"  </interface>\n"
+        "")
+
+    Q_PROPERTY(QDBusObjectPath Connection READ Connection)
+    Q_PROPERTY(QStringList Interfaces READ Interfaces)
+
+public:
+    AccountAdaptor(QObject *parent)
+        : QDBusAbstractAdaptor(parent)
+    {
+    }
+
+    ~AccountAdaptor() override
+    {
+    }
+
+public: // Properties
+    inline QDBusObjectPath Connection() const
+    {
+        return QDBusObjectPath(QLatin1String("/"));
+    }
+
+    inline QStringList Interfaces() const
+    {
+        return QStringList();
+    }
+
+Q_SIGNALS: // Signals
+    void AccountPropertyChanged(const QVariantMap &properties);
+};
+
 class TestDBusProxyFactory : public Test
 {
     Q_OBJECT
@@ -49,6 +98,8 @@ private Q_SLOTS:
     void testDropRefs();
     void testInvalidate();
     void testBogusService();
+    void testProxies();
+    void testAccountProxies();
 
     void cleanup();
     void cleanupTestCase();
@@ -335,6 +386,170 @@ void TestDBusProxyFactory::testBogusService()
     QCOMPARE(mLoop->exec(), 0);
 }
 
+void TestDBusProxyFactory::testProxies()
+{
+    TestConnHelper conn(this,
+            TP_TESTS_TYPE_CONTACTS_CONNECTION,
+            "account", "me3@example.com",
+            "protocol", "simple",
+            NULL);
+    QCOMPARE(conn.connect(), true);
+
+    TpHandleRepoIface *contactRepo = tp_base_connection_get_handles(
+            TP_BASE_CONNECTION(conn.service()), TP_HANDLE_TYPE_CONTACT);
+    guint handle = tp_handle_ensure(contactRepo, "someone@localhost", nullptr, nullptr);
+
+    // create the Channels by magic, rather than doing D-Bus round-trips for them
+    QList<ExampleEchoChannel*> chanServices;
+    ChannelDetailsList channels;
+    for (int i = 0; i < 3; ++i) {
+        QString chanPath = conn.objectPath() + QString(QLatin1String("/TextChannel%1")).arg(i);
+        QByteArray chanPathLatin1(chanPath.toLatin1());
+        chanServices.append(EXAMPLE_ECHO_CHANNEL(g_object_new(
+                        EXAMPLE_TYPE_ECHO_CHANNEL,
+                        "connection", conn.service(),
+                        "object-path", chanPathLatin1.data(),
+                        "handle", handle,
+                        NULL)));
+        ChannelDetails details = { QDBusObjectPath(chanPath), QVariantMap() };
+        channels.append(details);
+    }
+
+    ChannelFactoryPtr chanFactory = ChannelFactory::create(QDBusConnection::sessionBus());
+    PendingReady *single = chanFactory->proxy(conn.client(), channels[1].channel.path(),
+            QVariantMap());
+    QVERIFY(!single->proxy().isNull());
+
+    // The proxies are available straight away, in order, and reuse the cached ones
+    PendingProxies *bulk = chanFactory->proxies(conn.client(), channels);
+    QVERIFY(bulk != nullptr);
+    QList<DBusProxyPtr> proxies = bulk->proxies();
+    QCOMPARE(proxies.size(), channels.size());
+    for (int i = 0; i < proxies.size(); ++i) {
+        QVERIFY(!proxies[i].isNull());
+        QCOMPARE(proxies[i]->objectPath(), channels[i].channel.path());
+    }
+    QCOMPARE(proxies[1].data(), single->proxy().data());
+
+    QVERIFY(connect(bulk, SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+    Q_FOREACH (const DBusProxyPtr &proxy, proxies) {
+        QVERIFY(ChannelPtr::qObjectCast(proxy)->isReady());
+    }
+
+    // Later requests are served from the cache
+    PendingReady *again = chanFactory->proxy(conn.client(), channels[2].channel.path(),
+            QVariantMap());
+    QCOMPARE(again->proxy().data(), proxies[2].data());
+
+    // A channel listed twice in one call gets a single proxy, as with two proxy() calls
+    ChannelFactoryPtr freshChanFactory = ChannelFactory::create(QDBusConnection::sessionBus());
+    PendingProxies *duplicates = freshChanFactory->proxies(conn.client(),
+            ChannelDetailsList() << channels[0] << channels[0] << channels[2]);
+    QCOMPARE(duplicates->proxies().size(), 3);
+    QCOMPARE(duplicates->proxies()[1].data(), duplicates->proxies()[0].data());
+    QVERIFY(duplicates->proxies()[2].data() != duplicates->proxies()[0].data());
+    QVERIFY(connect(duplicates, SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+
+    PendingProxies *empty = chanFactory->proxies(conn.client(), ChannelDetailsList());
+    QVERIFY(empty->proxies().isEmpty());
+    QVERIFY(connect(empty, SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+
+    proxies.clear();
+    Q_FOREACH (ExampleEchoChannel *chanService, chanServices) {
+        g_object_unref(chanService);
+    }
+    QCOMPARE(conn.disconnect(), true);
+}
+
+void TestDBusProxyFactory::testAccountProxies()
+{
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    QVERIFY(bus.registerService(TP_QT_ACCOUNT_MANAGER_BUS_NAME));
+
+    QStringList accountPaths;
+    for (int i = 0; i < 3; ++i) {
+        QString path = QString(QLatin1String(
+                    "/org/freedesktop/Telepathy/Account/simple/simple/account%1")).arg(i);
+        QObject *object = new QObject(this);
+        new AccountAdaptor(object);
+        QVERIFY(bus.registerObject(path, object));
+        accountPaths.append(path);
+    }
+
+    AccountFactoryPtr accFactory = AccountFactory::create(bus, Account::FeatureCore);
+    ConnectionFactoryPtr connFactory = ConnectionFactory::create(bus);
+    ChannelFactoryPtr chanFactory = ChannelFactory::create(bus);
+    ContactFactoryPtr contactFactory = ContactFactory::create();
+
+    PendingReady *single = accFactory->proxy(TP_QT_ACCOUNT_MANAGER_BUS_NAME, accountPaths[1],
+            connFactory, chanFactory, contactFactory);
+    QVERIFY(!single->proxy().isNull());
+
+    // The proxies are available straight away, in order, and reuse the cached ones
+    PendingProxies *bulk = accFactory->proxies(TP_QT_ACCOUNT_MANAGER_BUS_NAME, accountPaths,
+            connFactory, chanFactory, contactFactory);
+    QVERIFY(bulk != nullptr);
+    QList<DBusProxyPtr> proxies = bulk->proxies();
+    QCOMPARE(proxies.size(), accountPaths.size());
+    for (int i = 0; i < proxies.size(); ++i) {
+        QVERIFY(!proxies[i].isNull());
+        QCOMPARE(proxies[i]->objectPath(), accountPaths[i]);
+    }
+    QCOMPARE(proxies[1].data(), single->proxy().data());
+
+    QVERIFY(connect(bulk, SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+    Q_FOREACH (const DBusProxyPtr &proxy, proxies) {
+        AccountPtr account = AccountPtr::qObjectCast(proxy);
+        QVERIFY(!account.isNull());
+        QVERIFY(account->isReady(Account::FeatureCore));
+        QCOMPARE(account->connectionFactory(), ConnectionFactoryConstPtr(connFactory));
+    }
+
+    // Later requests are served from the cache
+    PendingReady *again = accFactory->proxy(TP_QT_ACCOUNT_MANAGER_BUS_NAME, accountPaths[2],
+            connFactory, chanFactory, contactFactory);
+    QCOMPARE(again->proxy().data(), proxies[2].data());
+
+    // An account listed twice in one call gets a single proxy, as with two proxy() calls
+    AccountFactoryPtr freshAccFactory = AccountFactory::create(bus, Account::FeatureCore);
+    PendingProxies *duplicates = freshAccFactory->proxies(TP_QT_ACCOUNT_MANAGER_BUS_NAME,
+            QStringList() << accountPaths[0] << accountPaths[2] << accountPaths[0],
+            connFactory, chanFactory, contactFactory);
+    QCOMPARE(duplicates->proxies().size(), 3);
+    QCOMPARE(duplicates->proxies()[2].data(), duplicates->proxies()[0].data());
+    QVERIFY(duplicates->proxies()[1].data() != duplicates->proxies()[0].data());
+    QVERIFY(connect(duplicates, SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectSuccessfulCall(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+
+    // An account which doesn't exist makes the whole operation fail, but its proxy is still
+    // returned in its place
+    QStringList withBogus = accountPaths;
+    withBogus.insert(1, QLatin1String("/org/freedesktop/Telepathy/Account/simple/simple/bogus"));
+    PendingProxies *failing = accFactory->proxies(TP_QT_ACCOUNT_MANAGER_BUS_NAME, withBogus,
+            connFactory, chanFactory, contactFactory);
+    QCOMPARE(failing->proxies().size(), withBogus.size());
+    QCOMPARE(failing->proxies()[1]->objectPath(), withBogus[1]);
+    QCOMPARE(failing->proxies()[0].data(), proxies[0].data());
+    QVERIFY(connect(failing, SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(expectFailure(Tp::PendingOperation*))));
+    QCOMPARE(mLoop->exec(), 0);
+
+    proxies.clear();
+    Q_FOREACH (const QString &path, accountPaths) {
+        bus.unregisterObject(path);
+    }
+    QVERIFY(bus.unregisterService(TP_QT_ACCOUNT_MANAGER_BUS_NAME));
+}
+
 void TestDBusProxyFactory::cleanup()
 {
     mFactory.reset();
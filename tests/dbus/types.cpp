@@ -43,6 +43,25 @@ public: // Properties
         ret.insert(QLatin1String("saIPv4"), QVariant::fromValue(saIPv4));
         ret.insert(QLatin1String("saIPv6"), QVariant::fromValue(saIPv6));
 
+        ContactAttributesMap attributes;
+        for (uint handle = 1; handle <= 10; ++handle) {
+            QVariantMap contactAttributes;
+            contactAttributes.insert(TP_QT_IFACE_CONNECTION + QLatin1String("/contact-id"),
+                    QString(QLatin1String("contact%1@example.com")).arg(handle));
+            attributes.insert(handle, contactAttributes);
+        }
+        ret.insert(QLatin1String("attributes"), QVariant::fromValue(attributes));
+
+        ChannelDetailsList channels;
+        for (int i = 0; i < 2; ++i) {
+            ChannelDetails details;
+            details.channel = QDBusObjectPath(QString(QLatin1String("/channel%1")).arg(i));
+            details.properties.insert(TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType"),
+                    TP_QT_IFACE_CHANNEL_TYPE_TEXT);
+            channels.append(details);
+        }
+        ret.insert(QLatin1String("channels"), QVariant::fromValue(channels));
+
         return ret;
     }
 };
@@ -63,6 +82,7 @@ private Q_SLOTS:
     void init();
 
     void testParameters();
+    void testContainers();
 
     void cleanup();
     void cleanupTestCase();
@@ -127,6 +147,24 @@ void TestTypes::testParameters()
     QCOMPARE(saIPv6.port, static_cast<ushort>(3333));
 }
 
+void TestTypes::testContainers()
+{
+    ContactAttributesMap attributes = qdbus_cast<ContactAttributesMap>(
+            mParameters.value(QLatin1String("attributes")));
+    QCOMPARE(attributes.size(), 10);
+    QCOMPARE(attributes.firstKey(), 1U);
+    QCOMPARE(attributes.lastKey(), 10U);
+    QCOMPARE(attributes.value(7).value(TP_QT_IFACE_CONNECTION + QLatin1String("/contact-id")).toString(),
+            QString(QLatin1String("contact7@example.com")));
+
+    ChannelDetailsList channels = qdbus_cast<ChannelDetailsList>(
+            mParameters.value(QLatin1String("channels")));
+    QCOMPARE(channels.size(), 2);
+    QCOMPARE(channels[1].channel.path(), QString(QLatin1String("/channel1")));
+    QCOMPARE(channels[1].properties.value(TP_QT_IFACE_CHANNEL + QLatin1String(".ChannelType")).toString(),
+            TP_QT_IFACE_CHANNEL_TYPE_TEXT);
+}
+
 void TestTypes::cleanup()
 {
     cleanupImpl();
@@ -0,0 +1,134 @@
+#include <QtTest/QtTest>
+
+#include <QDateTime>
+
+#include <TelepathyQt/Constants>
+#include <TelepathyQt/Debug>
+#include <TelepathyQt/Message>
+#include <TelepathyQt/Types>
+
+using namespace Tp;
+
+class TestMessage : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMessage(QObject *parent = nullptr);
+
+private Q_SLOTS:
+    void testText();
+    void testAlternatives();
+    void testCopies();
+};
+
+TestMessage::TestMessage(QObject *parent)
+    : QObject(parent)
+{
+    Tp::enableDebug(true);
+    Tp::enableWarnings(true);
+}
+
+static MessagePart textPart(const QString &text, const QString &alternative = QString())
+{
+    MessagePart part;
+    part.insert(QLatin1String("content-type"), QDBusVariant(QLatin1String("text/plain")));
+    part.insert(QLatin1String("content"), QDBusVariant(text));
+    if (!alternative.isEmpty()) {
+        part.insert(QLatin1String("alternative"), QDBusVariant(alternative));
+    }
+    return part;
+}
+
+void TestMessage::testText()
+{
+    Message m(ChannelTextMessageTypeAction, QLatin1String("waves"));
+    QCOMPARE(m.messageType(), ChannelTextMessageTypeAction);
+    QCOMPARE(m.text(), QString(QLatin1String("waves")));
+    QVERIFY(!m.hasNonTextContent());
+    QVERIFY(!m.isTruncated());
+    QVERIFY(!m.isSpecificToDBusInterface());
+    QCOMPARE(m.messageToken(), QString(QLatin1String("")));
+    QVERIFY(!m.sent().isValid());
+
+    Message stamped(1234, ChannelTextMessageTypeNotice, QLatin1String("hello"));
+    QCOMPARE(stamped.messageType(), ChannelTextMessageTypeNotice);
+    QCOMPARE(stamped.text(), QString(QLatin1String("hello")));
+    QCOMPARE(stamped.sent().toMSecsSinceEpoch(), static_cast<qint64>(1234000));
+    QCOMPARE(stamped.size(), 2);
+
+    MessagePart header;
+    header.insert(QLatin1String("message-token"), QDBusVariant(QLatin1String("token")));
+    header.insert(QLatin1String("message-sent"), QDBusVariant(static_cast<qlonglong>(1234)));
+    MessagePart truncated = textPart(QLatin1String(" world"));
+    truncated.insert(QLatin1String("truncated"), QDBusVariant(true));
+
+    Message multi(MessagePartList() << header << textPart(QLatin1String("hello")) << truncated);
+    QCOMPARE(multi.text(), QString(QLatin1String("hello world")));
+    QCOMPARE(multi.messageToken(), QString(QLatin1String("token")));
+    QCOMPARE(multi.messageType(), ChannelTextMessageTypeNormal);
+    QCOMPARE(multi.sent().toMSecsSinceEpoch(), static_cast<qint64>(1234000));
+    QVERIFY(multi.isTruncated());
+    QVERIFY(!multi.hasNonTextContent());
+
+    // Repeated calls give the same results
+    QCOMPARE(multi.text(), QString(QLatin1String("hello world")));
+    QVERIFY(multi.isTruncated());
+}
+
+void TestMessage::testAlternatives()
+{
+    MessagePart html;
+    html.insert(QLatin1String("content-type"), QDBusVariant(QLatin1String("text/html")));
+    html.insert(QLatin1String("content"), QDBusVariant(QLatin1String("<b>hi</b>")));
+    html.insert(QLatin1String("alternative"), QDBusVariant(QLatin1String("main")));
+
+    // Only the first text/plain alternative of a group is used, and it covers the HTML part
+    Message m(MessagePartList() << MessagePart() << html
+            << textPart(QLatin1String("hi"), QLatin1String("main"))
+            << textPart(QLatin1String("HI"), QLatin1String("main")));
+    QCOMPARE(m.text(), QString(QLatin1String("hi")));
+    QVERIFY(!m.hasNonTextContent());
+
+    // Without a text/plain alternative, the HTML can't be represented as text
+    Message htmlOnly(MessagePartList() << MessagePart() << html);
+    QCOMPARE(htmlOnly.text(), QString());
+    QVERIFY(htmlOnly.hasNonTextContent());
+
+    MessagePart image;
+    image.insert(QLatin1String("content-type"), QDBusVariant(QLatin1String("image/png")));
+    Message withImage(MessagePartList() << MessagePart() << textPart(QLatin1String("look"))
+            << image);
+    QCOMPARE(withImage.text(), QString(QLatin1String("look")));
+    QVERIFY(withImage.hasNonTextContent());
+
+    // Messages specific to an interface are never plain text
+    MessagePart header;
+    header.insert(QLatin1String("interface"),
+            QDBusVariant(QLatin1String("com.example.Interface")));
+    Message specific(MessagePartList() << header << textPart(QLatin1String("data")));
+    QVERIFY(specific.isSpecificToDBusInterface());
+    QCOMPARE(specific.dbusInterface(), QString(QLatin1String("com.example.Interface")));
+    QVERIFY(specific.hasNonTextContent());
+}
+
+void TestMessage::testCopies()
+{
+    Message m(ChannelTextMessageTypeNormal, QLatin1String("shared"));
+    QCOMPARE(m.text(), QString(QLatin1String("shared")));
+
+    Message copy(m);
+    QVERIFY(copy == m);
+    QCOMPARE(copy.text(), QString(QLatin1String("shared")));
+    QCOMPARE(copy.size(), m.size());
+
+    Message other(ChannelTextMessageTypeNotice, QLatin1String("other"));
+    copy = other;
+    QCOMPARE(copy.messageType(), ChannelTextMessageTypeNotice);
+    QCOMPARE(copy.text(), QString(QLatin1String("other")));
+    QCOMPARE(m.text(), QString(QLatin1String("shared")));
+}
+
+QTEST_MAIN(TestMessage)
+
+#include "_gen/message.cpp.moc.hpp"
@@ -0,0 +1,201 @@
+#include <QtTest/QtTest>
+
+#include <TelepathyQt/Debug>
+#include <TelepathyQt/PendingComposite>
+#include <TelepathyQt/PendingFailure>
+#include <TelepathyQt/PendingSuccess>
+
+using namespace Tp;
+
+class TestPendingOperation : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestPendingOperation(QObject *parent = nullptr);
+
+protected Q_SLOTS:
+    void onFinished(Tp::PendingOperation *op);
+    void onFinishedDeleteNext(Tp::PendingOperation *op);
+    void onFinishedFinishAnother(Tp::PendingOperation *op);
+
+private Q_SLOTS:
+    void init();
+
+    void testFinishOrder();
+    void testDeletion();
+    void testDeletedBeforeFinished();
+    void testFinishFromHandler();
+    void testComposite();
+
+private:
+    QList<PendingOperation *> mFinished;
+    QStringList mErrors;
+    QPointer<PendingOperation> mNext;
+    PendingOperation *mFinishedLater;
+};
+
+TestPendingOperation::TestPendingOperation(QObject *parent)
+    : QObject(parent)
+{
+    Tp::enableDebug(true);
+    Tp::enableWarnings(true);
+}
+
+void TestPendingOperation::onFinished(Tp::PendingOperation *op)
+{
+    // The operation may be deleted as soon as the test loop flushes the deferred deletions
+    mFinished.append(op);
+    mErrors.append(op->errorName());
+}
+
+void TestPendingOperation::onFinishedDeleteNext(Tp::PendingOperation *op)
+{
+    mFinished.append(op);
+    delete mNext.data();
+}
+
+void TestPendingOperation::onFinishedFinishAnother(Tp::PendingOperation *op)
+{
+    mFinished.append(op);
+    mFinishedLater = new PendingSuccess(SharedPtr<RefCounted>());
+    QVERIFY(connect(mFinishedLater,
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(onFinished(Tp::PendingOperation*))));
+}
+
+void TestPendingOperation::init()
+{
+    mFinished.clear();
+    mErrors.clear();
+    mNext = nullptr;
+    mFinishedLater = nullptr;
+}
+
+void TestPendingOperation::testFinishOrder()
+{
+    QList<PendingOperation *> ops;
+    for (int i = 0; i < 5; ++i) {
+        PendingOperation *op;
+        if (i % 2) {
+            op = new PendingFailure(QLatin1String("org.freedesktop.Telepathy.Error.NotAvailable"),
+                    QLatin1String("failed"), SharedPtr<RefCounted>());
+        } else {
+            op = new PendingSuccess(SharedPtr<RefCounted>());
+        }
+        QVERIFY(connect(op,
+                    SIGNAL(finished(Tp::PendingOperation*)),
+                    SLOT(onFinished(Tp::PendingOperation*))));
+        ops.append(op);
+    }
+
+    // Nothing is emitted before the event loop runs
+    QCOMPARE(mFinished.size(), 0);
+
+    QTRY_COMPARE(mFinished.size(), 5);
+    QCOMPARE(mFinished, ops);
+}
+
+void TestPendingOperation::testDeletion()
+{
+    QPointer<PendingOperation> first = new PendingSuccess(SharedPtr<RefCounted>());
+    QPointer<PendingOperation> second = new PendingSuccess(SharedPtr<RefCounted>());
+    QVERIFY(connect(first.data(),
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(onFinished(Tp::PendingOperation*))));
+    QVERIFY(connect(second.data(),
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(onFinished(Tp::PendingOperation*))));
+
+    QTRY_COMPARE(mFinished.size(), 2);
+
+    // Finished operations are deleted with the deferred deletions, as with deleteLater()
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    QVERIFY(first.isNull());
+    QVERIFY(second.isNull());
+}
+
+void TestPendingOperation::testDeletedBeforeFinished()
+{
+    PendingOperation *first = new PendingSuccess(SharedPtr<RefCounted>());
+    mNext = new PendingSuccess(SharedPtr<RefCounted>());
+    PendingOperation *third = new PendingSuccess(SharedPtr<RefCounted>());
+    QVERIFY(connect(first,
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(onFinishedDeleteNext(Tp::PendingOperation*))));
+    QVERIFY(connect(mNext.data(),
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(onFinished(Tp::PendingOperation*))));
+    QVERIFY(connect(third,
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(onFinished(Tp::PendingOperation*))));
+
+    // An operation deleted by the finished() handler of another is skipped
+    QTRY_COMPARE(mFinished.size(), 2);
+    QCOMPARE(mFinished, QList<PendingOperation *>() << first << third);
+    QVERIFY(mNext.isNull());
+
+    QTest::qWait(10);
+    QCOMPARE(mFinished.size(), 2);
+}
+
+void TestPendingOperation::testFinishFromHandler()
+{
+    PendingOperation *op = new PendingSuccess(SharedPtr<RefCounted>());
+    QVERIFY(connect(op,
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(onFinishedFinishAnother(Tp::PendingOperation*))));
+
+    // An operation set finished by a finished() handler is emitted on a later iteration
+    QTRY_COMPARE(mFinished.size(), 1);
+    QVERIFY(mFinishedLater != nullptr);
+    QTRY_COMPARE(mFinished.size(), 2);
+    QCOMPARE(mFinished.last(), mFinishedLater);
+}
+
+void TestPendingOperation::testComposite()
+{
+    QList<PendingOperation *> ops;
+    for (int i = 0; i < 3; ++i) {
+        ops.append(new PendingSuccess(SharedPtr<RefCounted>()));
+    }
+    PendingOperation *composite = new PendingComposite(ops, SharedPtr<RefCounted>());
+    QVERIFY(connect(composite,
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(onFinished(Tp::PendingOperation*))));
+
+    QTRY_COMPARE(mFinished.size(), 1);
+    QCOMPARE(mFinished.first(), composite);
+    QCOMPARE(mErrors.first(), QString());
+
+    mFinished.clear();
+    mErrors.clear();
+    ops.clear();
+    ops.append(new PendingSuccess(SharedPtr<RefCounted>()));
+    ops.append(new PendingFailure(QLatin1String("org.freedesktop.Telepathy.Error.NotAvailable"),
+                QLatin1String("failed"), SharedPtr<RefCounted>()));
+    ops.append(new PendingSuccess(SharedPtr<RefCounted>()));
+    composite = new PendingComposite(ops, false, SharedPtr<RefCounted>());
+    QVERIFY(connect(composite,
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(onFinished(Tp::PendingOperation*))));
+
+    // Without failOnFirstError, the composite waits for all the operations and keeps the error
+    QTRY_COMPARE(mFinished.size(), 1);
+    QCOMPARE(mFinished.first(), composite);
+    QCOMPARE(mErrors.first(), QString(QLatin1String("org.freedesktop.Telepathy.Error.NotAvailable")));
+
+    // A composite deleted before its operations finish is not notified
+    mFinished.clear();
+    ops.clear();
+    ops.append(new PendingSuccess(SharedPtr<RefCounted>()));
+    delete new PendingComposite(ops, SharedPtr<RefCounted>());
+    QVERIFY(connect(ops.first(),
+                SIGNAL(finished(Tp::PendingOperation*)),
+                SLOT(onFinished(Tp::PendingOperation*))));
+    QTRY_COMPARE(mFinished.size(), 1);
+}
+
+QTEST_MAIN(TestPendingOperation)
+
+#include "_gen/pending-operation.cpp.moc.hpp"
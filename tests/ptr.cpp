@@ -13,7 +13,10 @@ private Q_SLOTS:
     void testSharedPtrDict();
     void testSharedPtrBoolConversion();
     void testWeakPtrBoolConversion();
+    void testMoveSemantics();
     void testThreadSafety();
+    void benchmarkContactList_data();
+    void benchmarkContactList();
 };
 
 class Data;
@@ -239,6 +242,42 @@ void TestSharedPtr::testWeakPtrBoolConversion()
     QVERIFY(!validPtrAlternative ? true : false);
 }
 
+void TestSharedPtr::testMoveSemantics()
+{
+    DataPtr ptr = Data::create();
+    Data *savedData = ptr.data();
+    WeakPtr<Data> weakPtr(ptr);
+
+    DataPtr moved(std::move(ptr));
+    QVERIFY(ptr.isNull());
+    QCOMPARE(moved.data(), savedData);
+
+    DataPtr assigned;
+    assigned = std::move(moved);
+    QVERIFY(moved.isNull());
+    QCOMPARE(assigned.data(), savedData);
+
+    // Moving into itself through a temporary must keep the object alive
+    assigned = DataPtr(std::move(assigned));
+    QCOMPARE(assigned.data(), savedData);
+
+    SharedPtr<RefCounted> base = DataPtr(assigned);
+    QCOMPARE(base.data(), static_cast<RefCounted*>(savedData));
+
+    WeakPtr<Data> movedWeakPtr(std::move(weakPtr));
+    QVERIFY(weakPtr.isNull());
+    QVERIFY(!movedWeakPtr.isNull());
+
+    WeakPtr<Data> assignedWeakPtr;
+    assignedWeakPtr = std::move(movedWeakPtr);
+    QVERIFY(movedWeakPtr.isNull());
+    QCOMPARE(DataPtr(assignedWeakPtr).data(), savedData);
+
+    assigned.reset();
+    base.reset();
+    QVERIFY(assignedWeakPtr.isNull());
+}
+
 class Thread : public QThread
 {
 public:
@@ -331,6 +370,55 @@ void TestSharedPtr::testThreadSafety()
     QVERIFY(promotedPtr.isNull());
 }
 
+void TestSharedPtr::benchmarkContactList_data()
+{
+    QTest::addColumn<bool>("move");
+
+    QTest::newRow("copy") << false;
+    QTest::newRow("move") << true;
+}
+
+// Builds, hands over and tears down a list of pointers the way contact list operations do. Moving
+// saves the atomic increment and decrement of the reference count per element at each step.
+void TestSharedPtr::benchmarkContactList()
+{
+    QFETCH(bool, move);
+
+    const int count = 10000;
+    QVector<DataPtr> source;
+    source.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        source.append(Data::create());
+    }
+
+    QBENCHMARK {
+        QVector<DataPtr> built;
+        built.reserve(count);
+        QVector<DataPtr> handedOver;
+        handedOver.reserve(count);
+
+        if (move) {
+            for (int i = 0; i < count; ++i) {
+                DataPtr ptr(source[i]);
+                built.append(std::move(ptr));
+            }
+            for (int i = 0; i < count; ++i) {
+                handedOver.append(std::move(built[i]));
+            }
+        } else {
+            for (int i = 0; i < count; ++i) {
+                DataPtr ptr(source[i]);
+                built.append(ptr);
+            }
+            for (int i = 0; i < count; ++i) {
+                handedOver.append(built[i]);
+            }
+        }
+
+        QCOMPARE(handedOver.size(), count);
+    }
+}
+
 QTEST_MAIN(TestSharedPtr)
 
 #include "_gen/ptr.cpp.moc.hpp"
@@ -74,6 +74,7 @@ class Generator(object):
 
         self.h("""
 #include <QFlags>
+#include <QString>
 
 /**
  * \\addtogroup typesconstants Types and constants
@@ -104,6 +105,13 @@ class Generator(object):
  * D-Bus interface names of the interfaces in the specification.
  */
 
+/**
+ * \\defgroup propstrconsts Property and contact attribute string constants
+ * \\ingroup typesconstants
+ *
+ * Fully qualified names of the D-Bus properties and contact attributes in the specification.
+ */
+
 /**
  * \\defgroup errorstrconsts Error string constants
  * \\ingroup typesconstants
@@ -159,6 +167,8 @@ namespace %s
 """ % {'name' : iface.getAttribute('name'),
        'DEFINE' : self.define_prefix + 'IFACE_' + get_by_path(iface, '../@name').upper().replace('/', '')})
 
+                self.do_properties(iface)
+
         # Error names
         for error in get_by_path(self.spec, 'errors/error'):
             name = error.getAttribute('name')
@@ -195,6 +205,36 @@ namespace %s
        'docstring': format_docstring(error, self.refs),
        'DEFINE' : define})
 
+    def do_properties(self, iface):
+        name = iface.getAttribute('name')
+        define_suffix = get_by_path(iface, '../@name').upper().replace('/', '')
+
+        for prop in get_by_path(iface, 'property'):
+            self.h("""\
+/**
+ * \\ingroup propstrconsts
+ *
+ * The property name "%(name)s" as a QString literal, which doesn't allocate when used.
+ */
+#define %(DEFINE)s QStringLiteral("%(name)s")
+
+""" % {'name' : name + '.' + prop.getAttribute('name'),
+       'DEFINE' : self.define_prefix + 'PROP_' + define_suffix + '_' +
+                  prop.getAttributeNS(NS_TP, 'name-for-bindings').upper()})
+
+        for attr in get_by_path(iface, 'contact-attribute'):
+            self.h("""\
+/**
+ * \\ingroup propstrconsts
+ *
+ * The contact attribute name "%(name)s" as a QString literal, which doesn't allocate when used.
+ */
+#define %(DEFINE)s QStringLiteral("%(name)s")
+
+""" % {'name' : name + '/' + attr.getAttribute('name'),
+       'DEFINE' : self.define_prefix + 'TOKEN_' + define_suffix + '_' +
+                  attr.getAttribute('name').upper().replace('-', '_').replace('.', '_')})
+
     def do_flags(self, flags):
         singular = flags.getAttribute('singular') or \
                    flags.getAttribute('value-prefix')
@@ -114,6 +114,10 @@ class Generator(object):
 
         self.b("""#include "%s"
 
+#include <QAtomicPointer>
+#include <QHash>
+#include <QMutex>
+
 """ % self.realinclude)
 
         if self.mocinclude:
@@ -200,6 +204,8 @@ public:
 
         self.do_mic_typedefs(methods)
 
+        self.do_meta_lookups(name, props, methods)
+
         self.b("""
 %(name)s::%(name)s(const QDBusConnection& bus, QObject* adaptee, QObject* parent)
     : Tp::AbstractAdaptor(bus, adaptee, parent)
@@ -252,6 +258,108 @@ Q_SIGNALS: // SIGNALS
 };
 """)
 
+    def exported_props(self, props):
+        # Skip tp:properties
+        return [prop for prop in props if not prop.namespaceURI]
+
+    def adaptee_method_signature(self, ifacename, method):
+        adaptee_name = to_lower_camel_case(method.getAttribute('tp:name-for-bindings'))
+        # Not extract_arg_or_member_info(), which escapes the docstrings in place and would
+        # escape them a second time when the method itself is generated
+        inparams = []
+        for arg in get_by_path(method, 'arg'):
+            if arg.getAttribute('direction') == 'out':
+                continue
+            sig = arg.getAttribute('type')
+            tptype = arg.getAttributeNS(NS_TP, 'type')
+            inparams.append(binding_from_usage(sig, tptype, self.custom_lists,
+                (sig, tptype) in self.externals, self.typesnamespace).val)
+        inparams.append("%s::%s::%sContextPtr" % (self.namespace, ifacename,
+            method.getAttribute('name')))
+        return '%s(%s)' % (adaptee_name, ','.join(inparams))
+
+    def do_meta_lookups(self, ifacename, props, methods):
+        props = self.exported_props(props)
+        if not props and not methods:
+            return
+
+        # Kept out of the adaptor class, so that its layout doesn't depend on the methods and
+        # properties of the interface
+        self.b("""
+namespace
+{
+
+struct %(name)sMeta
+{
+    explicit %(name)sMeta(const QMetaObject *mo);
+
+    static const %(name)sMeta &get(const QObject *adaptee);
+
+    const QMetaObject *mo;
+""" % {'name': ifacename})
+
+        for method in methods:
+            self.b("""\
+    QMetaMethod %sMethod;
+""" % method.getAttribute('name'))
+
+        for prop in props:
+            self.b("""\
+    QMetaProperty %sProperty;
+""" % prop.getAttribute('name'))
+
+        self.b("""\
+};
+
+%(name)sMeta::%(name)sMeta(const QMetaObject *mo)
+    : mo(mo)
+{
+""" % {'name': ifacename})
+
+        for method in methods:
+            self.b("""\
+    %(name)sMethod = mo->method(mo->indexOfMethod("%(signature)s"));
+""" % {'name': method.getAttribute('name'),
+       'signature': self.adaptee_method_signature(ifacename, method),
+       })
+
+        for prop in props:
+            self.b("""\
+    %(name)sProperty = mo->property(mo->indexOfProperty("%(adaptee_name)s"));
+""" % {'name': prop.getAttribute('name'),
+       'adaptee_name': to_lower_camel_case(prop.getAttribute('tp:name-for-bindings')),
+       })
+
+        self.b("""\
+}
+
+// Resolve the adaptee's methods and properties once per adaptee class, rather than by name on
+// every call. Entries live as long as the meta-objects they were resolved against.
+const %(name)sMeta &%(name)sMeta::get(const QObject *adaptee)
+{
+    static QAtomicPointer<const %(name)sMeta> last;
+    static QMutex mutex;
+    static QHash<const QMetaObject *, const %(name)sMeta *> metas;
+
+    const QMetaObject *mo = adaptee->metaObject();
+    const %(name)sMeta *meta = last.loadAcquire();
+    if (meta && meta->mo == mo) {
+        return *meta;
+    }
+
+    QMutexLocker locker(&mutex);
+    meta = metas.value(mo);
+    if (!meta) {
+        meta = new %(name)sMeta(mo);
+        metas.insert(mo, meta);
+    }
+    last.storeRelease(meta);
+    return *meta;
+}
+
+}
+""" % {'name': ifacename})
+
     def do_introspection(self, props, methods, signals):
         self.do_prop_introspection(props)
         self.do_method_introspection(methods)
@@ -472,11 +580,16 @@ Q_SIGNALS: // SIGNALS
             self.b("""
 %(type)s %(ifacename)s::%(gettername)s() const
 {
+    const QMetaProperty &adapteeProperty = %(ifacename)sMeta::get(adaptee()).%(name)sProperty;
+    if (adapteeProperty.isValid()) {
+        return qvariant_cast< %(type)s >(adapteeProperty.read(adaptee()));
+    }
     return qvariant_cast< %(type)s >(adaptee()->property("%(adaptee_name)s"));
 }
 """ % {'type': binding.val,
        'ifacename': ifacename,
        'gettername': gettername,
+       'name': name,
        'adaptee_name': adaptee_name,
        })
 
@@ -501,11 +614,17 @@ Q_SIGNALS: // SIGNALS
             self.b("""
 void %(ifacename)s::%(settername)s(const %(type)s &newValue)
 {
+    const QMetaProperty &adapteeProperty = %(ifacename)sMeta::get(adaptee()).%(name)sProperty;
+    if (adapteeProperty.isValid()) {
+        adapteeProperty.write(adaptee(), QVariant::fromValue(newValue));
+        return;
+    }
     adaptee()->setProperty("%(adaptee_name)s", QVariant::fromValue(newValue));
 }
 """ % {'ifacename': ifacename,
        'settername': settername,
        'type': binding.val,
+       'name': name,
        'adaptee_name': adaptee_name,
        })
 
@@ -543,10 +662,6 @@ void %(ifacename)s::%(settername)s(const %(type)s &newValue)
             outargtypes = ''
         invokemethodargs = ', '.join(['Q_ARG(' + argbindings[i].val + ', ' + argnames[i] + ')' for i in inargs])
 
-        inparams = [argbindings[i].val for i in inargs]
-        inparams.append("%s::%s::%sContextPtr" % (self.namespace, ifacename, name))
-        normalized_adaptee_params = ','.join(inparams)
-
         adaptee_params = [argbindings[i].inarg + ' ' + argnames[i] for i in inargs]
         adaptee_params.append('const %(namespace)s::%(ifacename)s::%(name)sContextPtr &context' %
             {'namespace': self.namespace,
@@ -604,13 +719,13 @@ void %(ifacename)s::%(settername)s(const %(type)s &newValue)
         self.b("""
 %(rettype)s %(ifacename)s::%(name)s(%(params)s)
 {
-    if (adaptee()->metaObject()->indexOfMethod("%(adaptee_name)s(%(normalized_adaptee_params)s)") < 0) {
+    const QMetaMethod &adapteeMethod = %(ifacename)sMeta::get(adaptee()).%(name)sMethod;
+    if (!adapteeMethod.isValid()) {
         dbusConnection().send(dbusMessage.createErrorReply(TP_QT_ERROR_NOT_IMPLEMENTED, QLatin1String("Not implemented")));
 """ % {'rettype': rettype,
        'ifacename': ifacename,
        'name': name,
        'adaptee_name': adaptee_name,
-       'normalized_adaptee_params': normalized_adaptee_params,
        'params': params,
        })
 
@@ -634,23 +749,21 @@ void %(ifacename)s::%(settername)s(const %(type)s &newValue)
 
         if invokemethodargs:
             self.b("""\
-    QMetaObject::invokeMethod(adaptee(), "%(adaptee_name)s",
+    adapteeMethod.invoke(adaptee(),
         %(invokemethodargs)s,
         Q_ARG(%(namespace)s::%(ifacename)s::%(name)sContextPtr, ctx));
 """ % {'namespace': self.namespace,
        'ifacename': ifacename,
        'name': name,
-       'adaptee_name': adaptee_name,
        'invokemethodargs': invokemethodargs,
        })
         else:
             self.b("""\
-    QMetaObject::invokeMethod(adaptee(), "%(lname)s",
+    adapteeMethod.invoke(adaptee(),
         Q_ARG(%(namespace)s::%(ifacename)s::%(name)sContextPtr, ctx));
 """ % {'namespace': self.namespace,
        'ifacename': ifacename,
        'name': name,
-       'lname': (name[0].lower() + name[1:]),
        })
 
         if rettype != 'void':
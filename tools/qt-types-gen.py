@@ -321,20 +321,7 @@ TP_QT_NO_EXPORT void _registerTypes()
             self.both('%s const QDBusArgument& operator>>(const QDBusArgument& arg, %s &list)' %
                     (self.visibility, val))
             self.decl(';\n\n')
-            self.impl("""
-{
-    arg.beginArray();
-    list.clear();
-    while (!arg.atEnd()) {
-        %s item;
-        arg >> item;
-        list.append(item);
-    }
-    arg.endArray();
-    return arg;
-}
-
-""" % (array_of))
+            self.impl(self.list_demarshaller(array_of))
 
         structs = self.spec.getElementsByTagNameNS(NS_TP, 'struct')
         mappings = self.spec.getElementsByTagNameNS(NS_TP, 'mapping')
@@ -521,6 +508,29 @@ struct %(visibility)s %(name)s
  */
 """ % (depinfo.binding.val, get_headerfile_cmd(self.realinclude, self.prettyinclude), realtype, format_docstring(depinfo.el, self.refs)))
             self.decl(self.faketype(depinfo.binding.val, realtype,  "std::pair<" + bindings[0].val + ", " + bindings[1].val + "> "))
+
+            self.both('%s const QDBusArgument& operator>>(const QDBusArgument& arg, %s &map)' %
+                    (self.visibility, depinfo.binding.val))
+            self.decl(';\n\n')
+            self.impl("""
+{
+    arg.beginMap();
+    map.clear();
+    while (!arg.atEnd()) {
+        %(key)s key;
+        arg.beginMapEntry();
+        arg >> key;
+        // Senders usually marshal their keys in order, which makes the end a
+        // correct hint and the insertion amortized constant time
+        %(name)s::iterator i = map.insert(map.constEnd(), key, %(value)s());
+        arg >> i.value();
+        arg.endMapEntry();
+    }
+    arg.endMap();
+    return arg;
+}
+
+""" % {'key': bindings[0].val, 'value': bindings[1].val, 'name': depinfo.binding.val})
         else:
             raise WTF(depinfo.el.localName)
 
@@ -539,6 +549,11 @@ typedef %s %s;
 
 """ % (get_headerfile_cmd(self.realinclude, self.prettyinclude), depinfo.binding.val, 'QList<%s>' % depinfo.binding.val, depinfo.binding.array_val))
 
+            self.both('%s const QDBusArgument& operator>>(const QDBusArgument& arg, %s &list)' %
+                    (self.visibility, depinfo.binding.array_val))
+            self.decl(';\n\n')
+            self.impl(self.list_demarshaller(depinfo.binding.val))
+
         i = depinfo.binding.array_depth
         while i > 1:
             i -= 1
@@ -555,6 +570,24 @@ typedef QList<%s> %sList;
 
 """ % (get_headerfile_cmd(self.realinclude, self.prettyinclude), list_of, list_of, list_of))
 
+    def list_demarshaller(self, array_of):
+        # D-Bus arrays are prefixed by their length in bytes rather than elements, and
+        # QDBusArgument doesn't expose it anyway, so the list can't be pre-sized. Decoding each
+        # element in place at least saves copying it into the list.
+        return """
+{
+    arg.beginArray();
+    list.clear();
+    while (!arg.atEnd()) {
+        list.append(%s());
+        arg >> list.last();
+    }
+    arg.endArray();
+    return arg;
+}
+
+""" % array_of
+
     def faketype(self, fake, real, stdtype):
         return """\
 struct %(visibility)s %(fake)s : public %(real)s